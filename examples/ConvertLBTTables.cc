@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Converts the LBT text tables in LBT-tables/ into the binary file that
+// LBT maps at startup instead of parsing the text. Run once from the
+// directory containing LBT-tables/, after ./get_lbtTab.sh:
+//   ./ConvertLBTTables [output file, default LBT-tables/LBT-tables.bin]
+
+#include <iostream>
+#include <memory>
+
+#include "JetScapeLogger.h"
+#include "LBT.h"
+
+using namespace std;
+
+using namespace Jetscape;
+
+int main(int argc, char **argv) {
+  JetScapeLogger::Instance()->SetVerboseLevel(0);
+
+  string output = argc > 1 ? argv[1] : LBT::BinaryTablesFile;
+
+  auto lbt = make_shared<LBT>();
+  if (!lbt->ReadTextTables(true)) {
+    cerr << "Could not read all tables from LBT-tables/, nothing written"
+         << endl;
+    return 1;
+  }
+  lbt->WriteBinaryTables(output);
+  cout << "Wrote " << output << endl;
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Microbenchmark for EvolutionHistory::get() on a MUSIC-sized 2+1D grid
+// filled through FromVector(), comparing the precompiled data layout with
+// the lookup of every entry name per cell.
+// Usage: ./EvolutionHistoryBenchmark [number of queries]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "FluidEvolutionHistory.h"
+#include "JetScapeLogger.h"
+
+using namespace Jetscape;
+
+namespace {
+
+double TimeQueries(const EvolutionHistory &hist,
+                   const std::vector<real> &points,
+                   std::vector<FluidCellInfo> &results) {
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < results.size(); i++) {
+    results[i] = hist.get(points[4 * i], points[4 * i + 1],
+                          points[4 * i + 2], points[4 * i + 3]);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         results.size();
+}
+
+bool SameCell(const FluidCellInfo &a, const FluidCellInfo &b) {
+  bool same = a.energy_density == b.energy_density &&
+              a.entropy_density == b.entropy_density &&
+              a.temperature == b.temperature && a.pressure == b.pressure &&
+              a.vx == b.vx && a.vy == b.vy && a.vz == b.vz &&
+              a.bulk_Pi == b.bulk_Pi;
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+      same = same && a.pi[i][j] == b.pi[i][j];
+  return same;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  JetScapeLogger::Instance()->SetDebug(false);
+  JetScapeLogger::Instance()->SetRemark(false);
+  JetScapeLogger::Instance()->SetVerboseLevel(0);
+
+  int n_queries = 1000000;
+  if (argc > 1)
+    n_queries = atoi(argv[1]);
+
+  // MUSIC 2+1D defaults: |x|,|y| < 15 fm with dx = 0.2 fm, dtau = 0.1 fm
+  const int nx = 151, ny = 151, neta = 1, ntau = 100;
+  const float x_min = -15., dx = 0.2, tau_min = 0.6, dtau = 0.1;
+  std::vector<std::string> info = {"energy_density", "entropy_density",
+                                   "temperature", "pressure", "vx", "vy",
+                                   "vz", "pi11", "pi12", "pi22", "pi33",
+                                   "bulk_pi"};
+
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> uni(0., 1.);
+  std::vector<float> bulk(ntau * nx * ny * neta * info.size());
+  for (auto &v : bulk)
+    v = uni(gen);
+
+  EvolutionHistory hist;
+  hist.FromVector(bulk, info, tau_min, dtau, x_min, dx, nx, x_min, dx, ny,
+                  0., 0.1, neta, false);
+  hist.boost_invariant = true;
+
+  std::vector<real> points(4 * n_queries);
+  for (int i = 0; i < n_queries; i++) {
+    points[4 * i] = tau_min + 0.98 * uni(gen) * (ntau - 1) * dtau;
+    points[4 * i + 1] = x_min + 0.98 * uni(gen) * (nx - 1) * dx;
+    points[4 * i + 2] = x_min + 0.98 * uni(gen) * (ny - 1) * dx;
+    points[4 * i + 3] = 0.;
+  }
+
+  std::vector<FluidCellInfo> fast(n_queries), reference(n_queries);
+  double t_fast = TimeQueries(hist, points, fast);
+
+  // Without data_layout every cell resolves its entry names again
+  hist.data_layout.clear();
+  double t_reference = TimeQueries(hist, points, reference);
+
+  int n_different = 0;
+  for (int i = 0; i < n_queries; i++)
+    if (!SameCell(fast[i], reference[i]))
+      n_different++;
+
+  std::cout << "Grid " << nx << " x " << ny << " x " << ntau << " with "
+            << info.size() << " entries, " << n_queries << " queries\n"
+            << "  name lookup per cell : " << t_reference << " ns/query\n"
+            << "  precompiled layout   : " << t_fast << " ns/query\n"
+            << "  speedup              : " << t_reference / t_fast << "\n"
+            << "  different results    : " << n_different << std::endl;
+
+  return n_different == 0 ? 0 : 1;
+}
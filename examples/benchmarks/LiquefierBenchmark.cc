@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Microbenchmark for LiquefierBase::get_source() with 10^4 droplets on a
+// 200 x 200 x 64 (x, y, eta) hydro grid at one time step, comparing the
+// bucketed droplet index with the loop over all droplets. The loop is only
+// timed on every n-th cell, which is also where the results are compared.
+// Usage: ./LiquefierBenchmark [number of droplets] [cell stride of the loop]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "CausalLiquefier.h"
+#include "JetScapeLogger.h"
+
+using namespace Jetscape;
+
+namespace {
+
+// get_source() as it was before the droplet index
+void SumAllDroplets(const LiquefierBase &lqf, real tau, real x, real y,
+                    real eta, std::array<real, 4> &jmu) {
+  jmu = {0.0, 0.0, 0.0, 0.0};
+  for (int i = 0; i < lqf.get_dropletlist_size(); i++) {
+    const Droplet drop_i = lqf.get_a_droplet(i);
+    const auto x_drop = drop_i.get_xmu();
+    double ds2 = tau * tau + x_drop[0] * x_drop[0] -
+                 2.0 * tau * x_drop[0] * cosh(eta - x_drop[3]) -
+                 (x - x_drop[1]) * (x - x_drop[1]) -
+                 (y - x_drop[2]) * (y - x_drop[2]);
+    if (tau >= x_drop[0] && ds2 >= 0.0) {
+      std::array<real, 4> jmu_i = {0.0, 0.0, 0.0, 0.0};
+      lqf.smearing_kernel(tau, x, y, eta, drop_i, jmu_i);
+      for (int k = 0; k < 4; k++)
+        jmu[k] += jmu_i[k];
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  JetScapeLogger::Instance()->SetDebug(false);
+  JetScapeLogger::Instance()->SetRemark(false);
+  JetScapeLogger::Instance()->SetVerboseLevel(0);
+  JetScapeLogger::Instance()->SetInfo(false);
+
+  int n_droplets = 10000;
+  int stride = 97;
+  if (argc > 1)
+    n_droplets = atoi(argv[1]);
+  if (argc > 2)
+    stride = atoi(argv[2]);
+
+  const int nx = 200, ny = 200, neta = 64;
+  const real x_min = -15., dx = 0.15, eta_min = -3.2, deta = 0.1;
+  const real dtau = 0.1, tau = 6.0;
+  CausalLiquefier lqf(dtau, dx, dx, deta);
+
+  // droplets from jets between tau = 0.6 fm and the current time step
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> uni(0., 1.);
+  for (int i = 0; i < n_droplets; i++) {
+    std::array<real, 4> xmu = {real(0.6 + uni(gen) * (tau - 0.6)),
+                               real(20. * (uni(gen) - 0.5)),
+                               real(20. * (uni(gen) - 0.5)),
+                               real(4. * (uni(gen) - 0.5))};
+    std::array<real, 4> pmu = {2.0, real(uni(gen) - 0.5),
+                               real(uni(gen) - 0.5), real(uni(gen) - 0.5)};
+    lqf.add_a_droplet(Droplet(xmu, pmu));
+  }
+
+  const long n_cells = long(nx) * ny * neta;
+  std::vector<real> indexed(4 * n_cells);
+  std::array<real, 4> jmu;
+  auto start = std::chrono::steady_clock::now();
+  for (long c = 0; c < n_cells; c++) {
+    real x = x_min + dx * (c / (ny * neta));
+    real y = x_min + dx * ((c / neta) % ny);
+    real eta = eta_min + deta * (c % neta);
+    lqf.get_source(tau, x, y, eta, jmu);
+    for (int k = 0; k < 4; k++)
+      indexed[4 * c + k] = jmu[k];
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double t_indexed =
+      std::chrono::duration<double, std::nano>(stop - start).count() / n_cells;
+
+  long n_checked = 0, n_different = 0, n_nonzero = 0;
+  start = std::chrono::steady_clock::now();
+  for (long c = 0; c < n_cells; c += stride) {
+    real x = x_min + dx * (c / (ny * neta));
+    real y = x_min + dx * ((c / neta) % ny);
+    real eta = eta_min + deta * (c % neta);
+    SumAllDroplets(lqf, tau, x, y, eta, jmu);
+    bool same = true;
+    for (int k = 0; k < 4; k++)
+      same = same && jmu[k] == indexed[4 * c + k];
+    n_checked++;
+    if (!same)
+      n_different++;
+    if (jmu[0] != 0.0)
+      n_nonzero++;
+  }
+  stop = std::chrono::steady_clock::now();
+  double t_all =
+      std::chrono::duration<double, std::nano>(stop - start).count() /
+      n_checked;
+
+  std::cout << n_droplets << " droplets, grid " << nx << " x " << ny << " x "
+            << neta << " at tau = " << tau << " fm\n"
+            << "  all droplets   : " << t_all << " ns/cell ("
+            << n_checked << " cells)\n"
+            << "  droplet index  : " << t_indexed << " ns/cell ("
+            << n_cells << " cells)\n"
+            << "  speedup        : " << t_all / t_indexed << "\n"
+            << "  full grid      : " << t_all * n_cells * 1e-9 << " s -> "
+            << t_indexed * n_cells * 1e-9 << " s\n"
+            << "  nonzero cells  : " << n_nonzero << " of " << n_checked
+            << "\n"
+            << "  different cells: " << n_different << std::endl;
+
+  return n_different == 0 ? 0 : 1;
+}
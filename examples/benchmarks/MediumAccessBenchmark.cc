@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Microbenchmark for medium lookups from an energy loss module, comparing
+// GetHydroCellSignal with JetEnergyLoss::GetMediumCell() through the
+// MediumHandle, for a medium stored in an EvolutionHistory (as MUSIC) and
+// for an analytic one that fills the cell itself (as Brick). The history is
+// queried both at random points and along the paths of a collimated shower,
+// where GetMediumCell() mostly reuses cached interpolation stencils.
+// Usage: ./MediumAccessBenchmark [number of queries]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "FluidDynamics.h"
+#include "JetEnergyLoss.h"
+#include "JetScapeLogger.h"
+
+using namespace Jetscape;
+
+namespace {
+
+// evolution kept in bulk_info, looked up like MpiMusic
+class GridMedium : public FluidDynamics {
+public:
+  GridMedium(const std::vector<float> &data,
+             const std::vector<std::string> &info) {
+    bulk_info.FromVector(data, info, 0.6, 0.1, -15., 0.2, 151, -15., 0.2,
+                         151, 0., 0.1, 1, false);
+    bulk_info.boost_invariant = true;
+    hydro_status = FINISHED;
+  }
+  void GetHydroInfo(real t, real x, real y, real z,
+                    std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
+    fluid_cell_info_ptr = std::unique_ptr<FluidCellInfo>(
+        new FluidCellInfo(bulk_info.get_tz(t, x, y, z)));
+  }
+  MediumHandle GetMediumHandle() { return MediumHandle(this, &bulk_info); }
+};
+
+// Bjorken expanding brick, filled in place like Brick
+class AnalyticMedium : public FluidDynamics {
+public:
+  void GetHydroInfo(real t, real x, real y, real z,
+                    std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
+    fluid_cell_info_ptr = std::unique_ptr<FluidCellInfo>(new FluidCellInfo);
+    FillHydroCell(t, x, y, z, *fluid_cell_info_ptr);
+  }
+  void FillHydroCell(real t, real x, real y, real z, FluidCellInfo &cell) {
+    cell.temperature = 0.3 * std::pow(0.6 / t, 1.0 / 3.0);
+    cell.vz = z / t;
+  }
+};
+
+double TimeSignal(JetEnergyLoss &eloss, const std::vector<double> &points,
+                  std::vector<FluidCellInfo> &results) {
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < results.size(); i++) {
+    std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+    eloss.GetHydroCellSignal(points[4 * i], points[4 * i + 1],
+                             points[4 * i + 2], points[4 * i + 3],
+                             check_fluid_info_ptr);
+    results[i] = *check_fluid_info_ptr;
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         results.size();
+}
+
+double TimeHandle(JetEnergyLoss &eloss, const std::vector<double> &points,
+                  std::vector<FluidCellInfo> &results) {
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < results.size(); i++) {
+    eloss.GetMediumCell(points[4 * i], points[4 * i + 1], points[4 * i + 2],
+                        points[4 * i + 3], results[i]);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         results.size();
+}
+
+bool SameCell(const FluidCellInfo &a, const FluidCellInfo &b) {
+  bool same = a.energy_density == b.energy_density &&
+              a.entropy_density == b.entropy_density &&
+              a.temperature == b.temperature && a.pressure == b.pressure &&
+              a.vx == b.vx && a.vy == b.vy && a.vz == b.vz &&
+              a.bulk_Pi == b.bulk_Pi;
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+      same = same && a.pi[i][j] == b.pi[i][j];
+  return same;
+}
+
+int Compare(const char *name, FluidDynamics *hydro,
+            const std::vector<double> &points, int n_queries) {
+  JetEnergyLoss eloss;
+  eloss.GetHydroCellSignal.connect(hydro, &FluidDynamics::GetHydroCell);
+
+  std::vector<FluidCellInfo> signal(n_queries), handle(n_queries);
+  double t_signal = TimeSignal(eloss, points, signal);
+  eloss.SetMediumHandle(hydro->GetMediumHandle());
+  double t_handle = TimeHandle(eloss, points, handle);
+
+  int n_different = 0;
+  for (int i = 0; i < n_queries; i++)
+    if (!SameCell(signal[i], handle[i]))
+      n_different++;
+
+  std::cout << name << ", " << n_queries << " queries\n"
+            << "  GetHydroCellSignal : " << t_signal << " ns/lookup\n"
+            << "  MediumHandle       : " << t_handle << " ns/lookup\n"
+            << "  speedup            : " << t_signal / t_handle << "\n"
+            << "  different results  : " << n_different << std::endl;
+  return n_different;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  JetScapeLogger::Instance()->SetDebug(false);
+  JetScapeLogger::Instance()->SetRemark(false);
+  JetScapeLogger::Instance()->SetVerboseLevel(0);
+
+  int n_queries = 1000000;
+  if (argc > 1)
+    n_queries = atoi(argv[1]);
+
+  // MUSIC 2+1D sized grid: |x|,|y| < 15 fm, dx = 0.2 fm, 100 time steps
+  std::vector<std::string> info = {"energy_density", "entropy_density",
+                                   "temperature", "pressure", "vx", "vy",
+                                   "vz", "pi11", "pi12", "pi22", "pi33",
+                                   "bulk_pi"};
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> uni(0., 1.);
+  std::vector<float> bulk(100 * 151 * 151 * info.size());
+  for (auto &v : bulk)
+    v = uni(gen);
+  GridMedium grid(bulk, info);
+  AnalyticMedium analytic;
+
+  // points (t, x, y, z) inside the grid and the forward light cone
+  std::vector<double> points(4 * n_queries);
+  for (int i = 0; i < n_queries; i++) {
+    double tau = 0.7 + 9.0 * uni(gen);
+    double eta = 2.0 * (uni(gen) - 0.5);
+    points[4 * i] = tau * cosh(eta);
+    points[4 * i + 1] = 29.0 * (uni(gen) - 0.5);
+    points[4 * i + 2] = 29.0 * (uni(gen) - 0.5);
+    points[4 * i + 3] = tau * sinh(eta);
+  }
+
+  // a shower: 100 partons in a narrow cone, stepped by dt = 0.1 fm
+  // in turn, the way JetEnergyLoss::DoShower() queries the medium
+  int n_partons = 100;
+  std::vector<double> dirs(3 * n_partons);
+  for (int j = 0; j < n_partons; j++) {
+    double phi = 0.3 * (uni(gen) - 0.5), eta = 0.3 * (uni(gen) - 0.5);
+    dirs[3 * j] = cos(phi) / cosh(eta);
+    dirs[3 * j + 1] = sin(phi) / cosh(eta);
+    dirs[3 * j + 2] = tanh(eta);
+  }
+  std::vector<double> paths(4 * n_queries);
+  for (int i = 0; i < n_queries; i++) {
+    int j = i % n_partons;
+    double t = 0.7 + 0.1 * ((i / n_partons) % 90);
+    paths[4 * i] = t;
+    paths[4 * i + 1] = t * dirs[3 * j];
+    paths[4 * i + 2] = t * dirs[3 * j + 1];
+    paths[4 * i + 3] = t * dirs[3 * j + 2];
+  }
+
+  int n_different = Compare("EvolutionHistory medium", &grid, points,
+                            n_queries);
+  n_different += Compare("EvolutionHistory medium, shower paths", &grid,
+                         paths, n_queries);
+  n_different += Compare("Analytic medium", &analytic, points, n_queries);
+
+  return n_different == 0 ? 0 : 1;
+}
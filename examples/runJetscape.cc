@@ -79,6 +79,11 @@ int main(int argc, char** argv)
   // Run JetScape with all task/modules as specified
   jetscape->Exec();
 
+  // Forked workers (<nWorkers> > 1) are done once their events are written
+  if (jetscape->IsWorker()) {
+    return 0;
+  }
+
   // For the future, cleanup is mostly already done in write and clear
   jetscape->Finish();
   
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeWriterBinaryStream.h"
+#include "JetScapeReader.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+using namespace Jetscape;
+
+// write one event in the binary format and read it back bit by bit
+TEST(BinaryFormatTest, TEST_round_trip) {
+    std::string fname = "binary_format_test.jsbin";
+
+    auto shower = std::make_shared<PartonShower>();
+    node v0 = shower->new_vertex(std::make_shared<Vertex>(0., 0., 0., 0.));
+    node v1 = shower->new_vertex(std::make_shared<Vertex>(0.1, -0.2, 0.3, 0.4));
+    node v2 = shower->new_vertex(std::make_shared<Vertex>(1. / 3, 2. / 7, 0., 1.1));
+    FourVector p_in(10.1, 1. / 3, -4.7, 11.3);  // px, py, pz, E
+    FourVector p_out(5.3, 1. / 7, -2.1, 5.9);
+    FourVector x0(0., 0., 0., 0.);
+    shower->new_parton(v0, v1, std::make_shared<Parton>(0, 21, 0, p_in, x0));
+    shower->new_parton(v1, v2, std::make_shared<Parton>(1, 1, 11, p_out, x0));
+
+    FourVector p_pion(0.3, 1. / 9, 2.2, 2.3);
+    FourVector x_pion(1.5, -0.5, 0.25, 10.);
+    auto pion = std::make_shared<Hadron>(3, 211, 1, p_pion, x_pion);
+
+    {
+        JetScapeWriterBinary writer(fname);
+        writer.Init();
+        writer.GetHeader().SetSigmaGen(1.234e-3);
+        writer.GetHeader().SetSigmaErr(5.6e-5);
+        writer.GetHeader().SetEventWeight(0.7);
+        writer.GetHeader().SetNcoll(1500.5);
+        writer.WriteHeaderToFile();
+        writer.Write(shower);
+        writer.Write(pion);
+        writer.WriteEvent();
+        writer.Close();
+    }
+
+    JetScapeReaderAscii reader(fname);
+    ASSERT_TRUE(reader.IsBinary());
+    reader.Next();
+    EXPECT_TRUE(reader.Finished());
+
+    EXPECT_EQ(1.234e-3, reader.GetSigmaGen());
+    EXPECT_EQ(5.6e-5, reader.GetSigmaErr());
+    EXPECT_EQ(0.7, reader.GetEventWeight());
+    EXPECT_EQ(1500.5, reader.GetHeader().GetNcoll());
+
+    ASSERT_EQ(1, reader.GetCurrentNumberOfPartonShowers());
+    auto readShower = reader.GetPartonShowers()[0];
+    ASSERT_EQ(3, readShower->GetNumberOfVertices());
+    ASSERT_EQ(2, readShower->GetNumberOfPartons());
+    auto parton = readShower->GetPartonAt(1);
+    EXPECT_EQ(1, parton->pid());
+    EXPECT_EQ(11, parton->pstat());
+    EXPECT_EQ(p_out.x(), parton->px());
+    EXPECT_EQ(p_out.y(), parton->py());
+    EXPECT_EQ(p_out.z(), parton->pz());
+    EXPECT_EQ(p_out.t(), parton->e());
+    EXPECT_EQ(1. / 3, readShower->GetVertexAt(2)->x_in().x());
+
+    ASSERT_EQ(1, reader.GetHadrons().size());
+    auto readPion = reader.GetHadrons()[0];
+    EXPECT_EQ(211, readPion->pid());
+    EXPECT_EQ(pion->px(), readPion->px());
+    EXPECT_EQ(pion->py(), readPion->py());
+    EXPECT_EQ(pion->e(), readPion->e());
+    EXPECT_EQ(pion->restmass(), readPion->restmass());
+    EXPECT_EQ(x_pion.t(), readPion->x_in().t());
+
+    std::remove(fname.c_str());
+}
@@ -17,6 +17,7 @@
 #include "LiquefierBase.h"
 #include "gtest/gtest.h"
 #include <iostream>
+#include <random>
 
 using namespace Jetscape;
 
@@ -220,3 +221,56 @@ TEST(CausalLiquifierTest, TEST_GRID_TAU_ETA_CONSERVATION){
         }
     }
 }
+
+// check that the indexed get_source agrees with the sum over all droplets
+TEST(CausalLiquifierTest, TEST_SOURCE_INDEX){
+    
+    CausalLiquefier lqf(0.1,0.1,0.1,0.1);
+    
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for(int i = 0; i < 2000; i++){
+        std::array<Jetscape::real, 4> droplet_xmu = {
+            static_cast<Jetscape::real>(0.4 + 3.0*u(gen)),
+            static_cast<Jetscape::real>(10.0*(u(gen)-0.5)),
+            static_cast<Jetscape::real>(10.0*(u(gen)-0.5)),
+            static_cast<Jetscape::real>(4.0*(u(gen)-0.5))};
+        std::array<Jetscape::real, 4> droplet_pmu = {
+            2.0f,
+            static_cast<Jetscape::real>(u(gen)-0.5),
+            static_cast<Jetscape::real>(u(gen)-0.5),
+            static_cast<Jetscape::real>(u(gen)-0.5)};
+        lqf.add_a_droplet(Droplet(droplet_xmu, droplet_pmu));
+    }
+    
+    int n_nonzero = 0;
+    for(int i = 0; i < 2000; i++){
+        // cells close to droplets at the deposition time
+        const auto x_drop = lqf.get_a_droplet(i % 200).get_xmu();
+        Jetscape::real tau = x_drop[0] + lqf.tau_delay;
+        Jetscape::real x = x_drop[1] + 3.0*(u(gen)-0.5);
+        Jetscape::real y = x_drop[2] + 3.0*(u(gen)-0.5);
+        Jetscape::real eta = x_drop[3] + 1.0*(u(gen)-0.5);
+        
+        std::array<Jetscape::real, 4> jmu_all = {0.0,0.0,0.0,0.0};
+        for(int j = 0; j < lqf.get_dropletlist_size(); j++){
+            const Droplet drop_j = lqf.get_a_droplet(j);
+            const auto xj = drop_j.get_xmu();
+            double ds2 = tau*tau + xj[0]*xj[0]
+                - 2.0*tau*xj[0]*cosh(eta-xj[3])
+                - (x-xj[1])*(x-xj[1]) - (y-xj[2])*(y-xj[2]);
+            if( tau >= xj[0] && ds2 >= 0.0 ){
+                std::array<Jetscape::real, 4> jmu_j = {0.0,0.0,0.0,0.0};
+                lqf.smearing_kernel(tau, x, y, eta, drop_j, jmu_j);
+                for(int k = 0; k < 4; k++) jmu_all[k] += jmu_j[k];
+            }
+        }
+        
+        std::array<Jetscape::real, 4> jmu;
+        lqf.get_source(tau, x, y, eta, jmu);
+        for(int k = 0; k < 4; k++) EXPECT_EQ(jmu_all[k], jmu[k]);
+        if( jmu_all[0] != 0.0 ) n_nonzero++;
+    }
+    EXPECT_GT(n_nonzero, 100);
+    
+}
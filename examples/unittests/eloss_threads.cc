@@ -0,0 +1,211 @@
+/*******************************************************************************
+  * Copyright (c) The JETSCAPE Collaboration, 2018
+  *
+  * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+  *
+  * For the list of contributors see AUTHORS.
+  *
+  * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+  *
+  * or via email to bugs.jetscape@gmail.com
+  *
+  * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+  * See COPYING for details.
+  ******************************************************************************/
+#include "JetEnergyLossManager.h"
+#include "JetEnergyLoss.h"
+#include "FluidDynamics.h"
+#include "HardProcess.h"
+#include "JetScapeSignalManager.h"
+#include "JetScapeTaskSupport.h"
+#include "JetScapeXML.h"
+#include "Matter.h"
+#include "Martini.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Jetscape;
+
+namespace {
+
+// static medium at rest
+class Brick : public FluidDynamics {
+public:
+    Brick() {
+        hydro_status = FINISHED;
+        hydro_tau_0 = 0.6;
+    }
+
+    void GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
+                      Jetscape::real z,
+                      std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
+        fluid_cell_info_ptr =
+            std::unique_ptr<FluidCellInfo>(new FluidCellInfo);
+        fluid_cell_info_ptr->energy_density = 10.;
+        fluid_cell_info_ptr->entropy_density = 40.;
+        fluid_cell_info_ptr->temperature = 0.3;
+        fluid_cell_info_ptr->qgp_fraction = 1.;
+        fluid_cell_info_ptr->vx = 0.;
+        fluid_cell_info_ptr->vy = 0.;
+        fluid_cell_info_ptr->vz = 0.;
+    }
+};
+
+// quarks and gluons of 30 to 60 GeV in different directions
+class Gun : public HardProcess {
+public:
+    void Exec() {
+        double x[4] = {0., 0., 0., 0.};
+        for (int i = 0; i < 4; i++) {
+            double pt = 30. + 10. * i;
+            AddParton(std::make_shared<Parton>(0, i % 2 ? 21 : 1, 0, pt, 0.,
+                                               1.5 * i, pt, x));
+        }
+    }
+};
+
+std::string Config(std::string martini_path) {
+    return R"(<?xml version="1.0"?>
+<jetscape>
+  <Random> <seed>1</seed> </Random>
+  <Eloss>
+    <deltaT> 0.01 </deltaT>
+    <maxT> 3.6 </maxT>
+    <tStart> 0.6 </tStart>
+    <nThreads> 0 </nThreads>
+    <Matter>
+      <name> Matter </name>
+      <useHybridHad> 0 </useHybridHad>
+      <matter_on> 1 </matter_on>
+      <Q0> 2.0 </Q0>
+      <T0> 0.16 </T0>
+      <vir_factor> 0.25 </vir_factor>
+      <in_vac> 0 </in_vac>
+      <recoil_on> 0 </recoil_on>
+      <broadening_on> 0 </broadening_on>
+      <brick_med> 1 </brick_med>
+      <brick_length> 3.0 </brick_length>
+      <hydro_Tc> 0.16 </hydro_Tc>
+      <QhatParametrizationType> 0 </QhatParametrizationType>
+      <qhat0> -2.0 </qhat0>
+      <alphas> 0.25 </alphas>
+      <qhatA> 10.0 </qhatA>
+      <qhatB> 10.0 </qhatB>
+      <qhatC> 1.0 </qhatC>
+      <qhatD> 0.0 </qhatD>
+    </Matter>
+    <Martini>
+      <name> Martini </name>
+      <Q0> 2.0 </Q0>
+      <alpha_s> 0.3 </alpha_s>
+      <pcut> 2.0 </pcut>
+      <hydro_Tc> 0.16 </hydro_Tc>
+      <recoil_on> 0 </recoil_on>
+      <run_alphas> 1 </run_alphas>
+      <tabulate_radiation> 0 </tabulate_radiation>
+      <path> )" + martini_path + R"( </path>
+    </Martini>
+  </Eloss>
+</jetscape>
+)";
+}
+
+// the Martini tables are downloaded into the source tree
+std::string FindMartiniTables() {
+    for (const char *dir : {"../src/jet/Martini", "../../src/jet/Martini",
+                            "../../../src/jet/Martini"}) {
+        if (std::ifstream(std::string(dir) + "/radgamma").good())
+            return dir;
+    }
+    return "";
+}
+
+void ExpectSame(const std::vector<Parton> &a, const std::vector<Parton> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].pid(), b[i].pid());
+        EXPECT_EQ(a[i].pstat(), b[i].pstat());
+        EXPECT_EQ(a[i].px(), b[i].px());
+        EXPECT_EQ(a[i].py(), b[i].py());
+        EXPECT_EQ(a[i].pz(), b[i].pz());
+        EXPECT_EQ(a[i].e(), b[i].e());
+        EXPECT_EQ(a[i].x_in().t(), b[i].x_in().t());
+    }
+}
+
+// runs the same event with 0 (serial), 1 and 3 threads and compares the
+// final partons of every shower
+void ExpectSameForAllThreads(std::vector<std::shared_ptr<JetEnergyLoss>> modules,
+                             std::string martini_path) {
+    std::string fname = "eloss_threads_test.xml";
+    std::ofstream(fname) << Config(martini_path);
+    JetScapeXML::Instance()->OpenXMLMainFile(fname);
+    JetScapeXML::Instance()->OpenXMLUserFile(fname);
+    JetScapeTaskSupport::ReadSeedFromXML();
+
+    auto brick = std::make_shared<Brick>();
+    auto gun = std::make_shared<Gun>();
+    auto manager = std::make_shared<JetEnergyLossManager>();
+    auto jloss = std::make_shared<JetEnergyLoss>();
+    for (auto module : modules)
+        jloss->Add(module);
+    manager->Add(jloss);
+    JetScapeSignalManager::Instance()->SetHydroPointer(brick);
+    JetScapeSignalManager::Instance()->SetHardProcessPointer(gun);
+    JetScapeSignalManager::Instance()->SetJetEnergyLossManagerPointer(manager);
+    manager->Init();
+
+    std::vector<std::vector<std::vector<Parton>>> runs;
+    for (int n : {0, 1, 3}) {
+        manager->SetNumberOfThreads(n);
+        // the same event seeds for every run
+        manager->Reseed();
+        gun->Clear();
+        gun->Exec();
+        manager->Exec();
+
+        std::vector<std::vector<Parton>> showers;
+        for (auto it : manager->GetTaskList()) {
+            auto shower = std::dynamic_pointer_cast<JetEnergyLoss>(it)
+                              ->GetShower();
+            std::vector<Parton> partons;
+            for (auto p : shower->GetFinalPartons())
+                partons.push_back(*p);
+            showers.push_back(partons);
+        }
+        runs.push_back(showers);
+        manager->Clear();
+    }
+
+    ASSERT_EQ(runs[0].size(), 4);
+    EXPECT_GT(runs[0][0].size(), 1);
+    for (size_t run = 1; run < runs.size(); run++) {
+        ASSERT_EQ(runs[run].size(), runs[0].size());
+        for (size_t i = 0; i < runs[0].size(); i++)
+            ExpectSame(runs[0][i], runs[run][i]);
+    }
+    std::remove(fname.c_str());
+}
+
+} // namespace
+
+// the serial path gives the same showers as the thread pool
+TEST(ElossThreadsTest, TEST_matter_threads) {
+    ExpectSameForAllThreads({std::make_shared<Matter>()}, ".");
+}
+
+TEST(ElossThreadsTest, TEST_matter_martini_threads) {
+    std::string path = FindMartiniTables();
+    if (path.empty()) {
+        std::cout << "Martini tables not found in src/jet/Martini"
+                  << std::endl;
+        return;
+    }
+    ExpectSameForAllThreads(
+        {std::make_shared<Matter>(), std::make_shared<Martini>()}, path);
+}
@@ -15,8 +15,13 @@
 
 #include "FluidDynamics.h"
 #include "FluidEvolutionHistory.h"
+#include "LinearInterpolation.h"
+#include "SurfaceFinder.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <random>
+
 using namespace Jetscape;
 
 void test_not_in_range(EvolutionHistory hist, real tau, real x, real y, real eta) {
@@ -69,3 +74,258 @@ TEST(EvolutionHistoryTest, TEST_WRITE){
     // check almost equal for two float numbers
     ASSERT_NEAR(hist.get(0.8, 0.0, 0.0, 0.0).energy_density, static_cast<real>(const_ed), 1.0E-6);
 }
+
+// cells read through the precompiled layout match the name lookup
+TEST(EvolutionHistoryTest, TEST_DATA_LAYOUT){
+    std::vector<std::string> info = {"temperature", "vx", "pi01", "bulk_pi"};
+    int nx = 3, ny = 3, neta = 1, ntau = 2;
+    std::vector<float> bulk;
+    for (int i = 0; i < ntau * nx * ny * neta * (int)info.size(); i++)
+        bulk.push_back(0.01 * i);
+
+    auto hist = EvolutionHistory();
+    hist.FromVector(bulk, info, 0.6, 0.1, -1., 1., nx, -1., 1., ny,
+                    0., 0.1, neta, false);
+    ASSERT_EQ(hist.data_layout.size(), info.size());
+    EXPECT_EQ(hist.data_layout[2], ENTRY_PI01);
+
+    auto cell = hist.GetFluidCell(1, 2, 0, 0);
+    int record = (1 * nx * ny + 2 * ny) * info.size();
+    EXPECT_EQ(cell.temperature, bulk[record]);
+    EXPECT_EQ(cell.vx, bulk[record + 1]);
+    EXPECT_EQ(cell.pi[0][1], bulk[record + 2]);
+    EXPECT_EQ(cell.pi[1][0], bulk[record + 2]);
+    EXPECT_EQ(cell.bulk_Pi, bulk[record + 3]);
+
+    // stale layout falls back to the names
+    hist.data_layout.clear();
+    auto cell_by_name = hist.GetFluidCell(1, 2, 0, 0);
+    EXPECT_EQ(cell_by_name.temperature, cell.temperature);
+    EXPECT_EQ(cell_by_name.pi[1][0], cell.pi[1][0]);
+}
+
+// the batched query gives the same numbers as get() point by point
+TEST(EvolutionHistoryTest, TEST_BATCH){
+    std::vector<std::string> info = {"energy_density", "temperature", "vx",
+                                     "vy", "pi12", "bulk_pi"};
+    int nx = 11, ny = 9, neta = 5, ntau = 6;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> uni(0., 1.);
+    std::vector<float> bulk(ntau * nx * ny * neta * info.size());
+    for (auto &v : bulk) v = uni(gen);
+
+    auto hist = EvolutionHistory();
+    hist.FromVector(bulk, info, 0.6, 0.1, -1., 0.2, nx, -0.8, 0.2, ny,
+                    -0.4, 0.2, neta, false);
+    hist.boost_invariant = false;
+
+    FluidCellBatch cells;
+    cells.mask = FieldMask(ENTRY_TEMPERATURE) | FieldMask(ENTRY_VX) |
+                 FieldMask(ENTRY_PI12) | FieldMask(ENTRY_MU_B);
+    for (int i = 0; i < 500; i++)
+        cells.add_point(0.55 + 0.6 * uni(gen), -1.1 + 2.2 * uni(gen),
+                        -0.9 + 1.8 * uni(gen), -0.5 + 1.0 * uni(gen));
+    hist.get_batch(cells);
+
+    EXPECT_TRUE(cells.entry[ENTRY_ENERGY_DENSITY].empty());
+    for (int i = 0; i < cells.size(); i++) {
+        auto cell = hist.get(cells.t[i], cells.x[i], cells.y[i], cells.z[i]);
+        EXPECT_EQ(cells.entry[ENTRY_TEMPERATURE][i], cell.temperature);
+        EXPECT_EQ(cells.entry[ENTRY_VX][i], cell.vx);
+        EXPECT_EQ(cells.entry[ENTRY_PI12][i], cell.pi[2][1]);
+        EXPECT_EQ(cells.entry[ENTRY_MU_B][i], cell.mu_B);
+    }
+}
+
+// cached stencils give the same numbers as get(), and go stale with the data
+TEST(EvolutionHistoryTest, TEST_STENCIL_CACHE){
+    std::vector<std::string> info = {"energy_density", "temperature", "vx",
+                                     "pi12"};
+    int nx = 11, ny = 9, neta = 5, ntau = 6;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> uni(0., 1.);
+    std::vector<float> bulk(ntau * nx * ny * neta * info.size());
+    for (auto &v : bulk) v = uni(gen);
+
+    auto hist = EvolutionHistory();
+    hist.FromVector(bulk, info, 0.6, 0.1, -1., 0.2, nx, -0.8, 0.2, ny,
+                    -0.4, 0.2, neta, false);
+    hist.boost_invariant = false;
+
+    // a few partons walking through the grid
+    FluidStencilCache cache;
+    for (int i = 0; i < 20; i++) {
+        real x = -0.5 + 0.05 * i, y = 0.1, eta = -0.1 + 0.01 * i;
+        for (real tau = 0.6; tau < 1.05; tau += 0.02) {
+            auto cell = hist.get(tau, x, y, eta);
+            auto cached = cache.get(hist, tau, x, y, eta);
+            EXPECT_EQ(cell.energy_density, cached.energy_density);
+            EXPECT_EQ(cell.temperature, cached.temperature);
+            EXPECT_EQ(cell.vx, cached.vx);
+            EXPECT_EQ(cell.pi[1][2], cached.pi[1][2]);
+
+            // get() still interpolates between the same two time steps
+            int id_tau = hist.GetIdTau(tau);
+            auto step = LinearInt(hist.TauCoord(id_tau),
+                                  hist.TauCoord(id_tau + 1),
+                                  hist.GetAtTimeStep(id_tau, x, y, eta),
+                                  hist.GetAtTimeStep(id_tau + 1, x, y, eta),
+                                  tau);
+            EXPECT_EQ(step.temperature, cell.temperature);
+        }
+    }
+    EXPECT_GT(cache.GetHits(), 4 * cache.GetMisses());
+
+    // outside the grid nothing is cached
+    unsigned long misses = cache.GetMisses();
+    EXPECT_EQ(0., cache.get(hist, 5., 0., 0., 0.).temperature);
+    EXPECT_EQ(misses, cache.GetMisses());
+
+    // new data, new epoch: the same cell is read again
+    for (auto &v : bulk) v = 2. * v;
+    hist.FromVector(bulk, info, 0.6, 0.1, -1., 0.2, nx, -0.8, 0.2, ny,
+                    -0.4, 0.2, neta, false);
+    cache.ResetCounters();
+    auto cell = hist.get(0.7, 0., 0.1, 0.);
+    EXPECT_EQ(cell.temperature, cache.get(hist, 0.7, 0., 0.1, 0.).temperature);
+    EXPECT_EQ(0, cache.GetHits());
+    EXPECT_EQ(1, cache.GetMisses());
+}
+
+// the surface is on T_cut and comes out the same for any number of threads
+TEST(EvolutionHistoryTest, TEST_SURFACE_FINDER_THREADS){
+    std::vector<std::string> info = {"temperature", "vx"};
+    int nx = 26, ny = 26, neta = 1, ntau = 12;
+    std::vector<float> bulk;
+    for (int t = 0; t < ntau; t++)
+        for (int i = 0; i < nx; i++)
+            for (int j = 0; j < ny; j++) {
+                real tau = 0.6 + 0.2 * t, x = -5. + 0.4 * i, y = -5. + 0.4 * j;
+                bulk.push_back(0.3 * exp(-(x * x + 0.7 * y * y) / 8.) *
+                               pow(0.6 / tau, 1. / 3.));
+                bulk.push_back(0.05 * x);
+            }
+
+    auto hist = EvolutionHistory();
+    hist.FromVector(bulk, info, 0.6, 0.2, -5., 0.4, nx, -5., 0.4, ny,
+                    0., 0.1, neta, false);
+    hist.boost_invariant = true;
+
+    SurfaceFinder serial(0.15, hist);
+    serial.Find_full_hypersurface();
+    SurfaceFinder parallel(0.15, hist);
+    parallel.set_number_of_threads(3);
+    parallel.Find_full_hypersurface();
+
+    ASSERT_GT(serial.get_number_of_surface_cells(), 100);
+    ASSERT_EQ(serial.get_number_of_surface_cells(),
+              parallel.get_number_of_surface_cells());
+    for (int i = 0; i < serial.get_number_of_surface_cells(); i++) {
+        auto a = serial.get_surface_cell_with_idx(i);
+        auto b = parallel.get_surface_cell_with_idx(i);
+        EXPECT_EQ(a.tau, b.tau);
+        EXPECT_EQ(a.x, b.x);
+        EXPECT_EQ(a.y, b.y);
+        EXPECT_EQ(a.d3sigma_mu[0], b.d3sigma_mu[0]);
+        EXPECT_EQ(a.vx, b.vx);
+        EXPECT_NEAR(0.15, a.temperature, 0.01);
+    }
+}
+
+// half floats round to nearest even and keep inf, nan and subnormals
+TEST(EvolutionHistoryTest, TEST_HALF_FLOAT){
+    EXPECT_EQ(0x3c00, FloatToHalf(1.f));
+    EXPECT_EQ(0xc000, FloatToHalf(-2.f));
+    EXPECT_EQ(0x7bff, FloatToHalf(65504.f));
+    EXPECT_EQ(0x7c00, FloatToHalf(65520.f));
+    EXPECT_EQ(0x0001, FloatToHalf(std::ldexp(1.f, -24)));
+    EXPECT_EQ(0x0000, FloatToHalf(std::ldexp(1.f, -25)));
+    EXPECT_EQ(0x3c00, FloatToHalf(1.f + std::ldexp(1.f, -11)));
+    EXPECT_EQ(0x3c02, FloatToHalf(1.f + 3.f * std::ldexp(1.f, -11)));
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(NAN))));
+    for (int h = 0; h < 0x10000; h++) {
+        float f = HalfToFloat(h);
+        if (!std::isnan(f))
+            EXPECT_EQ(h, FloatToHalf(f));
+    }
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> uni(-10., 10.);
+    for (int i = 0; i < 1000; i++) {
+        float f = uni(gen);
+        EXPECT_NEAR(f, HalfToFloat(FloatToHalf(f)), std::fabs(f) / 2048.);
+    }
+}
+
+// cells stored in a compact layout read back like FluidCellInfo cells
+TEST(EvolutionHistoryTest, TEST_COMPACT_LAYOUT){
+    int nx = 7, ny = 6, neta = 4, ntau = 5;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> uni(0., 1.);
+
+    auto full = EvolutionHistory();
+    auto compact = EvolutionHistory();
+    for (auto hist : {&full, &compact}) {
+        hist->tau_min = 0.6;
+        hist->dtau = 0.1;
+        hist->x_min = -0.6;
+        hist->dx = 0.2;
+        hist->y_min = -0.5;
+        hist->dy = 0.2;
+        hist->eta_min = -0.3;
+        hist->deta = 0.2;
+        hist->ntau = ntau;
+        hist->nx = nx;
+        hist->ny = ny;
+        hist->neta = neta;
+        hist->tau_eta_is_tz = false;
+        hist->boost_invariant = false;
+    }
+    unsigned int mask = FieldMask(ENTRY_TEMPERATURE) | FieldMask(ENTRY_VX) |
+                        FieldMask(ENTRY_PI01) | FieldMask(ENTRY_BULK_PI);
+    compact.SetCompactLayout(mask, FIELD_MASK_VISCOUS);
+    EXPECT_EQ(2u, compact.data_info.size());
+    EXPECT_EQ(2u, compact.data_info_half.size());
+
+    int n_cells = ntau * nx * ny * neta;
+    compact.ReserveCells(n_cells);
+    for (int i = 0; i < n_cells; i++) {
+        FluidCellInfo cell;
+        cell.temperature = uni(gen);
+        cell.vx = uni(gen);
+        cell.energy_density = uni(gen);
+        // exact in half precision, so both histories hold the same numbers
+        cell.pi[0][1] = cell.pi[1][0] = HalfToFloat(FloatToHalf(uni(gen)));
+        cell.bulk_Pi = HalfToFloat(FloatToHalf(uni(gen)));
+        full.StoreCell(cell);
+        compact.StoreCell(cell);
+    }
+    EXPECT_EQ(n_cells, full.get_data_size());
+    EXPECT_EQ(n_cells, compact.get_data_size());
+    EXPECT_EQ(2 * n_cells, (int)compact.data_vector.size());
+    EXPECT_TRUE(compact.data.empty());
+
+    FluidCellBatch cells;
+    cells.mask = FIELD_MASK_ALL;
+    for (int i = 0; i < 200; i++)
+        cells.add_point(0.6 + 0.4 * uni(gen), -0.6 + 1.2 * uni(gen),
+                        -0.5 + 1.0 * uni(gen), -0.3 + 0.6 * uni(gen));
+    compact.get_batch(cells);
+    for (int i = 0; i < cells.size(); i++) {
+        auto a = full.get(cells.t[i], cells.x[i], cells.y[i], cells.z[i]);
+        auto b = compact.get(cells.t[i], cells.x[i], cells.y[i], cells.z[i]);
+        EXPECT_EQ(a.temperature, b.temperature);
+        EXPECT_EQ(a.vx, b.vx);
+        EXPECT_EQ(a.pi[1][0], b.pi[1][0]);
+        EXPECT_EQ(a.bulk_Pi, b.bulk_Pi);
+        EXPECT_EQ(0., b.energy_density);
+        EXPECT_EQ(b.temperature, cells.entry[ENTRY_TEMPERATURE][i]);
+        EXPECT_EQ(b.pi[0][1], cells.entry[ENTRY_PI01][i]);
+        EXPECT_EQ(b.bulk_Pi, cells.entry[ENTRY_BULK_PI][i]);
+        EXPECT_EQ(0., cells.entry[ENTRY_ENERGY_DENSITY][i]);
+    }
+
+    // clearing keeps the layout
+    compact.clear_up_evolution_data();
+    EXPECT_EQ(0, compact.get_data_size());
+    EXPECT_EQ(2u, compact.data_info_half.size());
+}
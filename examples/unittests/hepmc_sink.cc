@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeWriterHepMCSink.h"
+#include "gtest/gtest.h"
+
+using namespace Jetscape;
+
+namespace {
+
+// counts the final partons and particles of the last event
+class FinalStatusRecorder : public JetScapeHepMCConsumer {
+public:
+    void Analyze(const HepMC3::GenEvent &evt) {
+        n_final_particles = 0;
+        n_final_partons = 0;
+        for (auto p : evt.particles()) {
+            if (p->status() == 1)
+                n_final_particles++;
+            if (p->status() == 11)
+                n_final_partons++;
+        }
+    }
+
+    int n_final_particles = 0;
+    int n_final_partons = 0;
+};
+
+// one parton splitting into n
+void FillShower(PartonShower &shower, int n) {
+    FourVector x0(0., 0., 0., 0.);
+    node v0 = shower.new_vertex(Vertex(0., 0., 0., 0.));
+    node v1 = shower.new_vertex(Vertex(0., 0., 0., 0.5));
+    shower.new_parton(v0, v1,
+                      Parton(0, 21, 0, FourVector(0., 0., 100., 100.), x0));
+    for (int i = 0; i < n; i++) {
+        node v = shower.new_vertex(Vertex(0., 0., 0., 1. + i));
+        shower.new_parton(v1, v, Parton(i + 1, 1, 0,
+                                        FourVector(1. + i, 0., 10., 20.), x0));
+    }
+}
+
+} // namespace
+
+// check that the in-memory event reaches the consumer
+TEST(JetScapeWriterHepMCSinkTest, TEST_consume_hadrons) {
+    auto counter = std::make_shared<HepMCEventCounter>();
+    JetScapeWriterHepMCSink sink;
+    sink.AddConsumer(counter);
+
+    FourVector p_pion(1.0, 0.0, 0.0, 1.1);  // px, py, pz, E
+    FourVector x_pion(0.0, 0.0, 0.0, 1.0);  // x, y, z, t
+
+    for (int ievent = 0; ievent < 3; ievent++) {
+        sink.WriteHeaderToFile();
+        sink.Write(std::make_shared<Hadron>(0, 211, 0, p_pion, x_pion));
+        sink.Write(std::make_shared<Hadron>(1, -211, 0, p_pion, x_pion));
+        sink.WriteEvent();
+    }
+
+    EXPECT_EQ(3, counter->GetNumberOfEvents());
+    EXPECT_EQ(6, counter->GetNumberOfFinalParticles());
+}
+
+// consumers can be picked by their registered name
+TEST(JetScapeWriterHepMCSinkTest, TEST_consumer_factory) {
+    EXPECT_TRUE(JetScapeHepMCConsumerFactory::createInstance("HepMCEventCounter"));
+    EXPECT_FALSE(JetScapeHepMCConsumerFactory::createInstance("NoSuchConsumer"));
+}
+
+// final partons are promoted to status 1 in every event without hadrons,
+// also after an event with hadrons
+TEST(JetScapeWriterHepMCSinkTest, TEST_promote_partons_per_event) {
+    auto recorder = std::make_shared<FinalStatusRecorder>();
+    JetScapeWriterHepMCSink sink;
+    sink.AddConsumer(recorder);
+
+    auto shower = std::make_shared<PartonShower>();
+    FillShower(*shower, 3);
+    FourVector p_pion(1.0, 0.0, 0.0, 1.1);
+    FourVector x_pion(0.0, 0.0, 0.0, 1.0);
+
+    sink.WriteHeaderToFile();
+    sink.Write(shower);
+    sink.Write(std::make_shared<Hadron>(0, 211, 0, p_pion, x_pion));
+    sink.WriteEvent();
+    EXPECT_EQ(1, recorder->n_final_particles);
+    EXPECT_EQ(3, recorder->n_final_partons);
+
+    sink.WriteHeaderToFile();
+    sink.Write(shower);
+    sink.WriteEvent();
+    EXPECT_EQ(3, recorder->n_final_particles);
+    EXPECT_EQ(0, recorder->n_final_partons);
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "HydroEventLibrary.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace Jetscape;
+
+static void SetGrid(EvolutionHistory &hist, int ntau, int nx, int ny,
+                    int neta) {
+    hist.tau_min = 0.6;
+    hist.dtau = 0.1;
+    hist.x_min = -0.6;
+    hist.dx = 0.2;
+    hist.y_min = -0.5;
+    hist.dy = 0.2;
+    hist.eta_min = -0.3;
+    hist.deta = 0.2;
+    hist.ntau = ntau;
+    hist.nx = nx;
+    hist.ny = ny;
+    hist.neta = neta;
+    hist.tau_eta_is_tz = false;
+    hist.boost_invariant = false;
+}
+
+// histories read back from the library give the same cells as the originals
+TEST(HydroEventLibraryTest, TEST_round_trip) {
+    std::string fname = "hydro_event_library_test.lib";
+    std::remove(fname.c_str());
+    int nx = 7, ny = 6, neta = 4, ntau = 5;
+    int n_cells = ntau * nx * ny * neta;
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<float> uni(0., 1.);
+
+    // FluidCellInfo cells, and a compact history with half floats
+    EvolutionHistory cells, compact;
+    SetGrid(cells, ntau, nx, ny, neta);
+    SetGrid(compact, ntau, nx, ny, neta);
+    compact.SetCompactLayout(FieldMask(ENTRY_TEMPERATURE) |
+                                 FieldMask(ENTRY_VZ) | FieldMask(ENTRY_PI13),
+                             FIELD_MASK_VISCOUS);
+    for (int i = 0; i < n_cells; i++) {
+        FluidCellInfo cell;
+        cell.energy_density = uni(gen);
+        cell.temperature = uni(gen);
+        cell.vz = uni(gen);
+        cell.pi[1][3] = cell.pi[3][1] = uni(gen);
+        cell.bulk_Pi = uni(gen);
+        cells.StoreCell(cell);
+        compact.StoreCell(cell);
+    }
+
+    {
+        HydroEventLibraryWriter writer(fname);
+        EXPECT_EQ(0, writer.Add(cells));
+    }
+    {
+        // a second job adds to the same library
+        HydroEventLibraryWriter writer(fname);
+        EXPECT_EQ(1, writer.Add(compact));
+    }
+
+    EvolutionHistory read_cells, read_compact;
+    {
+        HydroEventLibrary library(fname);
+        ASSERT_EQ(2, library.GetNumberOfEvents());
+        library.Load(0, read_cells);
+        library.Load(1, read_compact);
+        EXPECT_THROW(library.Load(2, read_cells), std::out_of_range);
+    }
+    // the histories keep the mapping
+    EXPECT_TRUE(read_cells.HasExternalRecords());
+    EXPECT_EQ(n_cells, read_cells.get_data_size());
+    EXPECT_EQ(n_cells, read_compact.get_data_size());
+    EXPECT_EQ(nx, read_compact.nx);
+    EXPECT_EQ(compact.data_info_half, read_compact.data_info_half);
+
+    FluidCellBatch batch;
+    batch.mask = FIELD_MASK_ALL;
+    for (int i = 0; i < 200; i++)
+        batch.add_point(0.6 + 0.4 * uni(gen), -0.6 + 1.2 * uni(gen),
+                        -0.5 + 1.0 * uni(gen), -0.3 + 0.6 * uni(gen));
+    read_compact.get_batch(batch);
+    for (int i = 0; i < batch.size(); i++) {
+        real tau = batch.t[i], x = batch.x[i], y = batch.y[i];
+        real eta = batch.z[i];
+        auto a = cells.get(tau, x, y, eta);
+        auto b = read_cells.get(tau, x, y, eta);
+        EXPECT_EQ(a.energy_density, b.energy_density);
+        EXPECT_EQ(a.temperature, b.temperature);
+        EXPECT_EQ(a.pi[3][1], b.pi[3][1]);
+        EXPECT_EQ(a.bulk_Pi, b.bulk_Pi);
+
+        auto c = compact.get(tau, x, y, eta);
+        auto d = read_compact.get(tau, x, y, eta);
+        EXPECT_EQ(c.temperature, d.temperature);
+        EXPECT_EQ(c.vz, d.vz);
+        EXPECT_EQ(c.pi[1][3], d.pi[1][3]);
+        EXPECT_EQ(0., d.bulk_Pi);
+        EXPECT_EQ(d.temperature, batch.entry[ENTRY_TEMPERATURE][i]);
+        EXPECT_EQ(d.pi[1][3], batch.entry[ENTRY_PI13][i]);
+    }
+
+    // clearing lets go of the mapping
+    read_cells.clear_up_evolution_data();
+    EXPECT_FALSE(read_cells.HasExternalRecords());
+    EXPECT_EQ(0, read_cells.get_data_size());
+    std::remove(fname.c_str());
+}
+
+TEST(HydroEventLibraryTest, TEST_not_a_library) {
+    std::string fname = "hydro_event_library_bad.lib";
+    {
+        std::ofstream out(fname.c_str());
+        out << "not a hydro event library, but long enough for a header";
+    }
+    EXPECT_THROW(HydroEventLibrary library(fname), std::runtime_error);
+    EvolutionHistory hist;
+    HydroEventLibraryWriter writer(fname);
+    EXPECT_THROW(writer.Add(hist), std::runtime_error);
+    std::remove(fname.c_str());
+    EXPECT_THROW(HydroEventLibrary library(fname), std::runtime_error);
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+  * Copyright (c) The JETSCAPE Collaboration, 2018
+  *
+  * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+  * 
+  * For the list of contributors see AUTHORS.
+  *
+  * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+  *
+  * or via email to bugs.jetscape@gmail.com
+  *
+  * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+  * See COPYING for details.
+  ******************************************************************************/
+#include "LBT.h"
+#include "JetScapeXML.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace Jetscape;
+
+namespace {
+
+// static medium at rest
+class Brick : public sigslot::has_slots<sigslot::multi_threaded_local> {
+public:
+    void GetHydroCell(double t, double x, double y, double z,
+                      std::unique_ptr<FluidCellInfo> &cell) {
+        cell = std::unique_ptr<FluidCellInfo>(new FluidCellInfo);
+        cell->energy_density = 10.;
+        cell->temperature = 0.3;
+        cell->vx = 0.;
+        cell->vy = 0.;
+        cell->vz = 0.;
+    }
+};
+
+const char *config = R"(<?xml version="1.0"?>
+<jetscape>
+  <Random> <seed>1</seed> </Random>
+  <Eloss>
+    <tStart> 0.6 </tStart>
+    <Lbt>
+      <name> Lbt </name>
+      <Q0> 2.0 </Q0>
+      <in_vac> 0 </in_vac>
+      <only_leading> 0 </only_leading>
+      <hydro_Tc> 0.16 </hydro_Tc>
+      <alphas> 0.3 </alphas>
+      <run_alphas> 1 </run_alphas>
+    </Lbt>
+  </Eloss>
+</jetscape>
+)";
+
+// LBT reads its tables relative to the build directory
+bool FindTables() {
+    for (const char *dir : {".", "..", "../.."}) {
+        std::string input = std::string(dir) + "/LBT-tables/LBT.input";
+        if (std::ifstream(input).good())
+            return chdir(dir) == 0;
+    }
+    return false;
+}
+
+// a 50 GeV gluon and everything it produces in 3 fm/c
+std::vector<Parton> RunShower(JetEnergyLoss &lbt) {
+    FourVector x(0., 0., 0., 0.6);
+    std::vector<Parton> partons;
+    partons.push_back(Parton(0, 21, 0, FourVector(0., 0., 50., 50.), x));
+    for (int step = 0; step < 30; step++) {
+        double time = 0.6 + 0.1 * step;
+        std::vector<Parton> next;
+        for (auto &p : partons) {
+            std::vector<Parton> in(1, p), out;
+            lbt.DoEnergyLoss(0.1, time, 0., in, out);
+            // partons LBT did not take are kept as they are
+            if (!in[0].GetControlled())
+                next.push_back(in[0]);
+            next.insert(next.end(), out.begin(), out.end());
+        }
+        partons.swap(next);
+    }
+    return partons;
+}
+
+std::shared_ptr<JetEnergyLoss> MakeClone(LBT &lbt, Brick &brick,
+                                         unsigned int seed) {
+    auto copy = lbt.Clone();
+    copy->GetHydroCellSignal.connect(&brick, &Brick::GetHydroCell);
+    copy->SetMt19937Generator(std::make_shared<std::mt19937>(seed));
+    return copy;
+}
+
+void ExpectSame(const std::vector<Parton> &a, const std::vector<Parton> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].pid(), b[i].pid());
+        EXPECT_EQ(a[i].pstat(), b[i].pstat());
+        EXPECT_EQ(a[i].px(), b[i].px());
+        EXPECT_EQ(a[i].py(), b[i].py());
+        EXPECT_EQ(a[i].pz(), b[i].pz());
+        EXPECT_EQ(a[i].e(), b[i].e());
+        EXPECT_EQ(a[i].x_in().t(), b[i].x_in().t());
+    }
+}
+
+} // namespace
+
+// two copies running at the same time give what they give one after the other
+TEST(LBTShowersTest, TEST_concurrent_clones) {
+    if (!FindTables()) {
+        std::cout << "LBT-tables not found, see get_lbtTab.sh" << std::endl;
+        return;
+    }
+    std::string fname = "lbt_showers_test.xml";
+    std::ofstream(fname) << config;
+    JetScapeXML::Instance()->OpenXMLMainFile(fname);
+    JetScapeXML::Instance()->OpenXMLUserFile(fname);
+
+    auto lbt = std::make_shared<LBT>();
+    lbt->Init();
+    EXPECT_TRUE(lbt->SupportsParallelShowers());
+    Brick brick;
+
+    auto first = MakeClone(*lbt, brick, 11);
+    auto second = MakeClone(*lbt, brick, 12);
+    std::vector<Parton> first_serial = RunShower(*first);
+    std::vector<Parton> second_serial = RunShower(*second);
+    EXPECT_GT(first_serial.size(), 1);
+
+    first = MakeClone(*lbt, brick, 11);
+    second = MakeClone(*lbt, brick, 12);
+    std::vector<Parton> first_parallel, second_parallel;
+    std::thread t([&]() { first_parallel = RunShower(*first); });
+    second_parallel = RunShower(*second);
+    t.join();
+
+    ExpectSame(first_serial, first_parallel);
+    ExpectSame(second_serial, second_parallel);
+    std::remove(fname.c_str());
+}
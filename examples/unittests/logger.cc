@@ -0,0 +1,196 @@
+/*******************************************************************************
+  * Copyright (c) The JETSCAPE Collaboration, 2018
+  *
+  * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+  * 
+  * For the list of contributors see AUTHORS.
+  *
+  * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+  *
+  * or via email to bugs.jetscape@gmail.com
+  *
+  * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+  * See COPYING for details.
+  ******************************************************************************/
+#include "JetScapeLogger.h"
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Jetscape;
+
+namespace {
+
+// collects everything written to std::cout while it exists
+class CaptureCout {
+public:
+    CaptureCout() : old(nullptr) {
+        JetScapeLogger::Instance()->Flush();
+        old = std::cout.rdbuf(captured.rdbuf());
+    }
+    ~CaptureCout() { std::cout.rdbuf(old); }
+    std::string Text() {
+        JetScapeLogger::Instance()->Flush();
+        return captured.str();
+    }
+
+private:
+    std::ostringstream captured;
+    std::streambuf *old;
+};
+
+int Count(const std::string &text, const std::string &what) {
+    int n = 0;
+    for (size_t pos = text.find(what); pos != std::string::npos;
+              pos = text.find(what, pos + 1)) {
+        n++;
+    }
+    return n;
+}
+
+std::string Inner() {
+    JSINFO << "inner message";
+    return "outer argument";
+}
+
+void Warn(int i) { JSWARN << "storm " << i; }
+
+} // namespace
+
+// every message ends up complete on its own line, also from several threads
+TEST(LoggerTest, TEST_whole_lines) {
+    JetScapeLogger::Instance()->SetRateLimit(0);
+    CaptureCout capture;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(std::thread([t]() {
+            for (int i = 0; i < 200; i++) {
+                JSINFO << "thread " << t << " message " << i << " end";
+            }
+        }));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    std::string text = capture.Text();
+    EXPECT_EQ(Count(text, "message"), 800);
+    EXPECT_EQ(Count(text, " end"), 800);
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        EXPECT_EQ(Count(line, "message"), 1) << line;
+    }
+}
+
+// a message formatted while another one is open does not mix with it
+TEST(LoggerTest, TEST_nested) {
+    CaptureCout capture;
+    JSINFO << "outer message, " << Inner();
+    std::string text = capture.Text();
+    EXPECT_NE(text.find("inner message"), std::string::npos);
+    EXPECT_NE(text.find("outer message, outer argument"), std::string::npos);
+}
+
+// JSINFO and JSWARN are expressions, also with the namespace spelled out
+TEST(LoggerTest, TEST_expressions) {
+    CaptureCout capture;
+    bool warn = true;
+    warn ? (void)(Jetscape::JSWARN << "qualified warning")
+         : (void)(JSINFO << "unqualified info");
+    Jetscape::JSINFO << "qualified info";
+    std::string text = capture.Text();
+    EXPECT_NE(text.find("qualified warning"), std::string::npos);
+    EXPECT_EQ(text.find("unqualified info"), std::string::npos);
+    EXPECT_NE(text.find("qualified info"), std::string::npos);
+}
+
+// one line of code writes at most the rate limit per second and reports
+// what it left out
+TEST(LoggerTest, TEST_rate_limit) {
+    JetScapeLogger::Instance()->SetRateLimit(5);
+    CaptureCout capture;
+    for (int i = 0; i < 1000; i++) {
+        Warn(i);
+    }
+    std::string text = capture.Text();
+    int written = Count(text, "storm");
+    EXPECT_GE(written, 5);
+    EXPECT_LE(written, 10); // the loop may cross into a second window
+
+    // the next message written reports the suppressed ones
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    Warn(1000);
+    text = capture.Text();
+    EXPECT_NE(text.find("storm 1000"), std::string::npos);
+    EXPECT_NE(text.find("similar messages suppressed"), std::string::npos);
+    JetScapeLogger::Instance()->SetRateLimit(100);
+}
+
+// the verbose level is checked before anything is formatted
+TEST(LoggerTest, TEST_verbose_not_evaluated) {
+    JetScapeLogger::Instance()->SetVerboseLevel(2);
+    int evaluated = 0;
+    CaptureCout capture;
+    VERBOSE(1) << "shown " << ++evaluated;
+    VERBOSE(5) << "hidden " << ++evaluated;
+    if (evaluated > 100)
+        JSWARN << "never";
+    else
+        VERBOSE(3) << "hidden " << ++evaluated;
+    std::string text = capture.Text();
+    EXPECT_EQ(evaluated, 1);
+    EXPECT_NE(text.find("shown 1"), std::string::npos);
+    EXPECT_EQ(text.find("hidden"), std::string::npos);
+    JetScapeLogger::Instance()->SetVerboseLevel(0);
+}
+
+// a forked child logs with its own thread and does not repeat the parent's
+TEST(LoggerTest, TEST_fork) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::streambuf *console = std::cout.rdbuf();
+    std::string parent_text;
+    pid_t pid;
+    {
+        CaptureCout capture;
+        JSINFO << "before fork";
+        pid = fork();
+        if (pid == 0) {
+            alarm(10); // a hanging child fails the test instead of the run
+            std::cout.rdbuf(console);
+            dup2(fds[1], 1);
+            close(fds[0]);
+            close(fds[1]);
+            JetScapeLogger::Instance()->SetRateLimit(0);
+            for (int i = 0; i < 1000; i++)
+                JSINFO << "in child " << i;
+            std::exit(0);
+        }
+        ASSERT_GT(pid, 0);
+        JSINFO << "after fork";
+        parent_text = capture.Text();
+    }
+    close(fds[1]);
+    std::string child_text;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+        child_text.append(buffer, n);
+    close(fds[0]);
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    EXPECT_EQ(Count(parent_text, "before fork"), 1);
+    EXPECT_EQ(Count(parent_text, "after fork"), 1);
+    EXPECT_EQ(Count(child_text, "before fork"), 0);
+    EXPECT_NE(child_text.find("in child 999"), std::string::npos);
+}
@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "Martini.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Jetscape;
+
+namespace {
+
+const int NP = 230;
+const int NK = 381;
+
+// shapes below the envelopes of the rejection method, with some structure
+double TargetRate(int kind, double p, double k) {
+    double wiggle = 1. + 0.3 * sin(3. * log(std::abs(k)));
+    if (kind == 0) {
+        if (k > 0) return 0.6 * (0.025 / (k * k) + 0.01 / k) * wiggle;
+        return 0.6 * 0.025 / (k * k) * wiggle;
+    } else if (kind == 1) {
+        if (k > 0) return 0.5 / p * (1. - 0.4 * k / p) * (1. + 0.15 * sin(k));
+        return 0.49 * exp((1. - 1. / p) * (k - 2.5)) / p *
+               (1. + 0.3 * sin(2. * k));
+    } else if (kind == 2) {
+        if (k > 0) return 0.6 * (0.1 / (k * k) + 0.02 / k) * wiggle;
+        return 0.6 * 0.1 / (k * k) * wiggle;
+    }
+    if (k > 0) return 0.006 / (pow(k, 0.7) * sqrt(p)) * wiggle;
+    return 0.;
+}
+
+// inverse of the factors use_table divides the tabulated values by
+double TableEntry(int kind, double p, double k) {
+    if (std::abs(k) < 1e-6) {
+        if (kind == 0) return 0.015;
+        if (kind == 2) return 0.06;
+        if (kind == 3) return 0.;
+        k = 1e-6;
+    }
+    double f = TargetRate(kind, p, k);
+    if (kind == 0) {
+        f *= k;
+        if (k < 20.) f *= 1. - exp(-k);
+        if (k > p - 20.) f *= 1. + exp(k - p);
+    } else if (kind == 1) {
+        if (k > p / 2.) return 0.;
+        f *= p;
+        if (k < 20.) f *= 1. + exp(-k);
+        if (k > p - 20.) f *= 1. + exp(k - p);
+    } else if (kind == 2) {
+        if (k > p / 2.) return 0.;
+        f *= k * (p - k) / p;
+        if (k < 20.) f *= 1. - exp(-k);
+        if (k > p - 20.) f *= 1. - exp(k - p);
+    } else {
+        f *= k;
+        if (k > p - 20.) f *= 1. + exp(k - p);
+    }
+    return f;
+}
+
+// writes a radgamma file with the layout expected by readRadiativeRate
+void WriteRadgamma(std::string filename) {
+    FILE *out = fopen(filename.c_str(), "wb");
+    ASSERT_TRUE(out != NULL);
+    double header_d[4] = {0., 0., 0., 0.};
+    int header_i[5] = {3, 3, 0, 0, 1};
+    fwrite(header_d, sizeof(double), 4, out);
+    fwrite(header_i, sizeof(int), 5, out);
+
+    // the kinds are stored as qqg, gqq, ggg, qqgamma, each followed by tau
+    std::vector<double> table(NP * NK), tau(NP * NK, 0.);
+    const int kinds[4] = {0, 1, 2, 3};
+    for (int kind : kinds) {
+        for (int n_p = 0; n_p < NP; n_p++) {
+            double p = 4.01 * exp(n_p / 24.7743737154026);
+            for (int n_k = 0; n_k < NK; n_k++) {
+                double dkdb;
+                double k = Martini::kFromIndex(p, n_k, dkdb);
+                table[n_p * NK + n_k] = TableEntry(kind, p, k);
+            }
+        }
+        fwrite(table.data(), sizeof(double), NP * NK, out);
+        fwrite(tau.data(), sizeof(double), NP * NK, out);
+    }
+    fclose(out);
+}
+
+class MartiniWithTables : public Martini {
+public:
+    MartiniWithTables(std::string path, int tabulate) {
+        PathToTables = path;
+        tabulate_radiation = tabulate;
+        loadRadiativeRate();
+        SetMt19937Generator(std::make_shared<std::mt19937>(20181002));
+    }
+};
+
+// two-sample Kolmogorov-Smirnov distance
+double KSDistance(std::vector<double> a, std::vector<double> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    size_t i = 0, j = 0;
+    double d = 0.;
+    while (i < a.size() && j < b.size()) {
+        double x = std::min(a[i], b[j]);
+        while (i < a.size() && a[i] <= x) i++;
+        while (j < b.size() && b[j] <= x) j++;
+        d = std::max(d, std::abs(double(i) / a.size() - double(j) / b.size()));
+    }
+    return d;
+}
+
+// Kolmogorov-Smirnov distance to the distribution of the rate itself,
+// integrated on a fine logarithmic grid in |k|
+double KSDistanceToRate(std::vector<double> a, Martini &martini, double u,
+                        int process, double yMin, double yMax) {
+    const int n = 200000;
+    double lo = std::max(std::abs(yMin), 1e-6), hi = std::abs(yMax);
+    if (yMax < 0) std::swap(lo, hi);
+    std::vector<double> y(n + 1), cdf(n + 1, 0.);
+    double previous = 0.;
+    for (int i = 0; i <= n; i++) {
+        y[i] = exp(log(lo) + (log(hi) - log(lo)) * i / n);
+        if (yMax < 0) y[i] = -y[i];
+        double rate = martini.function(u, y[i], process);
+        if (i > 0)
+            cdf[i] = cdf[i - 1] +
+                     0.5 * (rate + previous) * std::abs(y[i] - y[i - 1]);
+        previous = rate;
+    }
+    if (yMax < 0) {
+        // integrated from k = yMax downwards
+        for (auto &c : cdf) c = cdf[n] - c;
+        std::reverse(y.begin(), y.end());
+        std::reverse(cdf.begin(), cdf.end());
+    }
+
+    std::sort(a.begin(), a.end());
+    double d = 0.;
+    size_t j = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        while (j + 1 < y.size() && y[j + 1] <= a[i]) j++;
+        double c = cdf[j] / cdf[n];
+        d = std::max(d, std::abs(c - double(i) / a.size()));
+        d = std::max(d, std::abs(c - double(i + 1) / a.size()));
+    }
+    return d;
+}
+
+} // namespace
+
+// the tabulated sampler reproduces the distributions of the rejection method
+// and follows the tabulated rates
+TEST(MartiniRadiationTest, TEST_tabulated_sampling) {
+    WriteRadgamma("./radgamma");
+    // the rate tables make Martini too large for the stack
+    auto rejection = std::make_shared<MartiniWithTables>(".", 0);
+    auto tabulated = std::make_shared<MartiniWithTables>(".", 1);
+    std::remove("./radgamma");
+
+    const int nSamples = 20000;
+    // at this size, the KS distances of samples of the same distribution
+    // stay below these with 99.9% probability
+    const double maxDistance = 1.95 * sqrt(2. / nSamples);
+    const double maxDistanceToRate = 1.95 * sqrt(1. / nSamples);
+
+    const double us[3] = {7.3, 61.5, 412.};
+    const int processes[4] = {1, 2, 3, 4};
+    for (double u : us) {
+        for (int process : processes) {
+            for (int posNegSwitch = 0; posNegSwitch <= 1; posNegSwitch++) {
+                if (process == 2 && posNegSwitch == 0) continue;
+                std::vector<double> a(nSamples), b(nSamples);
+                for (int i = 0; i < nSamples; i++) {
+                    a[i] = rejection->sampleRadiativeRejection(u, process,
+                                                               posNegSwitch);
+                    b[i] = tabulated->sampleRadiativeTable(u, process,
+                                                           posNegSwitch);
+                }
+                double yMin, yMax;
+                tabulated->radiativeSupport(
+                    tabulated->radiativeBranch(process, posNegSwitch), u,
+                    yMin, yMax);
+                EXPECT_GE(*std::min_element(b.begin(), b.end()), yMin);
+                EXPECT_LE(*std::max_element(b.begin(), b.end()), yMax);
+                EXPECT_LT(KSDistanceToRate(b, *tabulated, u, process, yMin,
+                                           yMax),
+                          maxDistanceToRate)
+                    << "u = " << u << ", process = " << process
+                    << ", posNegSwitch = " << posNegSwitch;
+
+                // the envelope for g -> q qbar with k < 0 is sampled with a
+                // slightly different slope than it is evaluated with, so the
+                // rejection method is off by about 1% there
+                if (process == 4 && posNegSwitch == 0) continue;
+                EXPECT_LT(KSDistance(a, b), maxDistance)
+                    << "u = " << u << ", process = " << process
+                    << ", posNegSwitch = " << posNegSwitch;
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+#include "JetScapeParticleData.h"
+#include "JetScapeParticles.h"
+#include "JetScapePythiaPool.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Jetscape;
+
+// the table agrees with the Pythia particle data it was copied from
+TEST(ParticleDataTest, TEST_matches_pythia) {
+    const JetScapeParticleData &table = JetScapeParticleData::Instance();
+    Pythia8::ParticleData &pdt =
+        JetScapeParticleBase::InternalHelperPythia.particleData;
+
+    const int ids[] = {1, -2, 4, 21, 22, 11, -13, 111, 211, -211, 321,
+                       2212, -2212, 3122, 443, 5122};
+    for (int id : ids) {
+        ASSERT_TRUE(table.isParticle(id)) << "id = " << id;
+        EXPECT_DOUBLE_EQ(table.m0(id), pdt.m0(id)) << "id = " << id;
+        EXPECT_DOUBLE_EQ(table.charge(id), pdt.charge(id)) << "id = " << id;
+        EXPECT_EQ(table.isHadron(id), pdt.isHadron(id)) << "id = " << id;
+        EXPECT_EQ(table.isParton(id), pdt.isParton(id)) << "id = " << id;
+    }
+
+    // neutral particles without antiparticle are there only once
+    EXPECT_FALSE(table.isParticle(-111));
+    EXPECT_FALSE(table.isParticle(-21));
+
+    EXPECT_FALSE(table.isParticle(1234567));
+    EXPECT_EQ(table.m0(1234567), 0.);
+    EXPECT_FALSE(table.isHadron(1234567));
+}
+
+// hadrons of unknown type keep their mass and leave the table untouched
+TEST(ParticleDataTest, TEST_unknown_hadron) {
+    FourVector p(1., 0., 0., 2.), x(0., 0., 0., 0.);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.push_back(std::thread([&p, &x]() {
+            for (int j = 0; j < 100; j++) {
+                Hadron h(0, 9999999, 1, p, x, 1.5);
+                EXPECT_EQ(h.restmass(), 1.5);
+                Hadron pi(0, 211, 1, p, x, 0.13957);
+                EXPECT_EQ(pi.pid(), 211);
+            }
+        }));
+    }
+    for (auto &t : threads) t.join();
+    EXPECT_FALSE(JetScapeParticleData::Instance().isParticle(9999999));
+}
+
+// instances are leased by index, one user at a time, and never grow
+TEST(PythiaPoolTest, TEST_lease_by_index) {
+    JetScapePythiaPool pool;
+    pool.ReadString("ProcessLevel:all = off");
+    pool.ReadString("Print:quiet = on");
+    pool.ReadString("Random:setSeed = on");
+    pool.ReadString("Random:seed = 42");
+    pool.Init(2);
+    ASSERT_EQ(pool.GetNumberOfInstances(), 2u);
+
+    double first;
+    {
+        auto lease0 = pool.Acquire(0);
+        auto lease1 = pool.Acquire(1);
+        EXPECT_NE(&*lease0, &*lease1);
+        EXPECT_EQ(lease0->settings.mode("Random:seed"), 42);
+        EXPECT_EQ(lease1->settings.mode("Random:seed"), 43);
+        EXPECT_THROW(pool.Acquire(0), std::runtime_error);
+        EXPECT_THROW(pool.Acquire(2), std::out_of_range);
+        first = lease0->rndm.flat();
+    }
+    EXPECT_EQ(pool.GetNumberOfInstances(), 2u);
+
+    // given back, and the same instance for the same index
+    pool.Reseed(42);
+    auto lease0 = pool.Acquire(0);
+    EXPECT_EQ(lease0->rndm.flat(), first);
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "PartonShower.h"
+#include "ShowerArena.h"
+#include "JetClass.h"
+#include "gtest/gtest.h"
+
+using namespace Jetscape;
+
+// one parton splitting into n, stored by value in the arena
+static void FillShower(PartonShower &shower, int n) {
+    FourVector x0(0., 0., 0., 0.);
+    node v0 = shower.new_vertex(Vertex(0., 0., 0., 0.));
+    node v1 = shower.new_vertex(Vertex(0.1, 0.2, 0.3, 0.5));
+    shower.new_parton(v0, v1,
+                      Parton(0, 21, 0, FourVector(0., 0., 100., 100.), x0));
+    for (int i = 0; i < n; i++) {
+        node v = shower.new_vertex(Vertex(0., 0., 0., 1. + i));
+        double px = 1. + i;
+        shower.new_parton(v1, v, Parton(i + 1, 1, 0,
+                                        FourVector(px, 0., 10., 20.), x0));
+    }
+}
+
+// partons and vertices added by value are seen through the usual getters
+TEST(PartonShowerTest, TEST_ARENA_GETTERS){
+    auto shower = std::make_shared<PartonShower>();
+    FillShower(*shower, 500);
+
+    EXPECT_EQ(501, shower->GetNumberOfPartons());
+    EXPECT_EQ(502, shower->GetNumberOfVertices());
+    EXPECT_DOUBLE_EQ(0.5, shower->GetVertexAt(1)->x_in().t());
+    EXPECT_DOUBLE_EQ(100., shower->GetPartonAt(0)->e());
+    EXPECT_EQ(21, shower->GetParton(shower->GetEdgeAt(0))->pid());
+    EXPECT_EQ(1, shower->GetNumberOfParents(1));
+
+    auto final_partons = shower->GetFinalPartons();
+    ASSERT_EQ(500, final_partons.size());
+    for (int i = 0; i < 500; i++)
+        EXPECT_DOUBLE_EQ(1. + i, final_partons[i]->px());
+}
+
+// the storage is reused once nobody holds on to the shower's partons
+TEST(PartonShowerTest, TEST_ARENA_RECYCLING){
+    Parton *first;
+    {
+        PartonShower shower;
+        FillShower(shower, 10);
+        first = shower.GetPartonAt(0).get();
+    }
+    {
+        PartonShower shower;
+        FillShower(shower, 10);
+        EXPECT_EQ(first, shower.GetPartonAt(0).get());
+        shower.clear();
+        EXPECT_EQ(0, shower.GetNumberOfPartons());
+        FillShower(shower, 10);
+        EXPECT_EQ(first, shower.GetPartonAt(0).get());
+    }
+
+    // still referenced, so neither recycled nor destroyed
+    shared_ptr<Parton> kept;
+    {
+        PartonShower shower;
+        FillShower(shower, 10);
+        kept = shower.GetPartonAt(3);
+    }
+    {
+        PartonShower shower;
+        FillShower(shower, 10);
+        EXPECT_NE(kept.get(), shower.GetPartonAt(3).get());
+    }
+    EXPECT_DOUBLE_EQ(3., kept->px());
+}
+
+// every parton's source vertex comes before its target vertex
+static void CheckOrder(PartonShower &shower) {
+    auto &vertices = shower.GetOrderedVertices();
+    ASSERT_EQ(shower.GetNumberOfVertices(), vertices.size());
+    std::vector<int> position(vertices.size(), -1);
+    for (int i = 0; i < vertices.size(); i++) {
+        int index = shower.GetVertexIndex(vertices[i]);
+        ASSERT_GE(index, 0);
+        ASSERT_LT(index, vertices.size());
+        EXPECT_EQ(-1, position[index]);
+        position[index] = i;
+    }
+
+    auto &partons = shower.GetOrderedPartons();
+    ASSERT_EQ(shower.GetNumberOfPartons(), partons.size());
+    for (int i = 0; i < partons.size(); i++) {
+        EXPECT_EQ(i, shower.GetPartonIndex(partons[i]));
+        EXPECT_LT(position[shower.GetVertexIndex(partons[i].source())],
+                  position[shower.GetVertexIndex(partons[i].target())]);
+    }
+}
+
+TEST(PartonShowerTest, TEST_TOPOLOGICAL_ORDER){
+    FourVector x0(0., 0., 0., 0.);
+    Parton p(0, 21, 0, FourVector(0., 0., 10., 10.), x0);
+
+    PartonShower shower;
+    FillShower(shower, 3);
+    CheckOrder(shower);
+    EXPECT_EQ(shower.GetNodeAt(0), shower.GetOrderedVertices()[0]);
+
+    // a new root feeding an existing vertex, as for negative partons
+    node v2 = shower.GetNodeAt(2);
+    node root = shower.new_vertex(Vertex(0., 0., 0., 0.5));
+    shower.new_parton(root, v2, p);
+    CheckOrder(shower);
+
+    // a later vertex feeding an earlier one that isn't a root
+    node v5 = shower.new_vertex(Vertex(0., 0., 0., 2.));
+    shower.new_parton(v2, v5, p);
+    shower.new_parton(v5, shower.GetNodeAt(3), p);
+    CheckOrder(shower);
+
+    // and back to the creation order once cleared
+    shower.clear();
+    FillShower(shower, 3);
+    CheckOrder(shower);
+}
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeThreadPool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Jetscape;
+
+// every job runs exactly once, for several rounds on the same pool
+TEST(ThreadPoolTest, TEST_all_jobs_once) {
+    JetScapeThreadPool pool(4);
+    EXPECT_EQ(pool.GetNumberOfThreads(), 4u);
+
+    for (int round = 0; round < 20; round++) {
+        std::vector<std::atomic<int>> count(97);
+        for (auto &c : count) c = 0;
+        pool.RunAndWait(count.size(), [&count](int i) { count[i]++; });
+        for (auto &c : count) EXPECT_EQ(c.load(), 1);
+    }
+}
+
+// a failing job is reported to the caller, the pool stays usable
+TEST(ThreadPoolTest, TEST_exception) {
+    JetScapeThreadPool pool(3);
+    std::atomic<int> n(0);
+    EXPECT_THROW(pool.RunAndWait(10, [&n](int i) {
+                     n++;
+                     if (i == 5) throw std::runtime_error("job failed");
+                 }),
+                 std::runtime_error);
+    EXPECT_EQ(n.load(), 10);
+
+    n = 0;
+    pool.RunAndWait(10, [&n](int i) { n++; });
+    EXPECT_EQ(n.load(), 10);
+}
@@ -21,3 +21,7 @@ $curlcmd "https://bitbucket.org/sscao/lbt-tables-new/downloads/LBT-tables.tar.gz
 
 tar xvzf LBT-tables.tar.gz
 
+
+# Optionally convert the text tables once to the binary file LBT maps at
+# startup instead of parsing them: run ConvertLBTTables from the build
+# directory, where LBT-tables links to this directory.
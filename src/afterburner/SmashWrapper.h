@@ -77,6 +77,8 @@ public:
                                 std::vector<shared_ptr<Hadron>> &JS_hadrons);
   SmashWrapper();
   void InitTask();
+  // the random seed is built into the SMASH configuration in InitTask
+  bool InitInWorkers() const { return true; }
   void ExecuteTask();
   void WriteTask(weak_ptr<JetScapeWriter> w);
 };
@@ -16,11 +16,13 @@
 
 #include <iostream>
 #include <array>
+#include <sstream>
 #include "FluidDynamics.h"
 #include "LinearInterpolation.h"
 #include "JetScapeSignalManager.h"
 #include "MakeUniqueHelper.h"
 #include "SurfaceFinder.h"
+#include "HydroEventLibrary.h"
 
 #define MAGENTA "\033[35m"
 
@@ -59,12 +61,67 @@ void FluidDynamics::Init() {
     JSWARN << "No Pre-equilibrium module";
   }
 
+  ReadEvolutionStorage();
+  tinyxml2::XMLElement *library =
+      GetXMLElement({"Hydro", "evolutionLibraryOutput"}, false);
+  std::string library_name;
+  if (library && library->GetText()) {
+    std::istringstream library_text(library->GetText());
+    library_text >> library_name;
+  }
+  if (!library_name.empty()) {
+    evolution_library_writer =
+        std::make_shared<HydroEventLibraryWriter>(library_name);
+    JSINFO << "Evolution histories are added to " << library_name;
+  }
+
   InitializeHydro(parameter_list);
   InitTask();
 
   JetScapeTask::InitTasks();
 }
 
+void FluidDynamics::ReadEvolutionStorage() {
+  std::string storage;
+  std::istringstream storage_text(
+      GetXMLElementText({"Hydro", "evolutionStorage"}, false));
+  storage_text >> storage;
+  if (storage.empty() || storage == "cells") {
+    SetEvolutionStorage(0);
+    return;
+  }
+  if (storage != "float32" && storage != "float16") {
+    throw std::runtime_error("Hydro evolutionStorage must be cells, "
+                             "float32 or float16, not " + storage);
+  }
+
+  unsigned int mask = 0;
+  std::istringstream fields(
+      GetXMLElementText({"Hydro", "evolutionFields"}, false));
+  std::string name;
+  while (fields >> name) {
+    if (name == "all") {
+      mask = FIELD_MASK_ALL;
+      continue;
+    }
+    EntryName entry_name = ResolveEntryName(name);
+    if (entry_name == ENTRY_INVALID) {
+      throw std::runtime_error("Unknown entry " + name +
+                               " in Hydro evolutionFields");
+    }
+    mask |= FieldMask(entry_name);
+  }
+  if (mask == 0) {
+    mask = FIELD_MASK_ALL;
+  }
+  unsigned int half_mask = storage == "float16" ? FIELD_MASK_VISCOUS : 0;
+  SetEvolutionStorage(mask, half_mask);
+  JSINFO << "Evolution history stored as " << storage << ", "
+         << bulk_info.data_info.size() * sizeof(float) +
+                bulk_info.data_info_half.size() * sizeof(uint16_t)
+         << " bytes per cell";
+}
+
 void FluidDynamics::Exec() {
   VERBOSE(2) << "Run Hydro : " << GetId() << " ...";
   VERBOSE(8) << "Current Event #" << GetCurrentEvent();
@@ -75,6 +132,14 @@ void FluidDynamics::Exec() {
   }
 
   EvolveHydro();
+  // histories read from a library are already in one
+  if (evolution_library_writer && !bulk_info.HasExternalRecords() &&
+      bulk_info.get_data_size() > 0) {
+    int event = evolution_library_writer->Add(bulk_info);
+    JSINFO << "Evolution history added to "
+           << evolution_library_writer->GetFileName() << " as event "
+           << event;
+  }
   JetScapeTask::ExecuteTasks();
 }
 
@@ -97,6 +162,8 @@ void FluidDynamics::FindAConstantTemperatureSurface(
         Jetscape::real T_sw, std::vector<SurfaceCellInfo> &surface_cells) {
   std::unique_ptr<SurfaceFinder> surface_finder_ptr(
       new SurfaceFinder(T_sw, bulk_info));
+  surface_finder_ptr->set_number_of_threads(
+      GetXMLElementInt({"Hydro", "nSurfaceFinderThreads"}, false));
   surface_finder_ptr->Find_full_hypersurface();
   surface_cells = surface_finder_ptr->get_surface_cells_vector();
   JSINFO << "number of surface cells: " << surface_cells.size();
@@ -148,6 +215,16 @@ Jetscape::real FluidDynamics::GetQgpFraction(Jetscape::real time,
   return (qgp_fraction);
 }
 
+void FluidDynamics::GetHydroCells(FluidCellBatch &cells) {
+  cells.prepare_output();
+  std::unique_ptr<FluidCellInfo> fluid_cell_ptr;
+  for (int i = 0; i < cells.size(); i++) {
+    GetHydroCell(cells.t[i], cells.x[i], cells.y[i], cells.z[i],
+                 fluid_cell_ptr);
+    cells.set(i, *fluid_cell_ptr);
+  }
+}
+
 void FluidDynamics::get_source_term(Jetscape::real tau, Jetscape::real x,
                                     Jetscape::real y, Jetscape::real eta,
                                     std::array<Jetscape::real, 4> jmu) const {
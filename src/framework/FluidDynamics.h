@@ -40,6 +40,48 @@ namespace Jetscape {
 /// Flags for hydrodynamics status.
 enum HydroStatus { NOT_START, INITIALIZED, EVOLVING, FINISHED, ERROR };
 
+class FluidDynamics;
+class HydroEventLibraryWriter;
+
+/** Direct access to the medium for energy loss modules, handed out by
+    FluidDynamics::GetMediumHandle() when the modules are connected. Unlike
+    GetHydroCellSignal it takes no lock and fills the cell in place. If the
+    hydro keeps its evolution in an EvolutionHistory the handle interpolates
+    it without any virtual call, otherwise it calls
+    FluidDynamics::FillHydroCell(). As long as the hydro is not FINISHED or
+    the history is empty it also calls FillHydroCell(), so that the hydro
+    reports the error the same way GetHydroCell() does.
+  */
+class MediumHandle {
+public:
+  MediumHandle() : hydro_(nullptr), history_(nullptr) {}
+  explicit MediumHandle(FluidDynamics *hydro,
+                        const EvolutionHistory *history = nullptr)
+      : hydro_(hydro), history_(history) {}
+
+  /** @return Whether the handle points to a hydro module. */
+  bool IsValid() const { return hydro_ != nullptr; }
+
+  /** Fills the fluid cell at (t, x, y, z), same as
+      FluidDynamics::GetHydroCell().
+    */
+  inline void GetCell(double t, double x, double y, double z,
+                      FluidCellInfo &cell) const;
+
+  /** Same as above, reading the evolution history (if any) through
+      the caller's stencil cache.
+    */
+  inline void GetCell(double t, double x, double y, double z,
+                      FluidCellInfo &cell, FluidStencilCache &cache) const;
+
+private:
+  /** @return Whether the cells can be read from the history directly. */
+  inline bool HistoryReady() const;
+
+  FluidDynamics *hydro_;
+  const EvolutionHistory *history_;
+};
+
 /** A helper class for hydro parameters file name.*/
 class Parameter {
 public:
@@ -73,6 +115,15 @@ protected:
 
   std::weak_ptr<LiquefierBase> liquefier_ptr;
 
+  /** Sets up bulk_info from <Hydro><evolutionStorage> and
+      <evolutionFields>, see SetEvolutionStorage(). */
+  void ReadEvolutionStorage();
+
+  /** If <Hydro><evolutionLibraryOutput> names a file, every evolution
+      history left in bulk_info by EvolveHydro() is added to that
+      HydroEventLibrary. */
+  std::shared_ptr<HydroEventLibraryWriter> evolution_library_writer;
+
 public:
   /** Default constructor. task ID as "FluidDynamics",  
         eta is initialized to -99.99.
@@ -133,6 +184,34 @@ public:
     GetHydroInfo(t, x, y, z, fCell);
   }
 
+  /** Batched version of GetHydroCell(). Fills cells.entry for all points
+      and all entries in cells.mask, see FluidCellBatch. The default calls
+      GetHydroCell() point by point, modules that keep their evolution in
+      bulk_info can override it with EvolutionHistory::get_batch(). The
+      shower does not call it, it reads one cell per parton and step.
+	@param cells Query points and, on return, the requested entries.
+    */
+  virtual void GetHydroCells(FluidCellBatch &cells);
+
+  /** GetHydroCell() without the allocation: fills cell in place. The
+      default goes through GetHydroCell(), modules that compute the cell
+      directly can override it.
+	@param cell Fluid cell at (t or tau, x, y, z or eta).
+    */
+  virtual void FillHydroCell(Jetscape::real t, Jetscape::real x,
+                             Jetscape::real y, Jetscape::real z,
+                             FluidCellInfo &cell) {
+    std::unique_ptr<FluidCellInfo> fluid_cell_ptr;
+    GetHydroCell(t, x, y, z, fluid_cell_ptr);
+    cell = *fluid_cell_ptr;
+  }
+
+  /** @return Handle for direct medium queries, see MediumHandle. Modules
+      whose GetHydroInfo() is EvolutionHistory::get_tz() on bulk_info
+      return a handle on bulk_info.
+    */
+  virtual MediumHandle GetMediumHandle() { return MediumHandle(this); }
+
   // currently we have no standard for passing configurations
   // pure virtual function; to be implemented by users
   // should make it easy to save evolution history to bulk_info
@@ -146,9 +225,23 @@ public:
   /** @return Status of the hydrodynamics (NOT_START, INITIALIZED, EVOLVING, FINISHED, ERROR). */
   int GetHydroStatus() const { return (hydro_status); }
 
+  /** Declares which entries bulk_info keeps of the cells passed to
+      StoreHydroEvolutionHistory(), and which of them in half precision,
+      see EvolutionHistory::SetCompactLayout(). Init() sets it from
+      <Hydro><evolutionStorage> and <evolutionFields>; modules can call it
+      later, e.g. in InitializeHydro(), to keep only what they fill.
+	@param mask Entries to keep, 0 stores complete FluidCellInfo cells.
+	@param half_mask Entries stored in half precision.
+    */
+  void SetEvolutionStorage(unsigned int mask, unsigned int half_mask = 0) {
+    bulk_info.SetCompactLayout(mask, half_mask);
+  }
+
+  /** Appends a cell to bulk_info, in the layout set up by
+      SetEvolutionStorage(). */
   void StoreHydroEvolutionHistory(
       std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
-    bulk_info.data.push_back(*fluid_cell_info_ptr);
+    bulk_info.StoreCell(*fluid_cell_info_ptr);
   }
 
   void clear_up_evolution_data() { bulk_info.clear_up_evolution_data(); }
@@ -179,7 +272,7 @@ public:
   GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                Jetscape::real z,
                std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
-    if (hydro_status != FINISHED || bulk_info.data.size() == 0) {
+    if (hydro_status != FINISHED || bulk_info.get_data_size() == 0) {
       throw std::runtime_error("Hydro evolution is not finished "
                                "or EvolutionHistory is empty");
     }
@@ -297,6 +390,28 @@ public:
 
 }; // end class FluidDynamics
 
+inline bool MediumHandle::HistoryReady() const {
+  return history_ && hydro_->GetHydroStatus() == FINISHED &&
+         history_->get_data_size() > 0;
+}
+
+inline void MediumHandle::GetCell(double t, double x, double y, double z,
+                                  FluidCellInfo &cell) const {
+  if (HistoryReady())
+    cell = history_->get_tz(t, x, y, z);
+  else
+    hydro_->FillHydroCell(t, x, y, z, cell);
+}
+
+inline void MediumHandle::GetCell(double t, double x, double y, double z,
+                                  FluidCellInfo &cell,
+                                  FluidStencilCache &cache) const {
+  if (HistoryReady())
+    cell = cache.get_tz(*history_, t, x, y, z);
+  else
+    hydro_->FillHydroCell(t, x, y, z, cell);
+}
+
 } // end namespace Jetscape
 
 #endif // FLUIDDYNAMICS_H
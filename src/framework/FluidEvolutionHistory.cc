@@ -15,7 +15,8 @@
 // This is a general basic class for hydrodynamics
 
 #include <string>
-#include <MakeUniqueHelper.h>
+#include <atomic>
+#include <cstring>
 #include "FluidEvolutionHistory.h"
 #include "FluidCellInfo.h"
 #include "LinearInterpolation.h"
@@ -23,32 +24,24 @@
 
 namespace Jetscape {
 
+// names of the entries, in EntryName order
+static const char *const entry_names[ENTRY_INVALID] = {
+    "energy_density", "entropy_density", "temperature", "pressure",
+    "qgp_fraction",   "mu_b",            "mu_c",        "mu_s",
+    "vx",             "vy",              "vz",          "pi00",
+    "pi01",           "pi02",            "pi03",        "pi11",
+    "pi12",           "pi13",            "pi22",        "pi23",
+    "pi33",           "bulk_pi"};
+
 // convert the string type entry name to enum type EntryNames
 EntryName ResolveEntryName(std::string input) {
-  static const std::map<std::string, EntryName> optionStrings = {
-      {"energy_density", ENTRY_ENERGY_DENSITY},
-      {"entropy_density", ENTRY_ENTROPY_DENSITY},
-      {"temperature", ENTRY_TEMPERATURE},
-      {"pressure", ENTRY_PRESSURE},
-      {"qgp_fraction", ENTRY_QGP_FRACTION},
-      {"mu_b", ENTRY_MU_B},
-      {"mu_c", ENTRY_MU_C},
-      {"mu_s", ENTRY_MU_S},
-      {"vx", ENTRY_VX},
-      {"vy", ENTRY_VY},
-      {"vz", ENTRY_VZ},
-      {"pi00", ENTRY_PI00},
-      {"pi01", ENTRY_PI01},
-      {"pi02", ENTRY_PI02},
-      {"pi03", ENTRY_PI03},
-      {"pi11", ENTRY_PI11},
-      {"pi12", ENTRY_PI12},
-      {"pi13", ENTRY_PI13},
-      {"pi22", ENTRY_PI22},
-      {"pi23", ENTRY_PI23},
-      {"pi33", ENTRY_PI33},
-      {"bulk_pi", ENTRY_BULK_PI},
-  };
+  static const std::map<std::string, EntryName> optionStrings = [] {
+    std::map<std::string, EntryName> names;
+    for (int e = 0; e < ENTRY_INVALID; e++) {
+      names[entry_names[e]] = static_cast<EntryName>(e);
+    }
+    return names;
+  }();
   auto itr = optionStrings.find(input);
   if (itr != optionStrings.end()) {
     return itr->second;
@@ -57,6 +50,72 @@ EntryName ResolveEntryName(std::string input) {
   }
 }
 
+std::string GetEntryNameString(EntryName entry) {
+  if (entry < 0 || entry >= ENTRY_INVALID) {
+    return "";
+  }
+  return entry_names[entry];
+}
+
+uint16_t FloatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> 16) & 0x8000u;
+  uint32_t abs = bits & 0x7fffffffu;
+
+  if (abs >= 0x7f800000u) {
+    // inf stays inf, nan stays (quiet) nan
+    return sign | 0x7c00u | (abs > 0x7f800000u ? 0x200u : 0u);
+  }
+  if (abs >= 0x477ff000u) {
+    // rounds to more than 65504, the largest half
+    return sign | 0x7c00u;
+  }
+  if (abs < 0x38800000u) {
+    // below 2^-14, a subnormal half in units of 2^-24
+    if (abs < 0x33000000u) {
+      return sign;
+    }
+    uint32_t exponent = abs >> 23;
+    uint32_t mantissa = (abs & 0x7fffffu) | 0x800000u;
+    uint32_t shift = 126 - exponent;
+    uint32_t half = mantissa >> shift;
+    uint32_t rest = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (rest > halfway || (rest == halfway && (half & 1))) {
+      half++;
+    }
+    return sign | half;
+  }
+  // rebias the exponent from 127 to 15 and drop 13 mantissa bits; a carry
+  // out of the mantissa correctly moves on to the next exponent
+  uint32_t half = (abs - 0x38000000u) >> 13;
+  uint32_t rest = abs & 0x1fffu;
+  if (rest > 0x1000u || (rest == 0x1000u && (half & 1))) {
+    half++;
+  }
+  return sign | half;
+}
+
+float HalfToFloat(uint16_t value) {
+  uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+  uint32_t exponent = (value >> 10) & 0x1fu;
+  uint32_t mantissa = value & 0x3ffu;
+  uint32_t bits;
+  if (exponent == 0x1fu) {
+    bits = sign | 0x7f800000u | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else {
+    // zero or subnormal, exact in float
+    float magnitude = mantissa * (1.0f / 16777216.0f);
+    return sign ? -magnitude : magnitude;
+  }
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
 // It checks whether a space-time point (tau, x, y, eta) is inside evolution
 // history or outside.
 int EvolutionHistory::CheckInRange(Jetscape::real tau, Jetscape::real x,
@@ -99,6 +158,94 @@ int EvolutionHistory::CheckInRange(Jetscape::real tau, Jetscape::real x,
   return (status);
 }
 
+static void WarnInvalidEntryName() {
+  JSWARN << "The entry name in data_info_ must be one of the \
+                        energy_density, entropy_density, temperature, pressure, qgp_fraction, \
+                        mu_b, mu_c, mu_s, vx, vy, vz, pi00, pi01, pi02, pi03, pi11, pi12, \
+                        pi13, pi22, pi23, pi33, bulk_pi";
+}
+
+// store one entry of a data_vector record in the fluid cell
+static inline void SetFluidCellEntry(FluidCellInfo &fluid_cell,
+                                     EntryName entry_name, float entry_data) {
+  switch (entry_name) {
+  case ENTRY_ENERGY_DENSITY:
+    fluid_cell.energy_density = entry_data;
+    break;
+  case ENTRY_ENTROPY_DENSITY:
+    fluid_cell.entropy_density = entry_data;
+    break;
+  case ENTRY_TEMPERATURE:
+    fluid_cell.temperature = entry_data;
+    break;
+  case ENTRY_PRESSURE:
+    fluid_cell.pressure = entry_data;
+    break;
+  case ENTRY_QGP_FRACTION:
+    fluid_cell.qgp_fraction = entry_data;
+    break;
+  case ENTRY_MU_B:
+    fluid_cell.mu_B = entry_data;
+    break;
+  case ENTRY_MU_C:
+    fluid_cell.mu_C = entry_data;
+    break;
+  case ENTRY_MU_S:
+    fluid_cell.mu_S = entry_data;
+    break;
+  case ENTRY_VX:
+    fluid_cell.vx = entry_data;
+    break;
+  case ENTRY_VY:
+    fluid_cell.vy = entry_data;
+    break;
+  case ENTRY_VZ:
+    fluid_cell.vz = entry_data;
+    break;
+  case ENTRY_PI00:
+    fluid_cell.pi[0][0] = entry_data;
+    break;
+  case ENTRY_PI01:
+    fluid_cell.pi[0][1] = entry_data;
+    fluid_cell.pi[1][0] = entry_data;
+    break;
+  case ENTRY_PI02:
+    fluid_cell.pi[0][2] = entry_data;
+    fluid_cell.pi[2][0] = entry_data;
+    break;
+  case ENTRY_PI03:
+    fluid_cell.pi[0][3] = entry_data;
+    fluid_cell.pi[3][0] = entry_data;
+    break;
+  case ENTRY_PI11:
+    fluid_cell.pi[1][1] = entry_data;
+    break;
+  case ENTRY_PI12:
+    fluid_cell.pi[1][2] = entry_data;
+    fluid_cell.pi[2][1] = entry_data;
+    break;
+  case ENTRY_PI13:
+    fluid_cell.pi[1][3] = entry_data;
+    fluid_cell.pi[3][1] = entry_data;
+    break;
+  case ENTRY_PI22:
+    fluid_cell.pi[2][2] = entry_data;
+    break;
+  case ENTRY_PI23:
+    fluid_cell.pi[2][3] = entry_data;
+    fluid_cell.pi[3][2] = entry_data;
+    break;
+  case ENTRY_PI33:
+    fluid_cell.pi[3][3] = entry_data;
+    break;
+  case ENTRY_BULK_PI:
+    fluid_cell.bulk_Pi = entry_data;
+    break;
+  default:
+    break;
+  }
+}
+
 /** Construct evolution history given the bulk_data and the data_info */
 void EvolutionHistory::FromVector(const std::vector<float> &data_,
                                   const std::vector<std::string> &data_info_,
@@ -106,8 +253,11 @@ void EvolutionHistory::FromVector(const std::vector<float> &data_,
                                   float dx_, int nx_, float y_min_, float dy_,
                                   int ny_, float eta_min_, float deta_,
                                   int neta_, bool tau_eta_is_tz_) {
+  DropExternalRecords();
   data_vector = data_;
   data_info = data_info_;
+  data_vector_half.clear();
+  data_info_half.clear();
   tau_min = tau_min_;
   x_min = x_min_;
   y_min = y_min_;
@@ -121,6 +271,120 @@ void EvolutionHistory::FromVector(const std::vector<float> &data_,
   neta = neta_;
   tau_eta_is_tz = tau_eta_is_tz_;
   ntau = data_.size() / (data_info_.size() * nx * ny * neta);
+  CompileDataLayout();
+}
+
+unsigned long EvolutionHistory::NextEpoch() {
+  static std::atomic<unsigned long> next_epoch(1);
+  return next_epoch++;
+}
+
+static std::vector<EntryName>
+ResolveEntryNames(const std::vector<std::string> &names) {
+  std::vector<EntryName> layout;
+  for (const auto &name : names) {
+    auto entry_name = ResolveEntryName(name);
+    if (entry_name == ENTRY_INVALID) {
+      WarnInvalidEntryName();
+    }
+    layout.push_back(entry_name);
+  }
+  return layout;
+}
+
+/** Resolve the entry names once, GetFluidCell only uses data_layout */
+void EvolutionHistory::CompileDataLayout() {
+  epoch = NextEpoch();
+  data_layout = ResolveEntryNames(data_info);
+  data_layout_half = ResolveEntryNames(data_info_half);
+}
+
+void EvolutionHistory::SetCompactLayout(unsigned int mask,
+                                        unsigned int half_mask) {
+  DropExternalRecords();
+  data.clear();
+  data_vector.clear();
+  data_vector_half.clear();
+  data_info.clear();
+  data_info_half.clear();
+  for (int e = 0; e < ENTRY_INVALID; e++) {
+    EntryName entry_name = static_cast<EntryName>(e);
+    if (!(mask & FieldMask(entry_name))) {
+      continue;
+    }
+    if (half_mask & FieldMask(entry_name)) {
+      data_info_half.push_back(GetEntryNameString(entry_name));
+    } else {
+      data_info.push_back(GetEntryNameString(entry_name));
+    }
+  }
+  CompileDataLayout();
+}
+
+void EvolutionHistory::StoreCell(const FluidCellInfo &cell) {
+  if (external_storage) {
+    throw std::runtime_error(
+        "EvolutionHistory: cannot store cells next to external records");
+  }
+  if (data_info.empty() && data_info_half.empty()) {
+    data.push_back(cell);
+    return;
+  }
+  if (data_layout.size() != data_info.size() ||
+      data_layout_half.size() != data_info_half.size()) {
+    CompileDataLayout();
+  }
+  for (auto entry_name : data_layout) {
+    data_vector.push_back(GetFluidCellEntry(cell, entry_name));
+  }
+  for (auto entry_name : data_layout_half) {
+    data_vector_half.push_back(
+        FloatToHalf(GetFluidCellEntry(cell, entry_name)));
+  }
+}
+
+void EvolutionHistory::ReserveCells(int n_cells) {
+  if (data_info.empty() && data_info_half.empty()) {
+    data.reserve(n_cells);
+    return;
+  }
+  data_vector.reserve(static_cast<size_t>(n_cells) * data_info.size());
+  data_vector_half.reserve(static_cast<size_t>(n_cells) *
+                           data_info_half.size());
+}
+
+int EvolutionHistory::get_data_size() const {
+  if (!data_info.empty()) {
+    return (GetRecordsSize() / data_info.size());
+  }
+  if (!data_info_half.empty()) {
+    return (GetHalfRecordsSize() / data_info_half.size());
+  }
+  return (data.size());
+}
+
+void EvolutionHistory::SetExternalRecords(std::shared_ptr<const void> storage,
+                                          const float *records,
+                                          size_t n_floats,
+                                          const uint16_t *half_records,
+                                          size_t n_halves) {
+  data.clear();
+  data_vector.clear();
+  data_vector_half.clear();
+  external_storage = storage;
+  external_records = records;
+  n_external_records = n_floats;
+  external_half_records = half_records;
+  n_external_half_records = n_halves;
+  epoch = NextEpoch();
+}
+
+void EvolutionHistory::DropExternalRecords() {
+  external_storage.reset();
+  external_records = nullptr;
+  n_external_records = 0;
+  external_half_records = nullptr;
+  n_external_half_records = 0;
 }
 
 /* This function will read the sparse data stored in data_ with associated 
@@ -128,6 +392,7 @@ void EvolutionHistory::FromVector(const std::vector<float> &data_,
 FluidCellInfo EvolutionHistory::GetFluidCell(int id_tau, int id_x, int id_y,
                                              int id_eta) const {
   int entries_per_record = data_info.size();
+  int half_entries_per_record = data_info_half.size();
   int id_eta_corrected = id_eta;
   // set id_eta=0 if hydro is in 2+1D mode
   if (neta == 0 || neta == 1) {
@@ -138,99 +403,49 @@ FluidCellInfo EvolutionHistory::GetFluidCell(int id_tau, int id_x, int id_y,
 
   // if data_vector and data_info are not used to construct evolution history
   // then the data should have the format of vector<FluidCellInfo>.
-  if (entries_per_record == 0) {
+  if (entries_per_record == 0 && half_entries_per_record == 0) {
     return data.at(record_starting_id);
   }
   // otherwise construct the fluid cell info from data_vector and data_info
-  auto fluid_cell_ptr = make_unique<FluidCellInfo>();
+  FluidCellInfo fluid_cell;
+
+  if (half_entries_per_record > 0) {
+    int half_starting_id = record_starting_id * half_entries_per_record;
+    if (half_starting_id + half_entries_per_record > GetHalfRecordsSize()) {
+      throw std::out_of_range("EvolutionHistory: cell outside data_vector_half");
+    }
+    bool compiled = data_layout_half.size() == data_info_half.size();
+    const uint16_t *record = GetHalfRecords() + half_starting_id;
+    for (int i = 0; i < half_entries_per_record; i++) {
+      auto entry_name = compiled ? data_layout_half[i]
+                                 : ResolveEntryName(data_info_half[i]);
+      SetFluidCellEntry(fluid_cell, entry_name, HalfToFloat(record[i]));
+    }
+  }
 
   record_starting_id *= entries_per_record;
-  for (int i = 0; i < entries_per_record; i++) {
-    auto entry_name = ResolveEntryName(data_info.at(i));
-    auto entry_data = data_vector.at(record_starting_id + i);
-    switch (entry_name) {
-    case ENTRY_ENERGY_DENSITY:
-      fluid_cell_ptr->energy_density = entry_data;
-      break;
-    case ENTRY_ENTROPY_DENSITY:
-      fluid_cell_ptr->entropy_density = entry_data;
-      break;
-    case ENTRY_TEMPERATURE:
-      fluid_cell_ptr->temperature = entry_data;
-      break;
-    case ENTRY_PRESSURE:
-      fluid_cell_ptr->pressure = entry_data;
-      break;
-    case ENTRY_QGP_FRACTION:
-      fluid_cell_ptr->qgp_fraction = entry_data;
-      break;
-    case ENTRY_MU_B:
-      fluid_cell_ptr->mu_B = entry_data;
-      break;
-    case ENTRY_MU_C:
-      fluid_cell_ptr->mu_C = entry_data;
-      break;
-    case ENTRY_MU_S:
-      fluid_cell_ptr->mu_S = entry_data;
-      break;
-    case ENTRY_VX:
-      fluid_cell_ptr->vx = entry_data;
-      break;
-    case ENTRY_VY:
-      fluid_cell_ptr->vy = entry_data;
-      break;
-    case ENTRY_VZ:
-      fluid_cell_ptr->vz = entry_data;
-      break;
-    case ENTRY_PI00:
-      fluid_cell_ptr->pi[0][0] = entry_data;
-      break;
-    case ENTRY_PI01:
-      fluid_cell_ptr->pi[0][1] = entry_data;
-      fluid_cell_ptr->pi[1][0] = entry_data;
-      break;
-    case ENTRY_PI02:
-      fluid_cell_ptr->pi[0][2] = entry_data;
-      fluid_cell_ptr->pi[2][0] = entry_data;
-      break;
-    case ENTRY_PI03:
-      fluid_cell_ptr->pi[0][3] = entry_data;
-      fluid_cell_ptr->pi[3][0] = entry_data;
-      break;
-    case ENTRY_PI11:
-      fluid_cell_ptr->pi[1][1] = entry_data;
-      break;
-    case ENTRY_PI12:
-      fluid_cell_ptr->pi[1][2] = entry_data;
-      fluid_cell_ptr->pi[2][1] = entry_data;
-      break;
-    case ENTRY_PI13:
-      fluid_cell_ptr->pi[1][3] = entry_data;
-      fluid_cell_ptr->pi[3][1] = entry_data;
-      break;
-    case ENTRY_PI22:
-      fluid_cell_ptr->pi[2][2] = entry_data;
-      break;
-    case ENTRY_PI23:
-      fluid_cell_ptr->pi[2][3] = entry_data;
-      fluid_cell_ptr->pi[3][2] = entry_data;
-      break;
-    case ENTRY_PI33:
-      fluid_cell_ptr->pi[3][3] = entry_data;
-      break;
-    case ENTRY_BULK_PI:
-      fluid_cell_ptr->bulk_Pi = entry_data;
-      break;
-    default:
-      JSWARN << "The entry name in data_info_ must be one of the \
-                        energy_density, entropy_density, temperature, pressure, qgp_fraction, \
-                        mu_b, mu_c, mu_s, vx, vy, vz, pi00, pi01, pi02, pi03, pi11, pi12, \
-                        pi13, pi22, pi23, pi33, bulk_pi";
-      break;
+  if (entries_per_record == 0) {
+    return fluid_cell;
+  }
+  if (record_starting_id + entries_per_record > GetRecordsSize()) {
+    throw std::out_of_range("EvolutionHistory: cell outside data_vector");
+  }
+  const float *record = GetRecords() + record_starting_id;
+  if (data_layout.size() == data_info.size()) {
+    for (int i = 0; i < entries_per_record; i++) {
+      SetFluidCellEntry(fluid_cell, data_layout[i], record[i]);
+    }
+  } else {
+    for (int i = 0; i < entries_per_record; i++) {
+      auto entry_name = ResolveEntryName(data_info.at(i));
+      if (entry_name == ENTRY_INVALID) {
+        WarnInvalidEntryName();
+      }
+      SetFluidCellEntry(fluid_cell, entry_name, record[i]);
     }
   }
 
-  return *fluid_cell_ptr;
+  return fluid_cell;
 }
 
 /** For one given time step id_tau,
@@ -270,24 +485,21 @@ FluidCellInfo EvolutionHistory::GetAtTimeStep(int id_tau, Jetscape::real x,
 FluidCellInfo EvolutionHistory::get(Jetscape::real tau, Jetscape::real x,
                                     Jetscape::real y,
                                     Jetscape::real eta) const {
-  int status = CheckInRange(tau, x, y, eta);
-  if (status == 0) {
+  int id[4];
+  if (!GetStencilIndex(tau, x, y, eta, id)) {
     FluidCellInfo zero_cell;
     return (zero_cell);
   }
-  int id_tau = GetIdTau(tau);
-  auto tau0 = TauCoord(id_tau);
-  auto tau1 = TauCoord(id_tau + 1);
-  auto bulk0 = GetAtTimeStep(id_tau, x, y, eta);
-  auto bulk1 = GetAtTimeStep(id_tau + 1, x, y, eta);
-  return (LinearInt(tau0, tau1, bulk0, bulk1, tau));
+  FluidCellInfo stencil[16];
+  GetStencil(id, stencil);
+  return InterpolateStencil(id, stencil, tau, x, y, eta);
 }
 
-FluidCellInfo EvolutionHistory::get_tz(Jetscape::real t, Jetscape::real x,
-                                       Jetscape::real y,
-                                       Jetscape::real z) const {
-  Jetscape::real tau = 0.0;
-  Jetscape::real eta = 0.0;
+// (t, z) -> (tau, eta), shared by get_tz() and FluidStencilCache::get_tz()
+static void LightConeCoordinates(Jetscape::real t, Jetscape::real z,
+                                 Jetscape::real &tau, Jetscape::real &eta) {
+  tau = 0.0;
+  eta = 0.0;
   if (t * t > z * z) {
     tau = sqrt(t * t - z * z);
     eta = 0.5 * log((t + z) / (t - z));
@@ -295,7 +507,345 @@ FluidCellInfo EvolutionHistory::get_tz(Jetscape::real t, Jetscape::real x,
     JSWARN << "the quest point is outside the light cone! "
            << "t = " << t << ", z = " << z;
   }
+}
+
+FluidCellInfo EvolutionHistory::get_tz(Jetscape::real t, Jetscape::real x,
+                                       Jetscape::real y,
+                                       Jetscape::real z) const {
+  Jetscape::real tau, eta;
+  LightConeCoordinates(t, z, tau, eta);
   return (get(tau, x, y, eta));
 }
 
+bool EvolutionHistory::GetStencilIndex(Jetscape::real tau, Jetscape::real x,
+                                       Jetscape::real y, Jetscape::real eta,
+                                       int *id) const {
+  if (CheckInRange(tau, x, y, eta) == 0)
+    return false;
+  id[0] = GetIdTau(tau);
+  id[1] = GetIdX(x);
+  id[2] = GetIdY(y);
+  id[3] = boost_invariant ? 0 : GetIdEta(eta);
+  return true;
+}
+
+// same cells, in the same order, as two GetAtTimeStep() calls
+void EvolutionHistory::GetStencil(const int *id, FluidCellInfo *stencil) const {
+  for (int i = 0; i < 16; i++) {
+    stencil[i] = GetFluidCell(id[0] + (i >> 3), id[1] + ((i >> 2) & 1),
+                              id[2] + ((i >> 1) & 1), id[3] + (i & 1));
+  }
+}
+
+FluidCellInfo EvolutionHistory::InterpolateStencil(
+    const int *id, const FluidCellInfo *stencil, Jetscape::real tau,
+    Jetscape::real x, Jetscape::real y, Jetscape::real eta) const {
+  real x0 = XCoord(id[1]);
+  real x1 = XCoord(id[1] + 1);
+  real y0 = YCoord(id[2]);
+  real y1 = YCoord(id[2] + 1);
+  real eta0 = EtaCoord(id[3]);
+  auto eta1 = 0.0;
+  if (!boost_invariant)
+    eta1 = EtaCoord(id[3] + 1);
+
+  FluidCellInfo bulk[2];
+  for (int i = 0; i < 2; i++) {
+    const FluidCellInfo *c = stencil + 8 * i;
+    bulk[i] = TrilinearInt(x0, x1, y0, y1, eta0, eta1, c[0], c[1], c[2], c[3],
+                           c[4], c[5], c[6], c[7], x, y, eta);
+  }
+  auto tau0 = TauCoord(id[0]);
+  auto tau1 = TauCoord(id[0] + 1);
+  return (LinearInt(tau0, tau1, bulk[0], bulk[1], tau));
+}
+
+FluidStencilCache::FluidStencilCache(int size_) : size(1) {
+  while (size < size_)
+    size *= 2;
+}
+
+FluidCellInfo FluidStencilCache::get(const EvolutionHistory &history,
+                                     Jetscape::real tau, Jetscape::real x,
+                                     Jetscape::real y, Jetscape::real eta) {
+  int id[4];
+  if (!history.GetStencilIndex(tau, x, y, eta, id)) {
+    FluidCellInfo zero_cell;
+    return (zero_cell);
+  }
+
+  if (entries.empty())
+    entries.resize(size);
+  // consecutive cells land in consecutive slots
+  Entry &entry =
+      entries[history.CellIndex(id[0], id[1], id[2], id[3]) & (size - 1)];
+  if (entry.epoch == history.GetEpoch() && entry.id[0] == id[0] &&
+      entry.id[1] == id[1] && entry.id[2] == id[2] && entry.id[3] == id[3]) {
+    hits++;
+  } else {
+    misses++;
+    // don't leave a half-filled entry behind if reading the cells throws
+    entry.epoch = 0;
+    history.GetStencil(id, entry.stencil);
+    entry.epoch = history.GetEpoch();
+    for (int i = 0; i < 4; i++)
+      entry.id[i] = id[i];
+  }
+  return history.InterpolateStencil(id, entry.stencil, tau, x, y, eta);
+}
+
+FluidCellInfo FluidStencilCache::get_tz(const EvolutionHistory &history,
+                                        Jetscape::real t, Jetscape::real x,
+                                        Jetscape::real y, Jetscape::real z) {
+  Jetscape::real tau, eta;
+  LightConeCoordinates(t, z, tau, eta);
+  return (get(history, tau, x, y, eta));
+}
+
+Jetscape::real GetFluidCellEntry(const FluidCellInfo &cell, EntryName e) {
+  switch (e) {
+  case ENTRY_ENERGY_DENSITY:
+    return cell.energy_density;
+  case ENTRY_ENTROPY_DENSITY:
+    return cell.entropy_density;
+  case ENTRY_TEMPERATURE:
+    return cell.temperature;
+  case ENTRY_PRESSURE:
+    return cell.pressure;
+  case ENTRY_QGP_FRACTION:
+    return cell.qgp_fraction;
+  case ENTRY_MU_B:
+    return cell.mu_B;
+  case ENTRY_MU_C:
+    return cell.mu_C;
+  case ENTRY_MU_S:
+    return cell.mu_S;
+  case ENTRY_VX:
+    return cell.vx;
+  case ENTRY_VY:
+    return cell.vy;
+  case ENTRY_VZ:
+    return cell.vz;
+  case ENTRY_PI00:
+    return cell.pi[0][0];
+  case ENTRY_PI01:
+    return cell.pi[0][1];
+  case ENTRY_PI02:
+    return cell.pi[0][2];
+  case ENTRY_PI03:
+    return cell.pi[0][3];
+  case ENTRY_PI11:
+    return cell.pi[1][1];
+  case ENTRY_PI12:
+    return cell.pi[1][2];
+  case ENTRY_PI13:
+    return cell.pi[1][3];
+  case ENTRY_PI22:
+    return cell.pi[2][2];
+  case ENTRY_PI23:
+    return cell.pi[2][3];
+  case ENTRY_PI33:
+    return cell.pi[3][3];
+  case ENTRY_BULK_PI:
+    return cell.bulk_Pi;
+  default:
+    return 0.0;
+  }
+}
+
+void FluidCellBatch::set(int i, const FluidCellInfo &cell) {
+  for (int e = 0; e < ENTRY_INVALID; e++) {
+    if (has(static_cast<EntryName>(e))) {
+      entry[e][i] = GetFluidCellEntry(cell, static_cast<EntryName>(e));
+    }
+  }
+}
+
+void EvolutionHistory::get_batch(FluidCellBatch &cells) const {
+  InterpolateBatch(cells, cells.t.data(), cells.z.data());
+}
+
+void EvolutionHistory::get_tz_batch(FluidCellBatch &cells) const {
+  int n = cells.size();
+  cells.tau_.resize(n);
+  cells.eta_.resize(n);
+  for (int i = 0; i < n; i++) {
+    Jetscape::real t = cells.t[i];
+    Jetscape::real z = cells.z[i];
+    Jetscape::real tau = 0.0;
+    Jetscape::real eta = 0.0;
+    if (t * t > z * z) {
+      tau = sqrt(t * t - z * z);
+      eta = 0.5 * log((t + z) / (t - z));
+    } else {
+      JSWARN << "the quest point is outside the light cone! "
+             << "t = " << t << ", z = " << z;
+    }
+    cells.tau_[i] = tau;
+    cells.eta_[i] = eta;
+  }
+  InterpolateBatch(cells, cells.tau_.data(), cells.eta_.data());
+}
+
+// Same arithmetic as get(), i.e. GetAtTimeStep() with TrilinearInt() and
+// then LinearInt() in tau, but done entry by entry on plain arrays. Points
+// where TrilinearInt() would take one of its lower dimensional branches,
+// or that are outside of the stored cells, go through get() itself.
+void EvolutionHistory::InterpolateBatch(FluidCellBatch &cells,
+                                        const Jetscape::real *tau,
+                                        const Jetscape::real *eta) const {
+  enum { OUTSIDE = 0, FAST = 1, SINGLE = 2 };
+
+  int n = cells.size();
+  cells.prepare_output();
+  cells.w_.resize(8 * n);
+  cells.rec_.resize(16 * n);
+  cells.a_.resize(n);
+  cells.b_.resize(n);
+  cells.inv_.resize(n);
+  cells.status_.resize(n);
+
+  int entries_per_record = data_info.size();
+  int half_entries_per_record = data_info_half.size();
+  bool compact = entries_per_record > 0 || half_entries_per_record > 0;
+  int n_records = get_data_size();
+  if (entries_per_record > 0 && half_entries_per_record > 0) {
+    n_records = std::min<int>(n_records, GetHalfRecordsSize() /
+                                             half_entries_per_record);
+  }
+
+  // First pass: corner records and weights of every point
+  for (int i = 0; i < n; i++) {
+    Jetscape::real x = cells.x[i];
+    Jetscape::real y = cells.y[i];
+    if (CheckInRange(tau[i], x, y, eta[i]) == 0) {
+      cells.status_[i] = OUTSIDE;
+      continue;
+    }
+
+    int id_tau = GetIdTau(tau[i]);
+    int id_x = GetIdX(x);
+    int id_y = GetIdY(y);
+    int id_eta = 0;
+    if (!boost_invariant)
+      id_eta = GetIdEta(eta[i]);
+
+    real x0 = XCoord(id_x);
+    real x1 = XCoord(id_x + 1);
+    real y0 = YCoord(id_y);
+    real y1 = YCoord(id_y + 1);
+    real eta0 = EtaCoord(id_eta);
+    real eta1 = 0.0;
+    if (!boost_invariant)
+      eta1 = EtaCoord(id_eta + 1);
+
+    real t = (x - x0) / (x1 - x0);
+    real u = (y - y0) / (y1 - y0);
+    real v = (eta[i] - eta0) / (eta1 - eta0);
+    if (!std::isfinite(t) || !std::isfinite(u) || !std::isfinite(v)) {
+      cells.status_[i] = SINGLE;
+      continue;
+    }
+
+    real *w = &cells.w_[8 * i];
+    w[0] = (1 - t) * (1 - u) * (1 - v);
+    w[1] = (1 - t) * (1 - u) * v;
+    w[2] = (1 - t) * u * (1 - v);
+    w[3] = (1 - t) * u * v;
+    w[4] = t * (1 - u) * (1 - v);
+    w[5] = t * (1 - u) * v;
+    w[6] = t * u * (1 - v);
+    w[7] = t * u * v;
+
+    // set id_eta=0 if hydro is in 2+1D mode, as in GetFluidCell
+    int id_eta_cell = (neta == 0 || neta == 1) ? 0 : id_eta;
+    int *rec = &cells.rec_[16 * i];
+    bool stored = true;
+    for (int s = 0; s < 2; s++) {
+      for (int c = 0; c < 8; c++) {
+        int r = CellIndex(id_tau + s, id_x + (c >> 2), id_y + ((c >> 1) & 1),
+                          id_eta_cell + (c & 1));
+        rec[8 * s + c] = r;
+        stored = stored && r < n_records;
+      }
+    }
+    if (!stored) {
+      cells.status_[i] = SINGLE;
+      continue;
+    }
+
+    real tau0 = TauCoord(id_tau);
+    real tau1 = TauCoord(id_tau + 1);
+    cells.a_[i] = tau[i] - tau0;
+    cells.b_[i] = tau1 - tau[i];
+    cells.inv_[i] = 1.0 / (tau1 - tau0);
+    cells.status_[i] = FAST;
+  }
+
+  // Second pass: one loop over the points per requested entry
+  int offset[ENTRY_INVALID], half_offset[ENTRY_INVALID];
+  for (int e = 0; e < ENTRY_INVALID; e++) {
+    offset[e] = -1;
+    half_offset[e] = -1;
+  }
+  for (int k = 0; k < entries_per_record; k++) {
+    EntryName e = data_layout.size() == data_info.size()
+                      ? data_layout[k]
+                      : ResolveEntryName(data_info[k]);
+    if (e != ENTRY_INVALID)
+      offset[e] = k;
+  }
+  // as in GetFluidCell, a float entry wins over a half one of the same name
+  for (int k = 0; k < half_entries_per_record; k++) {
+    EntryName e = data_layout_half.size() == data_info_half.size()
+                      ? data_layout_half[k]
+                      : ResolveEntryName(data_info_half[k]);
+    if (e != ENTRY_INVALID && offset[e] < 0)
+      half_offset[e] = k;
+  }
+
+  for (int e = 0; e < ENTRY_INVALID; e++) {
+    EntryName entry_name = static_cast<EntryName>(e);
+    if (!cells.has(entry_name))
+      continue;
+    // entry not stored in the records, zero like in GetFluidCell
+    if (compact && offset[e] < 0 && half_offset[e] < 0)
+      continue;
+
+    Jetscape::real *out = cells.entry[e].data();
+    for (int i = 0; i < n; i++) {
+      if (cells.status_[i] != FAST)
+        continue;
+      const int *rec = &cells.rec_[16 * i];
+      const real *w = &cells.w_[8 * i];
+      real f[16];
+      if (offset[e] >= 0) {
+        const float *base = GetRecords() + offset[e];
+        for (int c = 0; c < 16; c++)
+          f[c] = base[rec[c] * entries_per_record];
+      } else if (half_offset[e] >= 0) {
+        const uint16_t *base = GetHalfRecords() + half_offset[e];
+        for (int c = 0; c < 16; c++)
+          f[c] = HalfToFloat(base[rec[c] * half_entries_per_record]);
+      } else {
+        for (int c = 0; c < 16; c++)
+          f[c] = GetFluidCellEntry(data[rec[c]], entry_name);
+      }
+      real s0 = w[0] * f[0];
+      real s1 = w[0] * f[8];
+      for (int c = 1; c < 8; c++) {
+        s0 = s0 + w[c] * f[c];
+        s1 = s1 + w[c] * f[8 + c];
+      }
+      real value = cells.a_[i] * s1 + cells.b_[i] * s0;
+      out[i] = value * cells.inv_[i];
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    if (cells.status_[i] == SINGLE)
+      cells.set(i, get(tau[i], cells.x[i], cells.y[i], eta[i]));
+  }
+}
+
 } // end namespace Jetscape
@@ -18,7 +18,9 @@
 #define EVOLUTIONHISTORY_H
 
 #include <vector>
+#include <memory>
 #include <stdexcept>
+#include <cstdint>
 #include "FluidCellInfo.h"
 #include "RealType.h"
 
@@ -68,6 +70,75 @@ enum EntryName {
 
 EntryName ResolveEntryName(std::string input);
 
+/** Inverse of ResolveEntryName(), "" for ENTRY_INVALID */
+std::string GetEntryNameString(EntryName entry);
+
+/** Bit of an entry in a field mask,
+    e.g. FieldMask(ENTRY_TEMPERATURE) | FieldMask(ENTRY_VX) */
+inline unsigned int FieldMask(EntryName entry) { return 1u << entry; }
+const unsigned int FIELD_MASK_ALL = (1u << ENTRY_INVALID) - 1;
+/** The ten independent components of pi and bulk_pi */
+const unsigned int FIELD_MASK_VISCOUS =
+    ((1u << (ENTRY_BULK_PI + 1)) - 1) & ~((1u << ENTRY_PI00) - 1);
+
+/** IEEE 754 half precision (binary16) conversion, rounding to nearest even.
+    Magnitudes above 65504 become infinite, below 6e-8 zero; in between the
+    relative precision is 2^-11 down to 6e-5 and worse below. */
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+
+/** A batched medium query in structure-of-arrays form.
+    Fill the points with add_point(), same coordinates as for a single
+    GetHydroCell() call, and set mask to the entries you need. After the
+    query entry[e][i] holds entry e at point i for all e in mask, entries
+    not in mask stay empty. ENTRY_PI01 stands for pi[0][1] = pi[1][0] etc.
+    Reusing one batch keeps all arrays allocated.
+    The batch only changes the memory layout and the loop order of the
+    interpolation, for callers that have many points at once (the surface
+    finder). The shower does not use it: JetEnergyLoss::DoShower() and the
+    eloss modules still query one cell per parton and step. */
+class FluidCellBatch {
+public:
+  std::vector<Jetscape::real> t, x, y, z;
+  unsigned int mask = FIELD_MASK_ALL;
+  std::vector<Jetscape::real> entry[ENTRY_INVALID];
+
+  void clear() {
+    t.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+  void add_point(Jetscape::real t_, Jetscape::real x_, Jetscape::real y_,
+                 Jetscape::real z_) {
+    t.push_back(t_);
+    x.push_back(x_);
+    y.push_back(y_);
+    z.push_back(z_);
+  }
+  int size() const { return t.size(); }
+  bool has(EntryName e) const { return (mask & FieldMask(e)) != 0; }
+
+  /** Sizes the requested outputs to the number of points, zero filled. */
+  void prepare_output() {
+    for (int e = 0; e < ENTRY_INVALID; e++) {
+      entry[e].assign(has(static_cast<EntryName>(e)) ? size() : 0, 0.0);
+    }
+  }
+
+  /** Copies the requested entries of one cell to point i. */
+  void set(int i, const FluidCellInfo &cell);
+
+  // Workspace of EvolutionHistory::get_batch, 16 corner records and
+  // 8 spatial weights per point
+  std::vector<Jetscape::real> tau_, eta_, w_, a_, b_, inv_;
+  std::vector<int> rec_;
+  std::vector<char> status_;
+};
+
+/** Entry e of a fluid cell, see FluidCellBatch */
+Jetscape::real GetFluidCellEntry(const FluidCellInfo &cell, EntryName e);
+
 class InvalidSpaceTimeRange : public std::invalid_argument {
   using std::invalid_argument::invalid_argument;
 };
@@ -106,6 +177,20 @@ public:
   /** Store the entry names of one record in the data array*/
   std::vector<std::string> data_info;
 
+  /** data_info resolved to EntryName once, so that reading a cell needs no
+     * string lookups. Filled by FromVector(); call CompileDataLayout() after
+     * changing data_info by hand. If it is out of date, cells are read
+     * through the (slow) name lookup. */
+  std::vector<EntryName> data_layout;
+
+  /** Entries kept in half precision, see SetCompactLayout(). Record i has
+     * its data_info entries at data_vector[i * data_info.size()] and its
+     * data_info_half entries at data_vector_half[i * data_info_half.size()],
+     * encoded with FloatToHalf(). */
+  std::vector<uint16_t> data_vector_half;
+  std::vector<std::string> data_info_half;
+  std::vector<EntryName> data_layout_half; //!< data_info_half resolved
+
   /** Default constructor. */
   EvolutionHistory() = default;
 
@@ -122,16 +207,91 @@ public:
                   float dy, int ny, float eta_min, float deta, int neta,
                   bool tau_eta_is_tz);
 
+  /** Resolves data_info and data_info_half into data_layout and
+     * data_layout_half. */
+  void CompileDataLayout();
+
+  /** Declares the records StoreCell() writes: the entries in mask, in
+     * EntryName order, as floats, those also in half_mask as half floats.
+     * A cell of a 3+1D history then takes 4 bytes per float entry and 2 per
+     * half entry instead of a whole FluidCellInfo, and get() and
+     * get_batch() read the records as they are. Entries not kept read as
+     * zero. mask = 0 goes back to storing FluidCellInfo in data. Drops all
+     * stored cells; the layout itself survives clear_up_evolution_data().
+	@param mask Entries to keep, e.g. FieldMask(ENTRY_TEMPERATURE) | ...
+	@param half_mask Entries among them stored in half precision, e.g.
+	FIELD_MASK_VISCOUS.
+    */
+  void SetCompactLayout(unsigned int mask, unsigned int half_mask = 0);
+
+  /** Appends one cell, in the layout set by SetCompactLayout() or as a
+     * FluidCellInfo in data if there is none. Cells go in the order of
+     * CellIndex(). */
+  void StoreCell(const FluidCellInfo &cell);
+
+  /** Reserves memory for n_cells calls of StoreCell(), so that filling the
+     * history does not briefly need twice its size. */
+  void ReserveCells(int n_cells);
+
+  /** Reads the records from memory the history does not own, e.g. a mapped
+     * HydroEventLibrary, instead of data_vector and data_vector_half. The
+     * layout is data_info and data_info_half as usual. storage keeps the
+     * memory alive for as long as the history (or a copy) uses it; the
+     * records are dropped again by clear_up_evolution_data(), FromVector()
+     * and SetCompactLayout(), and StoreCell() cannot append to them.
+	@param storage Owner of the records.
+	@param records Float entries, n_floats of them.
+	@param half_records Half precision entries, n_halves of them.
+    */
+  void SetExternalRecords(std::shared_ptr<const void> storage,
+                          const float *records, size_t n_floats,
+                          const uint16_t *half_records, size_t n_halves);
+
+  /** @return Whether the records are external, see SetExternalRecords(). */
+  bool HasExternalRecords() const { return external_storage != nullptr; }
+
+  /** The float records, wherever they are stored: data_vector or the
+     * external records. */
+  const float *GetRecords() const {
+    return external_storage ? external_records : data_vector.data();
+  }
+  size_t GetRecordsSize() const {
+    return external_storage ? n_external_records : data_vector.size();
+  }
+
+  /** Same for the half precision records. */
+  const uint16_t *GetHalfRecords() const {
+    return external_storage ? external_half_records : data_vector_half.data();
+  }
+  size_t GetHalfRecordsSize() const {
+    return external_storage ? n_external_half_records
+                            : data_vector_half.size();
+  }
+
   /** Default destructor. */
   ~EvolutionHistory() {
     data.clear();
     data_vector.clear();
     data_info.clear();
+    data_layout.clear();
+  }
+
+  /** Drops the stored cells, keeps the layout. */
+  void clear_up_evolution_data() {
+    data.clear();
+    data_vector.clear();
+    data_vector_half.clear();
+    DropExternalRecords();
+    epoch = NextEpoch();
   }
 
-  void clear_up_evolution_data() { data.clear(); }
+  /** Changes whenever the history is cleared or refilled through
+     * FromVector(), so that cached cells can be told apart from stale ones.
+     * Unique across all histories. */
+  unsigned long GetEpoch() const { return epoch; }
 
-  int get_data_size() const { return (data.size()); }
+  /** @return Number of stored cells, in whichever form they are stored. */
+  int get_data_size() const;
   bool is_boost_invariant() const { return (boost_invariant); }
 
   Jetscape::real Tau0() const { return (tau_min); }
@@ -256,6 +416,88 @@ public:
                     Jetscape::real etas) const;
   FluidCellInfo get_tz(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                        Jetscape::real z) const;
+
+  /** Lower corner of the cells get() interpolates between at
+     * (tau, x, y, eta). @return false if the point is outside the grid,
+     * where get() gives an empty cell. */
+  bool GetStencilIndex(Jetscape::real tau, Jetscape::real x, Jetscape::real y,
+                       Jetscape::real eta, int *id) const;
+
+  /** Reads the 16 cells next to the lower corner id = {id_tau, id_x, id_y,
+     * id_eta}; stencil[8 * i_tau + 4 * i_x + 2 * i_y + i_eta]. */
+  void GetStencil(const int *id, FluidCellInfo *stencil) const;
+
+  /** Interpolates a stencil from GetStencil() at (tau, x, y, eta).
+     * Gives the same numbers as get(). */
+  FluidCellInfo InterpolateStencil(const int *id, const FluidCellInfo *stencil,
+                                   Jetscape::real tau, Jetscape::real x,
+                                   Jetscape::real y, Jetscape::real eta) const;
+
+  /** Batched get(): points are (tau, x, y, eta). Only the entries in
+     * cells.mask are interpolated, each in one loop over all points.
+     * Gives the same numbers as get() for every point. */
+  void get_batch(FluidCellBatch &cells) const;
+
+  /** Batched get_tz(): points are (t, x, y, z). */
+  void get_tz_batch(FluidCellBatch &cells) const;
+
+private:
+  void InterpolateBatch(FluidCellBatch &cells, const Jetscape::real *tau,
+                        const Jetscape::real *eta) const;
+
+  void DropExternalRecords();
+
+  static unsigned long NextEpoch();
+  unsigned long epoch = NextEpoch();
+
+  std::shared_ptr<const void> external_storage;
+  const float *external_records = nullptr;
+  size_t n_external_records = 0;
+  const uint16_t *external_half_records = nullptr;
+  size_t n_external_half_records = 0;
+};
+
+/** A small cache of interpolation stencils in front of
+ * EvolutionHistory::get(). Partons of one shower, and the steps along one
+ * parton path, mostly interpolate within the same few cells, so most
+ * lookups skip the 16 cell reads. Entries are checked against the history's
+ * epoch, so the cache never has to be cleared between events.
+ * One cache per reader (e.g. per shower module); it is not thread safe,
+ * and copies start out empty. */
+class FluidStencilCache {
+public:
+  /** @param size Number of stencils kept, rounded up to a power of 2. */
+  explicit FluidStencilCache(int size = 32);
+  FluidStencilCache(const FluidStencilCache &other)
+      : FluidStencilCache(other.size) {}
+  FluidStencilCache &operator=(const FluidStencilCache &) {
+    Clear();
+    return *this;
+  }
+
+  /** Same as history.get(tau, x, y, eta). */
+  FluidCellInfo get(const EvolutionHistory &history, Jetscape::real tau,
+                    Jetscape::real x, Jetscape::real y, Jetscape::real eta);
+  /** Same as history.get_tz(t, x, y, z). */
+  FluidCellInfo get_tz(const EvolutionHistory &history, Jetscape::real t,
+                       Jetscape::real x, Jetscape::real y, Jetscape::real z);
+
+  void Clear() { entries.clear(); }
+
+  unsigned long GetHits() const { return hits; }
+  unsigned long GetMisses() const { return misses; }
+  void ResetCounters() { hits = misses = 0; }
+
+private:
+  struct Entry {
+    unsigned long epoch = 0;
+    int id[4];
+    FluidCellInfo stencil[16];
+  };
+
+  int size;
+  std::vector<Entry> entries; // allocated on first use
+  unsigned long hits = 0, misses = 0;
 };
 
 } // namespace Jetscape
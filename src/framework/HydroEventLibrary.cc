@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "HydroEventLibrary.h"
+#include "JetScapeLogger.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Jetscape {
+
+static uint64_t AlignUp(uint64_t offset, uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+static bool IsLibraryHeader(const HydroEventLibraryHeader &header) {
+  return std::memcmp(header.magic, HydroEventLibraryMagic, 8) == 0 &&
+         header.endian_marker == HydroEventLibraryEndianMarker &&
+         header.version == HydroEventLibraryVersion;
+}
+
+HydroEventLibrary::HydroEventLibrary(const std::string &file_name_)
+    : file_name(file_name_) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("HydroEventLibrary: cannot open " + file_name);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      size_t(st.st_size) < sizeof(HydroEventLibraryHeader)) {
+    close(fd);
+    throw std::runtime_error(file_name + " is not a hydro event library");
+  }
+  size_t size = st.st_size;
+  void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    throw std::runtime_error("HydroEventLibrary: cannot map " + file_name);
+  }
+  mapping = std::shared_ptr<const void>(map, [size](const void *p) {
+    munmap(const_cast<void *>(p), size);
+  });
+
+  const char *base = static_cast<const char *>(map);
+  HydroEventLibraryHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (!IsLibraryHeader(header)) {
+    throw std::runtime_error(file_name + " is not a hydro event library " +
+                             "of this version, or from another machine");
+  }
+
+  // A writer may have appended since the file was mapped, those events
+  // are left for the next reader
+  uint64_t offset =
+      AlignUp(sizeof(HydroEventLibraryHeader), HydroEventLibraryAlignment);
+  for (uint64_t i = 0; i < header.n_events; i++) {
+    if (offset + sizeof(HydroEventLibraryEntry) > size) {
+      break;
+    }
+    auto entry =
+        reinterpret_cast<const HydroEventLibraryEntry *>(base + offset);
+    if (entry->size < sizeof(HydroEventLibraryEntry) ||
+        offset + entry->size > size) {
+      break;
+    }
+    events.push_back(entry);
+    offset = AlignUp(offset + entry->size, HydroEventLibraryAlignment);
+  }
+  if (events.size() < header.n_events && header.end <= size) {
+    JSWARN << file_name << " is damaged, only " << events.size() << " of "
+           << header.n_events << " events can be read";
+  }
+  VERBOSE(2) << "Hydro event library " << file_name << " with "
+             << events.size() << " events";
+}
+
+const HydroEventLibraryEntry &HydroEventLibrary::GetEntry(int event) const {
+  if (event < 0 || event >= GetNumberOfEvents()) {
+    throw std::out_of_range("HydroEventLibrary: no event " +
+                            std::to_string(event) + " in " + file_name);
+  }
+  return *events[event];
+}
+
+void HydroEventLibrary::Load(int event, EvolutionHistory &history) const {
+  const HydroEventLibraryEntry &entry = GetEntry(event);
+  const char *start = reinterpret_cast<const char *>(&entry);
+  if (entry.n_entries > 32 || entry.n_half_entries > 32 ||
+      entry.records_offset % sizeof(float) != 0 ||
+      entry.half_records_offset % sizeof(uint16_t) != 0 ||
+      entry.records_offset + entry.n_records * sizeof(float) > entry.size ||
+      entry.half_records_offset + entry.n_half_records * sizeof(uint16_t) >
+          entry.size ||
+      (entry.n_entries == 0 && entry.n_half_entries == 0) ||
+      (entry.n_entries > 0 && entry.n_records % entry.n_entries != 0) ||
+      (entry.n_half_entries > 0 &&
+       entry.n_half_records % entry.n_half_entries != 0)) {
+    throw std::runtime_error("HydroEventLibrary: event " +
+                             std::to_string(event) + " in " + file_name +
+                             " is damaged");
+  }
+
+  history.tau_min = entry.tau_min;
+  history.dtau = entry.dtau;
+  history.x_min = entry.x_min;
+  history.dx = entry.dx;
+  history.y_min = entry.y_min;
+  history.dy = entry.dy;
+  history.eta_min = entry.eta_min;
+  history.deta = entry.deta;
+  history.ntau = entry.ntau;
+  history.nx = entry.nx;
+  history.ny = entry.ny;
+  history.neta = entry.neta;
+  history.tau_eta_is_tz = entry.tau_eta_is_tz != 0;
+  history.boost_invariant = entry.boost_invariant != 0;
+
+  history.data_info.clear();
+  for (uint32_t i = 0; i < entry.n_entries; i++) {
+    history.data_info.push_back(
+        GetEntryNameString(static_cast<EntryName>(entry.entries[i])));
+  }
+  history.data_info_half.clear();
+  for (uint32_t i = 0; i < entry.n_half_entries; i++) {
+    history.data_info_half.push_back(
+        GetEntryNameString(static_cast<EntryName>(entry.half_entries[i])));
+  }
+  history.CompileDataLayout();
+  history.SetExternalRecords(
+      mapping,
+      reinterpret_cast<const float *>(start + entry.records_offset),
+      entry.n_records,
+      reinterpret_cast<const uint16_t *>(start + entry.half_records_offset),
+      entry.n_half_records);
+}
+
+HydroEventLibraryWriter::HydroEventLibraryWriter(const std::string &file_name_)
+    : file_name(file_name_) {
+  Open();
+}
+
+void HydroEventLibraryWriter::Open() {
+  fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("HydroEventLibraryWriter: cannot open " +
+                             file_name);
+  }
+  fd_pid = getpid();
+}
+
+HydroEventLibraryWriter::~HydroEventLibraryWriter() { close(fd); }
+
+void HydroEventLibraryWriter::Write(uint64_t offset, const void *buffer,
+                                    size_t size) {
+  const char *pos = static_cast<const char *>(buffer);
+  while (size > 0) {
+    ssize_t n = pwrite(fd, pos, size, offset);
+    if (n <= 0) {
+      throw std::runtime_error("HydroEventLibraryWriter: cannot write " +
+                               file_name);
+    }
+    pos += n;
+    offset += n;
+    size -= n;
+  }
+}
+
+int HydroEventLibraryWriter::Add(const EvolutionHistory &history) {
+  // The lock belongs to the open file, which a forked process shares with
+  // its parent, so every process opens the file itself
+  if (fd_pid != getpid()) {
+    close(fd);
+    Open();
+  }
+  // one writer at a time, also across processes
+  if (flock(fd, LOCK_EX) != 0) {
+    throw std::runtime_error("HydroEventLibraryWriter: cannot lock " +
+                             file_name);
+  }
+  struct Unlock {
+    int fd;
+    ~Unlock() { flock(fd, LOCK_UN); }
+  } unlock = {fd};
+
+  HydroEventLibraryHeader header;
+  ssize_t n_read = pread(fd, &header, sizeof(header), 0);
+  if (n_read == 0) {
+    std::memcpy(header.magic, HydroEventLibraryMagic, 8);
+    header.endian_marker = HydroEventLibraryEndianMarker;
+    header.version = HydroEventLibraryVersion;
+    header.n_events = 0;
+    header.end =
+        AlignUp(sizeof(HydroEventLibraryHeader), HydroEventLibraryAlignment);
+  } else if (n_read != sizeof(header) || !IsLibraryHeader(header)) {
+    throw std::runtime_error(file_name + " is not a hydro event library " +
+                             "of this version, or from another machine");
+  }
+
+  HydroEventLibraryEntry entry;
+  std::memset(&entry, 0, sizeof(entry));
+  entry.tau_min = history.tau_min;
+  entry.dtau = history.dtau;
+  entry.x_min = history.x_min;
+  entry.dx = history.dx;
+  entry.y_min = history.y_min;
+  entry.dy = history.dy;
+  entry.eta_min = history.eta_min;
+  entry.deta = history.deta;
+  entry.ntau = history.ntau;
+  entry.nx = history.nx;
+  entry.ny = history.ny;
+  entry.neta = history.neta;
+  entry.tau_eta_is_tz = history.tau_eta_is_tz;
+  entry.boost_invariant = history.boost_invariant;
+
+  // FluidCellInfo cells become float records of all entries
+  bool cells = history.data_info.empty() && history.data_info_half.empty();
+  if (cells) {
+    entry.n_entries = ENTRY_INVALID;
+    for (int e = 0; e < ENTRY_INVALID; e++) {
+      entry.entries[e] = e;
+    }
+    entry.n_records = uint64_t(history.data.size()) * ENTRY_INVALID;
+  } else {
+    if (history.data_info.size() > 32 || history.data_info_half.size() > 32) {
+      throw std::runtime_error(
+          "HydroEventLibraryWriter: more than 32 entries per record");
+    }
+    entry.n_entries = history.data_info.size();
+    for (uint32_t i = 0; i < entry.n_entries; i++) {
+      entry.entries[i] = ResolveEntryName(history.data_info[i]);
+    }
+    entry.n_half_entries = history.data_info_half.size();
+    for (uint32_t i = 0; i < entry.n_half_entries; i++) {
+      entry.half_entries[i] = ResolveEntryName(history.data_info_half[i]);
+    }
+    entry.n_records = history.GetRecordsSize();
+    entry.n_half_records = history.GetHalfRecordsSize();
+  }
+  entry.records_offset = AlignUp(sizeof(entry), 64);
+  entry.half_records_offset =
+      AlignUp(entry.records_offset + entry.n_records * sizeof(float), 64);
+  entry.size =
+      entry.half_records_offset + entry.n_half_records * sizeof(uint16_t);
+
+  uint64_t offset = header.end;
+  Write(offset, &entry, sizeof(entry));
+  if (cells) {
+    std::vector<float> buffer;
+    uint64_t written = 0;
+    for (size_t i = 0; i < history.data.size(); i++) {
+      for (int e = 0; e < ENTRY_INVALID; e++) {
+        buffer.push_back(
+            GetFluidCellEntry(history.data[i], static_cast<EntryName>(e)));
+      }
+      if (buffer.size() >= (1u << 20) || i + 1 == history.data.size()) {
+        Write(offset + entry.records_offset + written * sizeof(float),
+              buffer.data(), buffer.size() * sizeof(float));
+        written += buffer.size();
+        buffer.clear();
+      }
+    }
+  } else {
+    Write(offset + entry.records_offset, history.GetRecords(),
+          entry.n_records * sizeof(float));
+    Write(offset + entry.half_records_offset, history.GetHalfRecords(),
+          entry.n_half_records * sizeof(uint16_t));
+  }
+
+  // only now the event counts
+  header.n_events++;
+  header.end = AlignUp(offset + entry.size, HydroEventLibraryAlignment);
+  Write(0, &header, sizeof(header));
+  VERBOSE(2) << "Added hydro event " << header.n_events - 1 << " to "
+             << file_name;
+  return header.n_events - 1;
+}
+
+} // end namespace Jetscape
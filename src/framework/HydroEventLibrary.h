@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// On-disk library of hydro evolution histories, read in place through mmap
+
+#ifndef HYDROEVENTLIBRARY_H
+#define HYDROEVENTLIBRARY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "FluidEvolutionHistory.h"
+
+namespace Jetscape {
+
+/**
+   File layout: a header, then the events one after the other, each
+   starting at a multiple of HydroEventLibraryAlignment. An event is a
+   HydroEventLibraryEntry with its grid and record layout, followed by its
+   float records and its half precision records, as EvolutionHistory keeps
+   them in data_vector and data_vector_half. Numbers are stored in host
+   byte order, the marker lets the reader refuse files from a machine with
+   a different one.
+
+   The header counts the events and gives the end of the last one. It is
+   rewritten only after an event is complete, so a library is never seen
+   with a partial event, and new events can be appended to it by any
+   number of jobs.
+ */
+const char HydroEventLibraryMagic[8] = {'J', 'S', 'H', 'Y', 'D', 'L', 'I', 'B'};
+const uint32_t HydroEventLibraryEndianMarker = 0x01020304;
+const uint32_t HydroEventLibraryVersion = 1;
+const uint64_t HydroEventLibraryAlignment = 4096;
+
+struct HydroEventLibraryHeader {
+  char magic[8];
+  uint32_t endian_marker;
+  uint32_t version;
+  uint64_t n_events;
+  uint64_t end; ///< end of the last event
+};
+
+struct HydroEventLibraryEntry {
+  uint64_t size;                ///< bytes up to the end of the records
+  uint64_t records_offset;      ///< from the start of the entry
+  uint64_t n_records;           ///< floats
+  uint64_t half_records_offset; ///< from the start of the entry
+  uint64_t n_half_records;      ///< halves
+  double tau_min, dtau, x_min, dx, y_min, dy, eta_min, deta;
+  int32_t ntau, nx, ny, neta;
+  int32_t tau_eta_is_tz, boost_invariant;
+  /// data_info and data_info_half as EntryName, ENTRY_INVALID for names
+  /// the framework does not know
+  uint32_t n_entries, n_half_entries;
+  uint8_t entries[32], half_entries[32];
+};
+
+/**
+   Read side of a library. The file is mapped read-only and every event is
+   read in place, so opening it costs next to nothing and jobs reading the
+   same library share one copy in the page cache. Histories filled by
+   Load() keep the mapping alive, also after the library is gone.
+   Throws std::runtime_error if the file is not a library.
+ */
+class HydroEventLibrary {
+public:
+  explicit HydroEventLibrary(const std::string &file_name);
+
+  /// Events complete when the library was opened
+  int GetNumberOfEvents() const { return events.size(); }
+
+  const HydroEventLibraryEntry &GetEntry(int event) const;
+
+  /// Points history to the records of the event, with its grid and layout.
+  void Load(int event, EvolutionHistory &history) const;
+
+private:
+  std::string file_name;
+  std::shared_ptr<const void> mapping;
+  std::vector<const HydroEventLibraryEntry *> events;
+};
+
+/**
+   Appends evolution histories to a library, creating it if it does not
+   exist. Each Add() holds an exclusive lock on the file, so several
+   processes can write to the same library; the events are then in the
+   order they were added. Histories of FluidCellInfo cells are stored as
+   float records of all entries, compact ones as they are.
+   Throws std::runtime_error if the file cannot be written.
+ */
+class HydroEventLibraryWriter {
+public:
+  explicit HydroEventLibraryWriter(const std::string &file_name);
+  ~HydroEventLibraryWriter();
+
+  HydroEventLibraryWriter(const HydroEventLibraryWriter &) = delete;
+  HydroEventLibraryWriter &operator=(const HydroEventLibraryWriter &) = delete;
+
+  /// Appends history as a new event. @return Its index in the library.
+  int Add(const EvolutionHistory &history);
+
+  const std::string &GetFileName() const { return file_name; }
+
+private:
+  void Open();
+  void Write(uint64_t offset, const void *buffer, size_t size);
+
+  std::string file_name;
+  int fd;
+  pid_t fd_pid; ///< process that opened fd
+};
+
+} // end namespace Jetscape
+
+#endif // HYDROEVENTLIBRARY_H
@@ -44,7 +44,7 @@ void InitialState::Exec() {
   // Do whatever is needed to figure out the internal temp...
 }
 
-void InitialState::Clear() {}
+void InitialState::Clear() { ClearBinaryCollisionSampler(); }
 
 void InitialState::Write(weak_ptr<JetScapeWriter> w) {
   //Write out the original vertex so the writer can keep track of it...
@@ -77,20 +77,43 @@ std::tuple<double, double, double> InitialState::CoordFromIdx(int idx) {
 }
 
 
+void InitialState::BuildBinaryCollisionSampler() {
+  binary_collision_dist_ = std::discrete_distribution<>(
+      begin(num_of_binary_collisions_), end(num_of_binary_collisions_));
+  binary_collision_dist_ready_ = true;
+}
+
+void InitialState::ClearBinaryCollisionSampler() {
+  binary_collision_dist_ready_ = false;
+}
+
 void InitialState::SampleABinaryCollisionPoint(double &x, double &y) {
   if (num_of_binary_collisions_.size() == 0) {
     JSWARN << "num_of_binary_collisions is empty, setting the starting "
               "location to 0. Make sure to add e.g. trento before PythiaGun.";
+    x = 0.0;
+    y = 0.0;
   } else {
-    std::discrete_distribution<> dist(
-        begin(num_of_binary_collisions_),
-        end(num_of_binary_collisions_)); // Create the distribution
-    // Now generate values
-    auto idx = dist(*GetMt19937Generator());
+    // a grid of another size was filled without clearing the table
+    if (!binary_collision_dist_ready_ ||
+        binary_collision_dist_.probabilities().size() !=
+            num_of_binary_collisions_.size()) {
+      BuildBinaryCollisionSampler();
+    }
+    auto idx = binary_collision_dist_(*GetMt19937Generator());
     auto coord = CoordFromIdx(idx);
     x = std::get<0>(coord);
     y = std::get<1>(coord);
   }
 }
 
+void InitialState::SampleBinaryCollisionPoints(int n, std::vector<double> &x,
+                                               std::vector<double> &y) {
+  x.resize(n);
+  y.resize(n);
+  for (int i = 0; i < n; i++) {
+    SampleABinaryCollisionPoint(x[i], y[i]);
+  }
+}
+
 } // end namespace Jetscape
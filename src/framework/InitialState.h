@@ -18,6 +18,8 @@
 
 #include <tuple>
 #include <memory>
+#include <random>
+#include <vector>
 #include "JetScapeModuleBase.h"
 #include "JetClass.h"
 
@@ -98,19 +100,21 @@ public:
     grid_step_z_ = dz;
   }
 
-  /**  @return The initial state entropy density distribution.
+  /**  @return The initial state entropy density distribution, read only and
+       without a copy. Valid until the next Exec() or Clear() of this module.
        @sa Function CoordFromIdx(int idx) for mapping of the index of the vector entropy_density_distribution_ to the fluid cell at location (x, y, z or eta).
   */
-  inline std::vector<double> GetEntropyDensityDistribution() {
+  inline const std::vector<double> &GetEntropyDensityDistribution() const {
     return entropy_density_distribution_;
   };
 
   /** one can sample jet production position from Ta * Tb
       where Ta * Tb is the distribution of num_of_binary_collisions
-      @return The un-normalized probability density of binary collisions.
+      @return The un-normalized probability density of binary collisions,
+      read only and without a copy, like GetEntropyDensityDistribution().
       @sa Function CoordFromIdx(int idx) for mapping of the index of the vector num_of_binary_collisions_ to the fluid cell at location (x, y, z or eta).
    */
-  inline std::vector<double> GetNumOfBinaryCollisions() {
+  inline const std::vector<double> &GetNumOfBinaryCollisions() const {
     return num_of_binary_collisions_;
   };
 
@@ -125,8 +129,24 @@ public:
       @param idx is an integer which maps to an unique unit cell in the coordinate space (x,y,z or eta). 
    */
   std::tuple<double, double, double> CoordFromIdx(int idx);
+
+  /** Samples a jet production point (x, y) from num_of_binary_collisions_.
+      The cumulative table is built on the first call after the grid is
+      filled and reused until it changes, so each sample is a binary search.
+      @param x Sampled x coordinate, 0 if there is no binary collision grid.
+      @param y Sampled y coordinate, 0 if there is no binary collision grid.
+   */
   virtual void SampleABinaryCollisionPoint(double &x, double &y);
 
+  /** Samples n jet production points in one call, with the same random
+      sequence as n calls of SampleABinaryCollisionPoint().
+      @param n Number of points.
+      @param x Resized to n, sampled x coordinates.
+      @param y Resized to n, sampled y coordinates.
+   */
+  virtual void SampleBinaryCollisionPoints(int n, std::vector<double> &x,
+                                           std::vector<double> &y);
+
   /**  @return The maximum value of coordinate "x" in the nuclear profile of a nucleus.
    */
   inline double GetXMax() { return grid_max_x_; }
@@ -191,6 +211,16 @@ protected:
   std::vector<double> num_of_binary_collisions_;
   // the above should be private. Only Adding getters for now to not break other people's code
 
+  /** Builds the sampling table of num_of_binary_collisions_. Modules may
+      call it once the grid is filled, otherwise it is built on first use.
+   */
+  void BuildBinaryCollisionSampler();
+
+  /** Drops the sampling table. Must be called whenever
+      num_of_binary_collisions_ is modified.
+   */
+  void ClearBinaryCollisionSampler();
+
   /**  @return The initial state entropy density distribution.
        @sa Function CoordFromIdx(int idx) for mapping of the index of the vector entropy_density_distribution_ to the fluid cell at location (x, y, z or eta).
    */
@@ -225,6 +255,11 @@ protected:
   double grid_step_x_;
   double grid_step_y_;
   double grid_step_z_;
+
+private:
+  // cumulative table of num_of_binary_collisions_ for the jet positions
+  std::discrete_distribution<> binary_collision_dist_;
+  bool binary_collision_dist_ready_ = false;
 };
 
 } // end namespace Jetscape
@@ -45,6 +45,7 @@ namespace Jetscape {
 
 JetEnergyLoss::JetEnergyLoss() {
   qhat = -99.99;
+  shower_index = 0;
   SetId("JetEnergyLoss");
   jetSignalConnected = false;
   edensitySignalConnected = false;
@@ -70,6 +71,7 @@ JetEnergyLoss::~JetEnergyLoss() {
 
 JetEnergyLoss::JetEnergyLoss(const JetEnergyLoss &j) {
   qhat = j.GetQhat();
+  shower_index = j.GetShowerIndex();
   SetActive(j.GetActive());
   SetId(j.GetId());
   SetJetSignalConnected(false);
@@ -93,6 +95,29 @@ JetEnergyLoss::JetEnergyLoss(const JetEnergyLoss &j) {
   }
 }
 
+void JetEnergyLoss::GetMediumCell(double t, double x, double y, double z,
+                                  FluidCellInfo &cell) {
+  if (medium_handle.IsValid()) {
+    medium_handle.GetCell(t, x, y, z, cell, medium_cache);
+  } else {
+    std::unique_ptr<FluidCellInfo> fluid_cell_ptr;
+    GetHydroCellSignal(t, x, y, z, fluid_cell_ptr);
+    if (fluid_cell_ptr)
+      cell = *fluid_cell_ptr;
+  }
+}
+
+void JetEnergyLoss::ReportMediumCache() {
+  unsigned long hits = medium_cache.GetHits();
+  unsigned long lookups = hits + medium_cache.GetMisses();
+  if (lookups > 0) {
+    VERBOSE(2) << GetId() << " medium cache: " << hits << " hits, "
+               << lookups - hits << " misses ("
+               << 100. * hits / lookups << "% hit rate)";
+  }
+  medium_cache.ResetCounters();
+}
+
 void JetEnergyLoss::Clear() {
   VERBOSESHOWER(8);
   if (pShower)
@@ -158,8 +183,8 @@ void JetEnergyLoss::DoShower() {
 
   vector<node> vStartVec;
   // Add here the Hard Shower emitting parton ...
-  vStart = pShower->new_vertex(make_shared<Vertex>());
-  vEnd = pShower->new_vertex(make_shared<Vertex>());
+  vStart = pShower->new_vertex(Vertex());
+  vEnd = pShower->new_vertex(Vertex());
   // Add original parton later, after it had a chance to acquire virtuality
   // pShower->new_parton(vStart,vEnd,make_shared<Parton>(*GetShowerInitiatingParton()));
 
@@ -207,8 +232,7 @@ void JetEnergyLoss::DoShower() {
         //      << pInTempModule.at(0).t() << endl;
         // cerr << " ---------------------------------------------- "
         //      << endl;
-        pShower->new_parton(vStart, vEnd,
-                            make_shared<Parton>(pInTempModule.at(0)));
+        pShower->new_parton(vStart, vEnd, pInTempModule.at(0));
         foundchangedorig = true;
       }
 
@@ -235,15 +259,12 @@ void JetEnergyLoss::DoShower() {
         for (int k = 0; k < pOutTemp.size(); k++) {
           int edgeid = 0;
           if (pOutTemp[k].pstat() == neg_stat) {
-            node vNewRootNode = pShower->new_vertex(
-                make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
-            edgeid = pShower->new_parton(vNewRootNode, vStart,
-                                         make_shared<Parton>(pOutTemp[k]));
+            node vNewRootNode =
+                pShower->new_vertex(Vertex(0, 0, 0, currentTime - deltaT));
+            edgeid = pShower->new_parton(vNewRootNode, vStart, pOutTemp[k]);
           } else {
-            vEnd =
-                pShower->new_vertex(make_shared<Vertex>(0, 0, 0, currentTime));
-            edgeid = pShower->new_parton(vStart, vEnd,
-                                         make_shared<Parton>(pOutTemp[k]));
+            vEnd = pShower->new_vertex(Vertex(0, 0, 0, currentTime));
+            edgeid = pShower->new_parton(vStart, vEnd, pOutTemp[k]);
           }
           pOutTemp[k].set_shower(pShower);
           pOutTemp[k].set_edgeid(edgeid);
@@ -272,10 +293,9 @@ void JetEnergyLoss::DoShower() {
             //     << " new root node(s) to be added ..." << endl;
 
             for (int l = 1; l < pInTempModule.size(); l++) {
-              node vNewRootNode = pShower->new_vertex(
-                  make_shared<Vertex>(0, 0, 0, currentTime - deltaT));
-              pShower->new_parton(vNewRootNode, vEnd,
-                                  make_shared<Parton>(pInTempModule[l]));
+              node vNewRootNode =
+                  pShower->new_vertex(Vertex(0, 0, 0, currentTime - deltaT));
+              pShower->new_parton(vNewRootNode, vEnd, pInTempModule[l]);
             }
           }
         }
@@ -377,6 +397,13 @@ void JetEnergyLoss::Exec() {
     // Shower handled in this class ...
     DoShower();
 
+    ReportMediumCache();
+    for (auto it : GetTaskList()) {
+      auto module = dynamic_pointer_cast<JetEnergyLoss>(it);
+      if (module)
+        module->ReportMediumCache();
+    }
+
     pShower->PrintNodes();
     pShower->PrintEdges();
 
@@ -52,6 +52,12 @@ public:
    */
   virtual shared_ptr<JetEnergyLoss> Clone() const { return nullptr; }
 
+  /** Eloss modules whose copies share no mutable state (static or global)
+      return true. Only then does JetEnergyLossManager run the showers
+      of one event concurrently.
+   */
+  virtual bool SupportsParallelShowers() const { return false; }
+
   /** It reads the input parameters from a XML file under the tag <Eloss>.
       Sets the Parton class @a inP and PartonShower class @a pShower to null.
       Also initializes the tasks attached to the JetEnergyLoss module.
@@ -88,6 +94,28 @@ public:
   sigslot::signal5<double, double, double, double,
                    std::unique_ptr<FluidCellInfo> &, multi_threaded_local>
       GetHydroCellSignal;
+
+  //! Batched medium query, see FluidDynamics::GetHydroCells. Connected for
+  //! modules that have many points at once, DoShower() does not use it.
+  sigslot::signal1<FluidCellBatch &, multi_threaded_local> GetHydroCellsSignal;
+
+  /** Fluid cell at (t, x, y, z), for the eloss modules. Goes through the
+      MediumHandle set at connect time, without locking or allocating, and
+      falls back to GetHydroCellSignal if there is none. Evolution history
+      stencils are cached per module, i.e. per shower.
+   */
+  void GetMediumCell(double t, double x, double y, double z,
+                     FluidCellInfo &cell);
+
+  //! Logs and resets the hit/miss counters of the GetMediumCell() cache
+  void ReportMediumCache();
+
+  //! Set by JetScapeSignalManager together with GetHydroCellSignal
+  void SetMediumHandle(const MediumHandle &m_medium_handle) {
+    medium_handle = m_medium_handle;
+  }
+
+  const MediumHandle &GetMediumHandle() const { return medium_handle; }
   
   sigslot::signal1<double &, multi_threaded_local> GetHydroTau0Signal;
 
@@ -117,6 +145,19 @@ public:
    */
   const double GetQhat() const { return qhat; }
 
+  /** Sets the index of the shower this copy of an eloss module runs in,
+      among the showers of the current event. Set by JetEnergyLossManager
+      before the showers run, also when they run in parallel. Modules that
+      number partons derive their labels from it, so that the labels do
+      not depend on the order the showers ran in.
+      @param index Index of the shower-initiating parton.
+   */
+  virtual void SetShowerIndex(int index) { shower_index = index; }
+
+  /** @return The index of the shower this copy runs in.
+   */
+  int GetShowerIndex() const { return shower_index; }
+
   /** It adds a initiating parton @a p to create the parton shower in an energy loss task.
       @param p A pointer of type parton class.
    */
@@ -222,11 +263,14 @@ private:
   double maxT;
 
   double qhat;
+  int shower_index;
   shared_ptr<Parton> inP;
   shared_ptr<PartonShower> pShower;
 
   bool GetHydroCellSignalConnected;
   bool GetHydroTau0SignalConnected;
+  MediumHandle medium_handle;
+  FluidStencilCache medium_cache;
   bool SentInPartonsConnected;
 
   /** This function executes the shower process for the partons produced from the hard scaterring.                                                                         
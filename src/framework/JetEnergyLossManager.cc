@@ -17,11 +17,15 @@
 #include "JetScapeLogger.h"
 #include "JetScapeSignalManager.h"
 #include "MakeUniqueHelper.h"
+#include "JetScapeXML.h"
+#include "JetScapeModuleBase.h"
+#include "JetScapeTaskSupport.h"
 #include <string>
 
 #include <iostream>
 #include <vector>
 #include <thread>
+#include <random>
 
 using namespace std;
 
@@ -30,6 +34,7 @@ namespace Jetscape {
 JetEnergyLossManager::JetEnergyLossManager() {
   SetId("JLossManager");
   GetHardPartonListConnected = false;
+  nShowerThreads = 0;
   VERBOSE(8);
 }
 
@@ -81,6 +86,50 @@ void JetEnergyLossManager::Init() {
       JetScapeSignalManager::Instance()->SetEnergyLossPointer(
           dynamic_pointer_cast<JetEnergyLoss>(it));
   }
+
+  // Every shower gets its own random stream, also when they run serially,
+  // so that the result does not depend on the number of threads
+  showerSeedGenerator =
+      JetScapeTaskSupport::Instance()->GetMt19937Generator(GetMyTaskNumber());
+
+  // Optional parallel showers, 0 runs them serially on the calling thread
+  SetNumberOfThreads(
+      JetScapeXML::Instance()->GetElementInt({"Eloss", "nThreads"}, false));
+}
+
+void JetEnergyLossManager::SetNumberOfThreads(int n) {
+  nShowerThreads = n;
+  // the pool is made again on the next event
+  showerPool.reset();
+  if (nShowerThreads <= 0)
+    return;
+
+  auto jloss = dynamic_pointer_cast<JetEnergyLoss>(GetTaskAt(0));
+  bool parallel = true;
+  for (auto it : jloss->GetTaskList()) {
+    auto module = dynamic_pointer_cast<JetEnergyLoss>(it);
+    if (module && !module->SupportsParallelShowers()) {
+      JSWARN << "Eloss module " << module->GetId()
+             << " does not support parallel showers.";
+      parallel = false;
+    }
+  }
+  // Droplets have to be collected in the serial order
+  if (!weak_ptr_is_uninitialized(jloss->get_liquefier())) {
+    JSWARN << "Liquefier attached, showers cannot run in parallel.";
+    parallel = false;
+  }
+  if (!parallel) {
+    JSWARN << "Running showers on 1 thread instead of " << nShowerThreads
+           << ", with the same per-shower random streams.";
+    nShowerThreads = 1;
+  }
+  JSINFO << "Showers run on " << nShowerThreads << " thread(s).";
+}
+
+void JetEnergyLossManager::Reseed() {
+  showerSeedGenerator =
+      JetScapeTaskSupport::Instance()->GetMt19937Generator(GetMyTaskNumber());
 }
 
 void JetEnergyLossManager::WriteTask(weak_ptr<JetScapeWriter> w) {
@@ -136,59 +185,28 @@ void JetEnergyLossManager::Exec() {
     for (auto it : GetTaskList()) {
       dynamic_pointer_cast<JetEnergyLoss>(it)->AddShowerInitiatingParton(
           hp.at(n));
+      for (auto module : it->GetTaskList()) {
+        dynamic_pointer_cast<JetEnergyLoss>(module)->SetShowerIndex(n);
+      }
       n++;
     }
   }
 
   // ----------------------------------
-  // quick and dirty here, only include after further testing (flag in init xml files ...)
-  bool multiTask = false;
-
-  // ----------------------------------
-  //Excute JetEnergyLoss tasks and their subtasks (done via signal/slot) by hand ...
-  //needed if only JetEnergyloss tasks in parallel (otherwise could be done via JetScapeTask, then every task a new thread for example)
-  // Of course now the number of threads if plainly given by the number of initial hard partons and can exceed the allowed # of threads >1000
-  // so to really do this properly one has to think about and limit to number of CPU's * N threads or something in that directions. See a quick attempt below.
-
-  //DEBUG:
-  //unsigned num_cpus = thread::hardware_concurrency();
-  //cout << "Num of CPU's = " << num_cpus << " threads\n";
-
-  if (multiTask) {
-    int nTasks = GetNumberOfTasks();
-    int nCPUs = thread::hardware_concurrency();
-
-    vector<thread> threads;
-
-    int nMaxThreads = nCPUs * 2;
-    int n = 0;
-
-    VERBOSE(3) << " Use multi-threading: (max) # of threads = # of CPU's "
-               << nCPUs << " (found) * 2";
-
-    for (auto it : GetTaskList()) {
-      if (it->GetActive()) {
-        threads.push_back(thread(&JetEnergyLoss::Exec,
-                                 dynamic_pointer_cast<JetEnergyLoss>(it)));
-        n++;
-      }
-      if (n == nMaxThreads) {
-        //DEBUGTHREAD<<n;
-        for (auto &th : threads)
-          th.join();
-        n = 0;
-        threads.clear();
-
-        //DEBUG:
-        //std::this_thread::sleep_for(std::chrono::milliseconds(5000));
-      }
-    }
-
-    if (nTasks < nMaxThreads) {
-      for (auto &th : threads)
-        th.join();
-      threads.clear();
+  // Excute JetEnergyLoss tasks and their subtasks (done via signal/slot) by hand ...
+  // Showers only depend on their initiating parton and their own random
+  // stream, so they can run in any order on the pool.
+  SeedShowers();
+  if (nShowerThreads > 0) {
+    if (!showerPool) {
+      showerPool = make_unique<JetScapeThreadPool>(nShowerThreads);
     }
+    auto showers = GetTaskList();
+    showerPool->RunAndWait(showers.size(), [&showers](int i) {
+      if (showers[i]->GetActive()) {
+        showers[i]->Exec();
+      }
+    });
   }
   // ----------------------------------
   else
@@ -200,6 +218,26 @@ void JetEnergyLossManager::Exec() {
              << " Eloss Manager Tasks/Modules finished.";
 }
 
+void JetEnergyLossManager::SeedShowers() {
+  // One draw per event from the manager's engine, then an independent
+  // engine for every (shower, module) pair. Copies made by Clone() share
+  // the engine of the original otherwise.
+  unsigned int event_seed = (*showerSeedGenerator)();
+  auto showers = GetTaskList();
+  for (unsigned int i = 0; i < showers.size(); i++) {
+    auto modules = showers[i]->GetTaskList();
+    for (unsigned int j = 0; j < modules.size(); j++) {
+      auto module = dynamic_pointer_cast<JetScapeModuleBase>(modules[j]);
+      if (!module)
+        continue;
+      std::seed_seq seq{event_seed, i, j};
+      unsigned int seed = 0;
+      seq.generate(&seed, &seed + 1);
+      module->SetMt19937Generator(make_shared<std::mt19937>(seed));
+    }
+  }
+}
+
 void JetEnergyLossManager::CreateSignalSlots() {
   for (auto it : GetTaskList()) {
     for (auto it2 : it->GetTaskList()) {
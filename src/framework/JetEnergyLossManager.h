@@ -18,8 +18,11 @@
 
 #include "JetScapeTask.h"
 #include "JetClass.h"
+#include "JetScapeThreadPool.h"
 #include "sigslot.h"
 
+#include <memory>
+#include <random>
 #include <vector>
 
 namespace Jetscape {
@@ -44,9 +47,19 @@ public:
   virtual void Init();
 
   /** It reads the Hard Patrons list and calls CreateSignalSlots() function. Then, it executes the energy loss tasks attached with the jet energy loss manager. This function also includes the parallel computing feature. It can be overridden by other tasks.
+      Every shower gets its own random stream, derived from the event and the shower index. With <Eloss><nThreads> > 0 the showers run on a pool of that many threads, otherwise one after the other on the calling thread. The result does not depend on the number of threads.
   */
   virtual void Exec();
 
+  /** Sets the number of threads the showers of the following events run on, same as <Eloss><nThreads>. Falls back to 1 if an attached module or liquefier does not allow parallel showers. Only valid after Init().
+      @param n Number of threads, 0 runs the showers on the calling thread.
+   */
+  void SetNumberOfThreads(int n);
+
+  /** @return The number of threads the showers run on, 0 for the calling thread.
+   */
+  int GetNumberOfThreads() const { return nShowerThreads; }
+
   /** It erases the tasks attached with the energy loss manager. It can be overridden by other tasks.
    */
   virtual void Clear();
@@ -57,6 +70,10 @@ public:
   */
   virtual void WriteTask(weak_ptr<JetScapeWriter> w);
 
+  /** Takes a new engine for the per-event shower seeds, in a forked worker.
+   */
+  virtual void Reseed();
+
   int GetNumSignals();
 
   /** Uses philosophy of signal slots. Checks whether the attached task is connected via signal slots to the functions UpdateEnergyDeposit(), GetEnergyDensity(), GetHydroCell() (defined in FluidDynamics class), and DoEnergyLoss() (defined in JetEnergyLoss class). If not, then, it sends a signal to these functions.
@@ -84,6 +101,13 @@ public:
 private:
   bool GetHardPartonListConnected;
   vector<shared_ptr<Parton>> hp;
+
+  void SeedShowers();
+
+  int nShowerThreads;
+  // made on the first event, so that forked workers have their own threads
+  std::unique_ptr<JetScapeThreadPool> showerPool;
+  shared_ptr<std::mt19937> showerSeedGenerator;
 };
 
 } // end namespace Jetscape
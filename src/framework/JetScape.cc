@@ -27,6 +27,7 @@
 #ifdef USE_HEPMC
 #include "JetScapeWriterHepMC.h"
 #include "JetScapeWriterHepMCfifo.h"
+#include "JetScapeWriterHepMCSink.h"
   #ifdef USE_ROOT
   #include "JetScapeWriterRootHepMC.h"
   #endif
@@ -36,6 +37,11 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using namespace std;
 
@@ -46,6 +52,7 @@ namespace Jetscape {
    */
 JetScape::JetScape()
     : JetScapeModuleBase(), n_events(1), n_events_printout(100), reuse_hydro_(false), n_reuse_hydro_(1),
+      n_workers_(1), worker_index_(-1), first_event_(0), last_event_(0),
       liquefier(nullptr), fEnableAutomaticTaskListDetermination(true) {
   VERBOSE(8);
   SetId("primary");
@@ -88,10 +95,167 @@ void JetScape::Init() {
   // So --> JetScape is "Task Manager" of all modules ...
   JSINFO << "Found " << GetNumberOfTasks() << " Modules Initialize them ... ";
   SetPointers();
+
+  if (n_workers_ > 1) {
+    InitWithWorkers();
+    return;
+  }
+
   JSINFO << "Calling JetScape InitTasks()...";
   JetScapeTask::InitTasks();
 }
 
+//________________________________________________________________
+// Modules are initialized once and shared copy-on-write by the forked
+// workers. Writers open their output after the fork, under the worker's
+// file name in the workers, and the parent only needs them to merge.
+static bool InitAfterFork(const shared_ptr<JetScapeTask> &task) {
+  return dynamic_pointer_cast<JetScapeWriter>(task) || task->InitInWorkers();
+}
+
+void JetScape::InitWithWorkers() {
+  JSINFO << "Calling JetScape InitTasks() before starting the workers ...";
+  for (auto it : GetTaskList()) {
+    if (!InitAfterFork(it)) {
+      it->Init();
+    } else if (!dynamic_pointer_cast<JetScapeWriter>(it)) {
+      JSINFO << it->GetId() << " is initialized in every worker";
+    }
+  }
+
+  StartWorkers();
+  if (worker_index_ < 0) {
+    JSINFO << "Started " << worker_pids_.size()
+           << " worker processes, initializing the writers ...";
+    for (auto it : GetTaskList()) {
+      if (dynamic_pointer_cast<JetScapeWriter>(it)) {
+        it->Init();
+      }
+    }
+    return;
+  }
+
+  JetScapeTask::ReseedTasks();
+  for (auto it : GetTaskList()) {
+    if (InitAfterFork(it)) {
+      it->Init();
+    }
+  }
+}
+
+//________________________________________________________________
+static std::string WorkerOutputFileName(const std::string &name,
+                                        unsigned int worker) {
+  return name + ".worker" + std::to_string(worker);
+}
+
+//________________________________________________________________
+void JetScape::StartWorkers() {
+  for (auto it : GetTaskList()) {
+    auto w = dynamic_pointer_cast<JetScapeWriter>(it);
+    if (w && w->GetActive() && !w->SupportsWorkerOutput()) {
+      JSWARN << "Writer " << w->GetId()
+             << " cannot merge worker output, use nWorkers = 1";
+      throw std::runtime_error("Writer does not support worker processes.");
+    }
+  }
+
+  // Contiguous blocks of events, aligned to the hydro reuse so that every
+  // worker starts with a fresh hydro event
+  int align = 1;
+  if (reuse_hydro_ && n_reuse_hydro_ > 0) {
+    align = n_reuse_hydro_;
+  }
+  int n_blocks = (GetNumberOfEvents() + align - 1) / align;
+  int events_per_worker = align * ((n_blocks + n_workers_ - 1) / n_workers_);
+
+  // For seed 0 this is the time based seed the parent drew, so the
+  // workers still get different random streams
+  unsigned int base_seed = JetScapeTaskSupport::GetRandomSeed();
+
+  std::cout.flush();
+  fflush(stdout);
+  for (unsigned int k = 0; k < n_workers_; k++) {
+    int first = k * events_per_worker;
+    if (first >= GetNumberOfEvents()) {
+      break;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      throw std::runtime_error("Cannot fork JetScape worker process.");
+    }
+    if (pid > 0) {
+      worker_pids_.push_back(pid);
+      continue;
+    }
+
+    // Worker from here on
+    worker_index_ = k;
+    first_event_ = first;
+    last_event_ = std::min(first + events_per_worker, GetNumberOfEvents());
+    worker_pids_.clear();
+    SetCurrentEvent(first_event_);
+
+    // Reproducible, independent seed per worker. Set in the XML since
+    // some modules read the seed from there themselves.
+    std::seed_seq seq{base_seed, k};
+    unsigned int seed = 0;
+    seq.generate(&seed, &seed + 1);
+    if (seed == 0) {
+      seed = 1;
+    }
+    tinyxml2::XMLElement *xml_seed =
+        JetScapeXML::Instance()->GetElement({"Random", "seed"}, false);
+    if (xml_seed) {
+      xml_seed->SetText(seed);
+    }
+    JetScapeTaskSupport::ReadSeedFromXML();
+
+    for (auto it : GetTaskList()) {
+      auto w = dynamic_pointer_cast<JetScapeWriter>(it);
+      if (w) {
+        w->SetOutputFileName(WorkerOutputFileName(w->GetOutputFileName(), k));
+      }
+    }
+
+    JSINFO << "Worker " << k << " runs events " << first_event_ << " to "
+           << last_event_ - 1 << " with seed " << seed;
+    return;
+  }
+}
+
+//________________________________________________________________
+void JetScape::CollectWorkerOutput() {
+  // A failed worker fails the run, partial output would be misleading
+  bool failed = false;
+  for (auto pid : worker_pids_) {
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0) {
+      JSWARN << "JetScape worker process " << pid << " failed.";
+      failed = true;
+    }
+  }
+  if (failed) {
+    throw std::runtime_error("JetScape worker process failed.");
+  }
+
+  for (auto it : GetTaskList()) {
+    auto w = dynamic_pointer_cast<JetScapeWriter>(it);
+    if (!w || !w->GetActive()) {
+      continue;
+    }
+    for (unsigned int k = 0; k < worker_pids_.size(); k++) {
+      std::string file_name = WorkerOutputFileName(w->GetOutputFileName(), k);
+      w->AppendWorkerOutput(file_name);
+      std::remove(file_name.c_str());
+    }
+  }
+
+  SetCurrentEvent(GetNumberOfEvents());
+}
+
 //________________________________________________________________
 void JetScape::recurseToBuild(std::vector<std::string> &elems, tinyxml2::XMLElement *mElement)
 {
@@ -162,6 +326,13 @@ void JetScape::ReadGeneralParametersFromXML() {
     VERBOSE(1) << "JetScape Verbose Level = " << m_vlevel;
   }
 
+  // Messages per second from one JSINFO or JSWARN line
+  if (GetXMLElement({"logRateLimit"}, false)) {
+    int rate_limit = GetXMLElementInt({"logRateLimit"});
+    JetScapeLogger::Instance()->SetRateLimit(rate_limit > 0 ? rate_limit : 0);
+    VERBOSE(1) << "JetScape Log Rate Limit = " << rate_limit;
+  }
+
   // Flag for automatic task list determination from User XML
   std::string enableAutomaticTaskListDetermination =
       GetXMLElementText({"enableAutomaticTaskListDetermination"});
@@ -195,6 +366,13 @@ void JetScape::ReadGeneralParametersFromXML() {
     JSINFO << "nReuseHydro: " << nReuseHydro;
   }
 
+  // Number of worker processes, optional
+  int nWorkers = GetXMLElementInt({"nWorkers"}, false);
+  if (nWorkers > 1) {
+    SetNumberOfWorkers(nWorkers);
+    JSINFO << "nWorkers = " << nWorkers;
+  }
+
   // Set up helper. Mostly used for random numbers
   // Needs the XML reader singleton set up
   JetScapeTaskSupport::ReadSeedFromXML();
@@ -785,6 +963,8 @@ void JetScape::DetermineWritersFromXML() {
   // Copy string in order to set file extensions for each type
   std::string outputFilenameAscii = outputFilename;
   std::string outputFilenameAsciiGZ = outputFilename;
+  std::string outputFilenameBinary = outputFilename;
+  std::string outputFilenameBinaryGZ = outputFilename;
   std::string outputFilenameHepMC = outputFilename;
   std::string outputFilenameHepMCfifo = outputFilename;
   std::string outputFilenameRootHepMC = outputFilename;
@@ -796,6 +976,10 @@ void JetScape::DetermineWritersFromXML() {
                         outputFilenameAscii.append(".dat"));
   CheckForWriterFromXML("JetScapeWriterAsciiGZ",
                         outputFilenameAsciiGZ.append(".dat.gz"));
+  CheckForWriterFromXML("JetScapeWriterBinary",
+                        outputFilenameBinary.append(".jsbin"));
+  CheckForWriterFromXML("JetScapeWriterBinaryGZ",
+                        outputFilenameBinaryGZ.append(".jsbin.gz"));
   CheckForWriterFromXML("JetScapeWriterHepMC",
                         outputFilenameHepMC.append(".hepmc"));
   CheckForWriterFromXML("JetScapeWriterRootHepMC",
@@ -806,6 +990,7 @@ void JetScape::DetermineWritersFromXML() {
                         outputFilenameFinalStateHadronsAscii.append("_final_state_hadrons.dat"));
   CheckForWriterFromXML("JetScapeWriterHepMCfifo",
                         outputFilenameHepMCfifo.append(".hepmc"));
+  CheckForWriterFromXML("JetScapeWriterHepMCSink", outputFilename);
 
   // Check for custom writers
   tinyxml2::XMLElement *element =
@@ -874,6 +1059,16 @@ void JetScape::CheckForWriterFromXML(const char *writerName,
              << outputFilename.c_str() << ") added to task list.";
 #endif  
     }
+    else if (strcmp(writerName, "JetScapeWriterHepMCSink") == 0) {
+#ifdef USE_HEPMC
+      VERBOSE(2) << "Manually creating JetScapeWriterHepMCSink (due to multiple "
+                    "inheritance)";
+      auto writer = std::make_shared<JetScapeWriterHepMCSink>(outputFilename);
+      Add(writer);
+      JSINFO << "JetScape::DetermineTaskList() -- " << writerName
+             << " (in-process) added to task list.";
+#endif
+    }
    else {
       VERBOSE(2) << "Writer is NOT created...";
     }
@@ -931,6 +1126,12 @@ void JetScape::Exec() {
   JSINFO << BOLDRED << "Run JetScape ...";
   JSINFO << BOLDRED << "Number of Events = " << GetNumberOfEvents();
 
+  // The parent of the workers only merges their output
+  if (n_workers_ > 1 && worker_index_ < 0) {
+    CollectWorkerOutput();
+    return;
+  }
+
   // JetScapeTask::ExecuteTasks(); Has to be called explicitly since not really fully recursively (if ever needed)
   // --> JetScape is "Task Manager" of all modules ...
 
@@ -945,7 +1146,14 @@ void JetScape::Exec() {
     }
   }
 
-  for (int i = 0; i < GetNumberOfEvents(); i++) {
+  int first_event = 0;
+  int last_event = GetNumberOfEvents();
+  if (worker_index_ >= 0) {
+    first_event = first_event_;
+    last_event = last_event_;
+  }
+
+  for (int i = first_event; i < last_event; i++) {
     if (i % n_events_printout == 0) {
       JSINFO << BOLDRED << "Run Event # = " << i;
     }
@@ -1041,6 +1249,18 @@ void JetScape::Exec() {
 
     IncrementCurrentEvent();
   }
+
+  // Workers are done here, the parent writes the merged output. Their
+  // files are complete when Exec() returns, the caller decides what the
+  // worker does next (see IsWorker()).
+  if (worker_index_ >= 0) {
+    for (auto w : vWriter) {
+      auto f = w.lock();
+      if (f) {
+        f->Close();
+      }
+    }
+  }
 }
 
 void JetScape::Finish() {
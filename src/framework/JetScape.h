@@ -21,6 +21,9 @@
 #include "JetScapeModuleBase.h"
 #include "CausalLiquefier.h"
 
+#include <sys/types.h>
+#include <vector>
+
 namespace Jetscape {
 
 class JetScape : public JetScapeModuleBase {
@@ -75,6 +78,35 @@ public:
   }
   inline unsigned int GetNReuseHydro() const { return n_reuse_hydro_; }
 
+  /** Number of worker processes running the event loop. With more than
+      one, Init() initializes the modules and then forks the workers, which
+      share the initialized modules (tables, Pythia instances) with the
+      parent until they write to them. Each worker is re-seeded with a seed
+      derived from the main one (JetScapeTask::Reseed), writes to its own
+      output files and runs a contiguous block of events (aligned to the
+      hydro reuse). Modules that return true from
+      JetScapeTask::InitInWorkers are initialized in every worker instead. The parent waits in Exec() and appends
+      the worker output to its writers in event order, so the output files
+      look as if written by a single process. Only writers that implement
+      JetScapeWriter::AppendWorkerOutput can be used: the HepMC, HepMC fifo
+      and HepMC sink writers (SupportsWorkerOutput() is false) make Init()
+      throw with more than one worker.
+      Init() and Exec() return in the workers as well. A worker's Exec()
+      returns after its events, with its writers closed, and the code after
+      Exec() runs once per worker and once in the parent. Check IsWorker()
+      to do anything only once, e.g. return from main() in the workers.
+      Has to be set before Init().
+   */
+  inline void SetNumberOfWorkers(const unsigned int n_workers) {
+    n_workers_ = n_workers > 0 ? n_workers : 1;
+  }
+  inline unsigned int GetNumberOfWorkers() const { return n_workers_; }
+
+  /** Returns whether this is one of the forked worker processes, see
+      SetNumberOfWorkers. False in the parent and in a run without workers.
+   */
+  inline bool IsWorker() const { return worker_index_ >= 0; }
+
 protected:
   void CompareElementsFromXML();
   void recurseToBuild(std::vector<std::string> &elems, tinyxml2::XMLElement *mElement);
@@ -89,6 +121,10 @@ protected:
 
   void SetPointers();
 
+  void InitWithWorkers();
+  void StartWorkers();
+  void CollectWorkerOutput();
+
   void Show();
   int n_events;
   int n_events_printout;
@@ -96,6 +132,12 @@ protected:
   bool reuse_hydro_;
   unsigned int n_reuse_hydro_;
 
+  unsigned int n_workers_;
+  int worker_index_; // -1 in the parent or a serial run
+  int first_event_;
+  int last_event_;
+  std::vector<pid_t> worker_pids_;
+
   std::shared_ptr<CausalLiquefier> liquefier;
 
   bool
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Record layout shared by JetScapeWriterBinaryStream and JetScapeReader
+
+#ifndef JETSCAPEBINARYFORMAT_H
+#define JETSCAPEBINARYFORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+
+namespace Jetscape {
+
+/**
+   Compact event stream, written and read strictly sequentially so it
+   works through a fifo.
+
+   File header: 4 byte magic, uint32 version, uint32 endianness marker.
+   Then a sequence of records, each a uint8 record type, a uint32 payload
+   length and the payload. Numbers are stored in host byte order, the
+   marker lets the reader refuse files from a machine with a different one.
+   Readers skip records of unknown type, so new types can be added without
+   breaking old readers.
+
+   Payloads (i = int32, d = double):
+   - EventHeader : i event, d sigmaGen, sigmaErr, pTHat, weight,
+                   Npart, Ncoll, TotalEntropy, EventPlaneAngle
+   - PartonShower: i number of vertices, i number of partons
+   - Vertex      : i node id, d x, y, z, t
+   - Parton      : i source node id, i target node id,
+                   i label, pid, status, d px, py, pz, e, x, y, z, t
+   - Hadron      : i label, pid, status, d px, py, pz, e, x, y, z, t, mass
+   - EventEnd    : empty
+ */
+namespace BinaryFormat {
+
+const char Magic[4] = {'\x89', 'J', 'S', 'B'};
+const uint32_t Version = 1;
+const uint32_t EndianMarker = 0x01020304;
+
+enum RecordType : uint8_t {
+  EventHeaderRecord = 1,
+  PartonShowerRecord = 2,
+  VertexRecord = 3,
+  PartonRecord = 4,
+  HadronRecord = 5,
+  EventEndRecord = 6
+};
+
+/// Append the raw bytes of v to a payload buffer
+template <typename V> inline void Pack(std::string &buffer, const V &v) {
+  buffer.append(reinterpret_cast<const char *>(&v), sizeof(V));
+}
+
+/// Sequential reader over a payload, throws on truncated records
+class Unpacker {
+public:
+  Unpacker(const std::string &buffer)
+      : pos(buffer.data()), end(buffer.data() + buffer.size()) {}
+
+  template <typename V> V Get() {
+    if (pos + sizeof(V) > end)
+      throw std::runtime_error("JetScape binary format: truncated record");
+    V v;
+    std::memcpy(&v, pos, sizeof(V));
+    pos += sizeof(V);
+    return v;
+  }
+
+private:
+  const char *pos;
+  const char *end;
+};
+
+} // end namespace BinaryFormat
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEBINARYFORMAT_H
@@ -14,6 +14,10 @@
  ******************************************************************************/
 
 #include <stddef.h>
+#include <pthread.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 
 #include "JetScapeLogger.h"
@@ -87,146 +91,389 @@ int getMemoryUsage()
 
 namespace Jetscape {
 
-std::ostringstream null;
+// --------------------------------
+// Per-thread format buffers
 
-SafeOstream safe_cout(std::cout);
-SafeOstream safe_cerr(std::cerr);
-SafeOstream safe_null(null);
+struct LogStreamer::Buffer : public std::streambuf {
+  Buffer() : stream(this) { text.reserve(256); }
+
+  void Reset() {
+    text.clear();
+    stream.clear();
+    stream.flags(std::ios_base::dec | std::ios_base::skipws);
+    stream.precision(6);
+    stream.width(0);
+    stream.fill(' ');
+  }
+
+  int overflow(int c) override {
+    if (c != traits_type::eof()) {
+      text.push_back(traits_type::to_char_type(c));
+    }
+    return c;
+  }
+
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    text.append(s, n);
+    return n;
+  }
+
+  std::string text; ///< keeps its capacity from one message to the next
+  std::ostream stream;
+};
+
+namespace {
+
+// A message can be formatted while another one of the same thread is
+// still open, e.g. when a function called in a log line logs itself,
+// so every thread has a stack of buffers.
+struct BufferStack {
+  BufferStack() : depth(0) {}
+  std::vector<std::unique_ptr<LogStreamer::Buffer>> buffers;
+  size_t depth;
+};
+
+// A plain pointer, so that it is still usable (null) for messages logged
+// after the thread local objects of the thread were destroyed
+thread_local BufferStack *buffer_stack = nullptr;
+
+struct BufferStackOwner {
+  ~BufferStackOwner() {
+    delete buffer_stack;
+    buffer_stack = nullptr;
+  }
+};
+thread_local BufferStackOwner buffer_stack_owner;
+
+LogStreamer::Buffer *AcquireBuffer() {
+  if (!buffer_stack) {
+    buffer_stack = new BufferStack();
+    (void)&buffer_stack_owner;
+  }
+  BufferStack &stack = *buffer_stack;
+  if (stack.depth == stack.buffers.size()) {
+    stack.buffers.emplace_back(new LogStreamer::Buffer());
+  }
+  LogStreamer::Buffer *buffer = stack.buffers[stack.depth++].get();
+  buffer->Reset();
+  return buffer;
+}
+
+void ReleaseBuffer(LogStreamer::Buffer *buffer) {
+  assert(buffer_stack && buffer_stack->depth > 0 &&
+         buffer_stack->buffers[buffer_stack->depth - 1].get() == buffer);
+  buffer_stack->depth--;
+}
+
+// the flushing thread writes when this much is collected, or every 50 ms
+const size_t flush_size = 1 << 16;
+// producers wait for the flushing thread beyond this
+const size_t max_pending = 1 << 24;
+
+} // namespace
+
+LogStreamer::LogStreamer(const char *color, unsigned long suppressed,
+                         bool urgent)
+    : m_buffer(AcquireBuffer()), m_suppressed(suppressed), m_urgent(urgent) {
+  m_buffer->text += color;
+}
+
+LogStreamer::LogStreamer(LogStreamer &&other)
+    : m_buffer(other.m_buffer), m_suppressed(other.m_suppressed),
+      m_urgent(other.m_urgent) {
+  other.m_buffer = nullptr;
+}
+
+LogStreamer::~LogStreamer() {
+  if (!m_buffer) {
+    return;
+  }
+  if (m_suppressed > 0) {
+    m_buffer->stream << " (+" << m_suppressed
+                     << " similar messages suppressed)";
+  }
+  m_buffer->text += RESET;
+  m_buffer->text += '\n';
+  JetScapeLogger::Instance()->Write(m_buffer->text, m_urgent);
+  ReleaseBuffer(m_buffer);
+}
+
+std::ostream &LogStreamer::Stream() { return m_buffer->stream; }
+
+// --------------------------------
 
 JetScapeLogger *JetScapeLogger::m_pInstance = NULL;
 
 JetScapeLogger *JetScapeLogger::Instance() {
-  if (!m_pInstance)
+  // logging starts on several threads at once
+  static std::once_flag created;
+  std::call_once(created, []() {
     m_pInstance = new JetScapeLogger();
-
+    pthread_atfork(&JetScapeLogger::PrepareFork,
+                   &JetScapeLogger::ParentAfterFork,
+                   &JetScapeLogger::ChildAfterFork);
+  });
   return m_pInstance;
 }
 
-LogStreamer JetScapeLogger::Warn() {
-  string s = "[Warning] ";
+JetScapeLogger::JetScapeLogger()
+    : debug(false), remark(false), info(true), vlevel(0), rate_limit(100),
+      async(true), stop(false), shutdown_registered(false), flush_requests(0),
+      flushes_done(0) {
+  pending.reserve(flush_size);
+}
+
+LogPermit JetScapeLogger::Allow(LogSite &site, bool enabled) {
+  if (!enabled) {
+    return LogPermit(false, 0);
+  }
+  unsigned int limit = rate_limit;
+  if (limit > 0) {
+    long now = std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count();
+    long window = site.window.load();
+    if (window != now && site.window.compare_exchange_strong(window, now)) {
+      site.in_window = 0;
+    }
+    if (site.in_window++ >= limit) {
+      if (site.suppressed++ == 0 && !site.listed.exchange(true)) {
+        std::lock_guard<std::mutex> lock(mtx);
+        suppressing_sites.push_back(&site);
+      }
+      return LogPermit(false, 0);
+    }
+  }
+  return LogPermit(true, site.suppressed.exchange(0));
+}
+
+void JetScapeLogger::Write(const std::string &text, bool urgent) {
+  std::unique_lock<std::mutex> lock(mtx);
+  if (!async || stop) {
+    std::cout.write(text.data(), text.size());
+    std::cout.flush();
+    return;
+  }
+  if (!flusher.joinable()) {
+    flusher = std::thread(&JetScapeLogger::FlushLoop, this);
+    if (!shutdown_registered) {
+      shutdown_registered = true;
+      std::atexit(&JetScapeLogger::Shutdown);
+    }
+  }
+  pending += text;
+  if (urgent || pending.size() > flush_size) {
+    flush_cv.notify_one();
+  }
+  if (pending.size() > max_pending) {
+    done_cv.wait(lock, [this] { return pending.size() <= max_pending; });
+  }
+}
+
+void JetScapeLogger::Flush() {
+  std::unique_lock<std::mutex> lock(mtx);
+  if (!flusher.joinable() || stop) {
+    return;
+  }
+  unsigned long request = ++flush_requests;
+  flush_cv.notify_one();
+  done_cv.wait(lock, [this, request] { return flushes_done >= request; });
+}
+
+void JetScapeLogger::SetAsync(bool m_async) {
+  if (!m_async) {
+    Flush();
+  }
+  std::lock_guard<std::mutex> lock(mtx);
+  async = m_async;
+}
+
+void JetScapeLogger::FlushLoop() {
+  std::string out;
+  out.reserve(flush_size);
+  std::unique_lock<std::mutex> lock(mtx);
+  while (true) {
+    flush_cv.wait_for(lock, std::chrono::milliseconds(50), [this] {
+      return stop || flush_requests != flushes_done ||
+             pending.size() > flush_size;
+    });
+    unsigned long requests = flush_requests;
+    bool stopping = stop;
+    out.swap(pending);
+    lock.unlock();
+    if (!out.empty()) {
+      std::cout.write(out.data(), out.size());
+      std::cout.flush();
+      out.clear();
+    }
+    lock.lock();
+    flushes_done = requests;
+    done_cv.notify_all();
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+void JetScapeLogger::StopFlusher() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!flusher.joinable()) {
+      return;
+    }
+    stop = true;
+  }
+  flush_cv.notify_one();
+  flusher.join();
+  std::lock_guard<std::mutex> lock(mtx);
+  stop = false;
+}
+
+// A forked process only has the thread that called fork(), so the
+// flushing thread is stopped before and started again by the next message,
+// in the parent and in the child. Everything logged so far is written
+// before the fork, so the child does not repeat it.
+void JetScapeLogger::PrepareFork() {
+  m_pInstance->StopFlusher();
+  std::cout.flush();
+  fflush(stdout);
+  m_pInstance->mtx.lock();
+}
+
+void JetScapeLogger::ParentAfterFork() { m_pInstance->mtx.unlock(); }
+
+void JetScapeLogger::ChildAfterFork() {
+  // suppressed messages are reported by the parent
+  for (LogSite *site : m_pInstance->suppressing_sites) {
+    site->suppressed = 0;
+    site->listed = false;
+  }
+  m_pInstance->suppressing_sites.clear();
+  m_pInstance->mtx.unlock();
+}
+
+void JetScapeLogger::Shutdown() {
+  JetScapeLogger *logger = Instance();
+
+  // the thread local buffers may be gone already
+  std::string summary;
+  {
+    std::lock_guard<std::mutex> lock(logger->mtx);
+    for (LogSite *site : logger->suppressing_sites) {
+      unsigned long n = site->suppressed.exchange(0);
+      if (n > 0) {
+        summary += BOLDRED "[Warning] ";
+        summary += to_string(n) + " messages from " + site->file + ":" +
+                   to_string(site->line) + " were suppressed" RESET "\n";
+      }
+    }
+    logger->pending += summary;
+    logger->stop = true;
+  }
+  logger->flush_cv.notify_one();
+  if (logger->flusher.joinable()) {
+    logger->flusher.join();
+  }
+
+  // anything logged while the flushing thread stopped
+  std::lock_guard<std::mutex> lock(logger->mtx);
+  std::cout.write(logger->pending.data(), logger->pending.size());
+  std::cout.flush();
+  logger->pending.clear();
+}
+
+LogStreamer JetScapeLogger::Warn(const LogPermit &permit) {
+  if (!permit.allowed) {
+    return LogStreamer();
+  }
+  LogStreamer log(BOLDRED, permit.suppressed, true);
   //s << __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-  //return LogStreamer(std::cout<<s<<__PRETTY_FUNCTION__ <<":"<<__LINE__<<" ");
-  return LogStreamer(std::cout << BOLDRED << s);
+  log << "[Warning] ";
+  return log;
 }
 
 LogStreamerThread JetScapeLogger::DebugThread() {
-  if (debug) {
-    string s = "[Debug Thread] ";
-    //s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-    s += to_string(getMemoryUsage());
-    s += "MB ";
-    return (LogStreamerThread(safe_cout) << BLUE << s);
-  } else {
-    // check if it is not written in some system log files ...
-    //safe_null.setstate(std::ios_base::failbit);
-    return LogStreamerThread(safe_null);
+  if (!debug) {
+    return LogStreamerThread();
   }
+  LogStreamerThread log(BLUE);
+  log << "[Debug Thread] " << getMemoryUsage() << "MB ";
+  return log;
 }
 
 LogStreamer JetScapeLogger::Debug() {
-  if (debug) {
-    string s = "[Debug] ";
-    //s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-    s += to_string(getMemoryUsage());
-    s += "MB ";
-    return LogStreamer(std::cout << BLUE << s);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (!debug) {
+    return LogStreamer();
   }
+  LogStreamer log(BLUE);
+  log << "[Debug] " << getMemoryUsage() << "MB ";
+  return log;
 }
 
-LogStreamer JetScapeLogger::Info() {
-  string s = "[Info] ";
-  // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-  if (info) {
-    string s = "[Info] ";
-    // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-    s += to_string(getMemoryUsage());
-    s += "MB ";
-    return LogStreamer(std::cout << s);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+LogStreamer JetScapeLogger::Info(const LogPermit &permit) {
+  if (!info || !permit.allowed) {
+    return LogStreamer();
   }
+  LogStreamer log("", permit.suppressed);
+  // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
+  log << "[Info] " << getMemoryUsage() << "MB ";
+  return log;
 }
 
 LogStreamer JetScapeLogger::InfoNice() {
-  string s = "[Info] ";
-  // s <<  __PRETTY_FUNCTION__ <<":"<<__LINE__<<" ";
-  //s += to_string(getMemoryUsage()); s+="MB ";
-  if (info) {
-    return LogStreamer(std::cout << s);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (!info) {
+    return LogStreamer();
   }
+  LogStreamer log("");
+  log << "[Info] ";
+  return log;
 }
 
 LogStreamer JetScapeLogger::Remark() {
-  if (remark) {
-    string s = "[REMARK] ";
-    return LogStreamer(std::cout << BOLDMAGENTA << s);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (!remark) {
+    return LogStreamer();
   }
+  LogStreamer log(BOLDMAGENTA);
+  log << "[REMARK] ";
+  return log;
 }
 
 LogStreamer JetScapeLogger::Verbose(unsigned short m_vlevel) {
-  if (m_vlevel < vlevel) // or if (m_vlevel==vlevel)
-  {
-    string s = "[Verbose][";
-    s += std::to_string(m_vlevel);
-    s += "] ";
-    s += to_string(getMemoryUsage());
-    s += "MB ";
-    return LogStreamer(std::cout << GREEN << s);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (m_vlevel >= vlevel) { // or if (m_vlevel==vlevel)
+    return LogStreamer();
   }
+  LogStreamer log(GREEN);
+  log << "[Verbose][" << m_vlevel << "] " << getMemoryUsage() << "MB ";
+  return log;
 }
 
 LogStreamer JetScapeLogger::VerboseShower(unsigned short m_vlevel) {
-  if (m_vlevel < vlevel) // or if (m_vlevel==vlevel)
-  {
-    string s = "[Verbose][";
-    s += std::to_string(m_vlevel);
-    s += "] ";
-    s += to_string(getMemoryUsage());
-    s += "MB ";
-    return LogStreamer(std::cout << BOLDCYAN << s);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (m_vlevel >= vlevel) { // or if (m_vlevel==vlevel)
+    return LogStreamer();
   }
+  LogStreamer log(BOLDCYAN);
+  log << "[Verbose][" << m_vlevel << "] " << getMemoryUsage() << "MB ";
+  return log;
 }
 
 LogStreamer JetScapeLogger::VerboseParton(unsigned short m_vlevel, Parton &p) {
-  if (m_vlevel < vlevel) // or if (m_vlevel==vlevel)
-  {
-    string s = "[Verbose][";
-    s += std::to_string(m_vlevel);
-    s += "] Parton: ";
-    return LogStreamer(std::cout << GREEN << s << " " << p << endl);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (m_vlevel >= vlevel) { // or if (m_vlevel==vlevel)
+    return LogStreamer();
   }
+  LogStreamer log(GREEN);
+  log << "[Verbose][" << m_vlevel << "] Parton: "
+      << " " << p << "\n";
+  return log;
 }
 
 LogStreamer JetScapeLogger::VerboseVertex(unsigned short m_vlevel, Vertex &v) {
-  if (m_vlevel < vlevel) // or if (m_vlevel==vlevel)
-  {
-    string s = "[Verbose][";
-    s += std::to_string(m_vlevel);
-    s += "] Vertex: ";
-    return LogStreamer(std::cout << GREEN << s << " " << v << endl);
-  } else {
-    null.setstate(std::ios_base::failbit);
-    return LogStreamer(null);
+  if (m_vlevel >= vlevel) { // or if (m_vlevel==vlevel)
+    return LogStreamer();
   }
+  LogStreamer log(GREEN);
+  log << "[Verbose][" << m_vlevel << "] Vertex: "
+      << " " << v << "\n";
+  return log;
 }
 
 } // end namespace Jetscape
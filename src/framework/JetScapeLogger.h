@@ -22,6 +22,11 @@
 #include <iostream>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "JetClass.h"
 
@@ -42,48 +47,72 @@ using std::make_shared;
 
 // define nicer macros to be used for logging ...
 /*
-#define JSINFO  JetScapeLogger::Instance()->Info()<<" " //<<__PRETTY_FUNCTION__<<" : "
-#define INFO_NICE  JetScapeLogger::Instance()->InfoNice()
-#define JSDEBUG JetScapeLogger::Instance()->Debug()<<__PRETTY_FUNCTION__<<" : "
-#define DEBUGTHREAD JetScapeLogger::Instance()->DebugThread()<<__PRETTY_FUNCTION__<<" : "
-#define REMARK JetScapeLogger::Instance()->Remark()<<__PRETTY_FUNCTION__<<" : "
-#define VERBOSE(l) JetScapeLogger::Instance()->Verbose(l)<<__PRETTY_FUNCTION__<<" : "
-#define VERBOSESHOWER(l) JetScapeLogger::Instance()->VerboseShower(l)<<__PRETTY_FUNCTION__<<" : "
-#define VERBOSEPARTON(l,p) JetScapeLogger::Instance()->VerboseParton(l,p)<<__PRETTY_FUNCTION__<<" : "
-#define VERBOSEPVERTEX(l,v) JetScapeLogger::Instance()->VerboseVertex(l,v)<<__PRETTY_FUNCTION__<<" : "
-#define JSWARN JetScapeLogger::Instance()->Warn()<<__PRETTY_FUNCTION__<<" : "
+#define JSINFO  Jetscape::JetScapeLogger::Instance()->Info()<<" " //<<__PRETTY_FUNCTION__<<" : "
+#define INFO_NICE  Jetscape::JetScapeLogger::Instance()->InfoNice()
+#define JSDEBUG Jetscape::JetScapeLogger::Instance()->Debug()<<__PRETTY_FUNCTION__<<" : "
+#define DEBUGTHREAD Jetscape::JetScapeLogger::Instance()->DebugThread()<<__PRETTY_FUNCTION__<<" : "
+#define REMARK Jetscape::JetScapeLogger::Instance()->Remark()<<__PRETTY_FUNCTION__<<" : "
+#define VERBOSE(l) Jetscape::JetScapeLogger::Instance()->Verbose(l)<<__PRETTY_FUNCTION__<<" : "
+#define VERBOSESHOWER(l) Jetscape::JetScapeLogger::Instance()->VerboseShower(l)<<__PRETTY_FUNCTION__<<" : "
+#define VERBOSEPARTON(l,p) Jetscape::JetScapeLogger::Instance()->VerboseParton(l,p)<<__PRETTY_FUNCTION__<<" : "
+#define VERBOSEPVERTEX(l,v) Jetscape::JetScapeLogger::Instance()->VerboseVertex(l,v)<<__PRETTY_FUNCTION__<<" : "
+#define JSWARN Jetscape::JetScapeLogger::Instance()->Warn()<<__PRETTY_FUNCTION__<<" : "
 */
 
 // define nicer macros to be used for logging and check if they should print stuff ...
 // otherwise quite a performance hit ...
+//
+// VERBOSE(l) and its variants with l >= JETSCAPE_MAX_VLEVEL are removed at
+// compile time, as is JSDEBUG for JETSCAPE_MAX_VLEVEL = 0. Production builds
+// can set it with cmake -DJETSCAPE_MAX_VLEVEL=0.
+//
+// JSINFO and JSWARN are rate limited per line of code, see SetRateLimit.
+// They stay expressions: the temporary LogStreamer hands the message to
+// the logger when it is destroyed, and formats nothing when the message is
+// suppressed. Their arguments are evaluated in either case.
+#ifndef JETSCAPE_MAX_VLEVEL
+#define JETSCAPE_MAX_VLEVEL 1000
+#endif
+
+#define JS_LOGGER Jetscape::JetScapeLogger::Instance()
+#define JS_LOG_SITE                                                            \
+  ([]() -> Jetscape::LogSite & {                                               \
+    static Jetscape::LogSite js_log_site(__FILE__, __LINE__);                  \
+    return js_log_site;                                                        \
+  }())
+#define JS_LOG_IF(condition)                                                   \
+  if (!(condition)) {                                                          \
+  } else
+
 #define JSINFO                                                                 \
-  JetScapeLogger::Instance()->Info() << " " //<<__PRETTY_FUNCTION__<<" : "
+  JetScapeLogger::Instance()->Info(                                            \
+      JS_LOGGER->Allow(JS_LOG_SITE, JS_LOGGER->GetInfo()))                     \
+      << " " //<<__PRETTY_FUNCTION__<<" : "
 #define INFO_NICE JetScapeLogger::Instance()->InfoNice()
 #define JSDEBUG                                                                \
-  if (JetScapeLogger::Instance()->GetDebug())                                  \
-  JetScapeLogger::Instance()->Debug() << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF(JETSCAPE_MAX_VLEVEL > 0 && JS_LOGGER->GetDebug())                  \
+  JS_LOGGER->Debug() << __PRETTY_FUNCTION__ << " : "
 #define DEBUGTHREAD                                                            \
-  if (JetScapeLogger::Instance()->GetDebug())                                  \
-  JetScapeLogger::Instance()->DebugThread() << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF(JETSCAPE_MAX_VLEVEL > 0 && JS_LOGGER->GetDebug())                  \
+  JS_LOGGER->DebugThread() << __PRETTY_FUNCTION__ << " : "
 #define REMARK                                                                 \
-  if (JetScapeLogger::Instance()->GetRemark())                                 \
-  JetScapeLogger::Instance()->Remark() << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF(JS_LOGGER->GetRemark())                                            \
+  JS_LOGGER->Remark() << __PRETTY_FUNCTION__ << " : "
 #define VERBOSE(l)                                                             \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->Verbose(l) << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF((l) < JETSCAPE_MAX_VLEVEL && (l) < JS_LOGGER->GetVerboseLevel())   \
+  JS_LOGGER->Verbose(l) << __PRETTY_FUNCTION__ << " : "
 #define VERBOSESHOWER(l)                                                       \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->VerboseShower(l) << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF((l) < JETSCAPE_MAX_VLEVEL && (l) < JS_LOGGER->GetVerboseLevel())   \
+  JS_LOGGER->VerboseShower(l) << __PRETTY_FUNCTION__ << " : "
 #define VERBOSEPARTON(l, p)                                                    \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->VerboseParton(l, p)                              \
-      << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF((l) < JETSCAPE_MAX_VLEVEL && (l) < JS_LOGGER->GetVerboseLevel())   \
+  JS_LOGGER->VerboseParton(l, p) << __PRETTY_FUNCTION__ << " : "
 #define VERBOSEPVERTEX(l, v)                                                   \
-  if (l < JetScapeLogger::Instance()->GetVerboseLevel())                       \
-  JetScapeLogger::Instance()->VerboseVertex(l, v)                              \
-      << __PRETTY_FUNCTION__ << " : "
+  JS_LOG_IF((l) < JETSCAPE_MAX_VLEVEL && (l) < JS_LOGGER->GetVerboseLevel())   \
+  JS_LOGGER->VerboseVertex(l, v) << __PRETTY_FUNCTION__ << " : "
 #define JSWARN                                                                 \
-  JetScapeLogger::Instance()->Warn() << __PRETTY_FUNCTION__ << " : "
+  JetScapeLogger::Instance()->Warn(JS_LOGGER->Allow(JS_LOG_SITE, true))        \
+      << __PRETTY_FUNCTION__ << " : "
 
 namespace Jetscape {
 
@@ -91,99 +120,79 @@ namespace Jetscape {
 class Vertex;
 class Parton;
 
-// -------------------------------------------
-struct SafeOstream {
-  struct GuardedImpl {
-    GuardedImpl() = delete;
-    GuardedImpl(const GuardedImpl &) = delete;
-    void operator=(const GuardedImpl &) = delete;
-    GuardedImpl(std::ostream &ostream, std::mutex &mutex)
-        : Ostream(ostream), Guard(mutex) {}
-    ~GuardedImpl() { Ostream.flush(); }
-    template <typename T> void write(const T &x) { Ostream << x; }
-    std::ostream &Ostream;
-    std::lock_guard<std::mutex> Guard;
-  };
-  struct impl {
-    impl() = delete;
-    void operator=(const impl &) = delete;
-    impl(std::ostream &ostream, std::mutex &mutex)
-        : UniqueImpl(new GuardedImpl(ostream, mutex)) {}
-    impl(const impl &rhs) {
-      assert(rhs.UniqueImpl.get());
-      UniqueImpl.swap(rhs.UniqueImpl);
-    }
-    template <typename T> impl &operator<<(const T &x) {
-      GuardedImpl *p = UniqueImpl.get();
-      assert(p);
-      p->write(x);
-      return *this;
-    }
-    mutable std::unique_ptr<GuardedImpl> UniqueImpl;
-  };
-  explicit SafeOstream(std::ostream &ostream) : Ostream(ostream) {}
-  template <typename T> impl operator<<(const T &x) {
-    return impl(Ostream, mutex_) << x;
-  }
-  std::ostream &Ostream;
-  std::mutex mutex_;
+// --------------------------------
+// State of the rate limit of one JSINFO or JSWARN line
+
+struct LogSite {
+  LogSite(const char *m_file, int m_line)
+      : file(m_file), line(m_line), window(-1), in_window(0), suppressed(0),
+        listed(false) {}
+
+  const char *file;
+  int line;
+  std::atomic<long> window; ///< current one-second window
+  std::atomic<unsigned int> in_window;
+  std::atomic<unsigned long> suppressed; ///< since the last message written
+  std::atomic<bool> listed; ///< known to the logger for the final summary
+};
+
+// Whether a rate limited message may be written, and how many were
+// suppressed before it
+
+struct LogPermit {
+  LogPermit() : allowed(true), suppressed(0) {}
+  LogPermit(bool m_allowed, unsigned long m_suppressed)
+      : allowed(m_allowed), suppressed(m_suppressed) {}
+
+  bool allowed; ///< false if rate limited or switched off
+  unsigned long suppressed;
 };
 
 // --------------------------------
 // Just a helper class to make the interface
 // consistent with << operator
-// In principle simple extension to
-// log into a file ... via m_dest
-// Think about thread safety ...
-// << overload in Parton class not working!? Check ...
+// Formats into a buffer of the calling thread, which is reused for the
+// next message, and hands the finished line to the logger. A default
+// constructed streamer formats nothing.
 
 class LogStreamer {
 
-  shared_ptr<std::ostringstream> m_collector;
-  std::ostream *m_dest;
-
 public:
-  LogStreamer(std::ostream &dest) {
-    m_collector = make_shared<std::ostringstream>();
-    m_dest = &dest;
-  };
-
-  ~LogStreamer() {
-    if (m_collector.unique() && m_dest != nullptr) {
-      //*m_dest << m_collector->str() << RESET << std::endl;
-      *m_dest << m_collector->str() << RESET << std::endl;
-    }
-  }
+  struct Buffer;
+
+  LogStreamer() : m_buffer(nullptr), m_suppressed(0), m_urgent(false) {}
+  explicit LogStreamer(const char *color, unsigned long suppressed = 0,
+                       bool urgent = false);
+  LogStreamer(LogStreamer &&other);
+  LogStreamer(const LogStreamer &) = delete;
+  LogStreamer &operator=(const LogStreamer &) = delete;
+  ~LogStreamer();
 
   template <typename T> LogStreamer &operator<<(T const &value) {
-    *m_collector << value;
+    if (m_buffer) {
+      Stream() << value;
+    }
     return *this;
   }
-};
-
-class LogStreamerThread {
-
-  shared_ptr<std::ostringstream> m_collector;
-  SafeOstream *m_dest;
-
-public:
-  LogStreamerThread(SafeOstream &dest) {
-    m_collector = make_shared<std::ostringstream>();
-    m_dest = &dest;
-  };
-
-  ~LogStreamerThread() {
-    if (m_collector.unique() && m_dest != nullptr) {
-      *m_dest << m_collector->str() << RESET << "\n";
+  // some operator<< of the framework take non-const references
+  template <typename T> LogStreamer &operator<<(T &value) {
+    if (m_buffer) {
+      Stream() << value;
     }
-  }
-
-  template <typename T> LogStreamerThread &operator<<(T const &value) {
-    *m_collector << value;
     return *this;
   }
+
+private:
+  std::ostream &Stream();
+
+  Buffer *m_buffer;
+  unsigned long m_suppressed;
+  bool m_urgent;
 };
 
+// Every streamer is thread safe now
+typedef LogStreamer LogStreamerThread;
+
 // --------------------------------
 
 class JetScapeLogger {
@@ -191,9 +200,9 @@ class JetScapeLogger {
 public:
   static JetScapeLogger *Instance();
 
-  LogStreamer Info();
+  LogStreamer Info(const LogPermit &permit = LogPermit());
   LogStreamer InfoNice();
-  LogStreamer Warn();
+  LogStreamer Warn(const LogPermit &permit = LogPermit());
   LogStreamer Debug();
   LogStreamerThread DebugThread();
   LogStreamer Remark();
@@ -215,20 +224,53 @@ public:
   bool GetInfo() { return info; }
   unsigned short GetVerboseLevel() { return vlevel; }
 
+  /// Messages per second written from one JSINFO or JSWARN line, the
+  /// others are counted and reported with the next one written. 0: no limit
+  void SetRateLimit(unsigned int m_rate_limit) { rate_limit = m_rate_limit; }
+  unsigned int GetRateLimit() { return rate_limit; }
+  LogPermit Allow(LogSite &site, bool enabled);
+
+  /// Asynchronous: messages are collected and written by a background
+  /// thread, at the latest 50 ms later. Otherwise every message is written
+  /// and flushed right away. On by default. The logger can be used on
+  /// both sides of a fork(): what was logged before is written first, and
+  /// the child starts its own background thread.
+  void SetAsync(bool m_async);
+  /// Returns when everything logged so far is written.
+  void Flush();
+
+  /// Hands a finished message to the output.
+  void Write(const std::string &text, bool urgent);
+
 private:
-  JetScapeLogger() {
-    info = true;
-    debug = false;
-    remark = false;
-    vlevel = 0;
-  };
-  JetScapeLogger(JetScapeLogger const &){};
+  JetScapeLogger();
+  JetScapeLogger(JetScapeLogger const &) = delete;
   static JetScapeLogger *m_pInstance;
 
+  void FlushLoop();
+  void StopFlusher();
+  static void Shutdown();
+  static void PrepareFork();
+  static void ParentAfterFork();
+  static void ChildAfterFork();
+
   bool debug;
   bool remark;
   bool info;
   unsigned short vlevel;
+  std::atomic<unsigned int> rate_limit;
+
+  std::mutex mtx;
+  std::condition_variable flush_cv;
+  std::condition_variable done_cv;
+  std::thread flusher;
+  std::string pending;
+  std::vector<LogSite *> suppressing_sites;
+  bool async;
+  bool stop;
+  bool shutdown_registered;
+  unsigned long flush_requests;
+  unsigned long flushes_done;
 };
 
 } // end namespace Jetscape
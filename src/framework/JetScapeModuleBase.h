@@ -83,10 +83,29 @@ public:
    */
   static void IncrementCurrentEvent() { current_event++; }
 
+  /** This function sets the current event number, e.g. for a worker
+      process that starts in the middle of the run.
+   */
+  static void SetCurrentEvent(int m_current_event) {
+    current_event = m_current_event;
+  }
+
   /** This function returns a random number based on Mersenne-Twister algorithm.
    */
   shared_ptr<std::mt19937> GetMt19937Generator();
 
+  /** This function replaces the random number engine, e.g. to give every
+      copy of a module its own reproducible stream.
+   */
+  void SetMt19937Generator(shared_ptr<std::mt19937> m_generator) {
+    mt19937_generator_ = m_generator;
+  }
+
+  /** Drops the random number engine, the next call to
+      GetMt19937Generator() gets one for the current seed.
+   */
+  virtual void Reseed() { mt19937_generator_ = nullptr; }
+
   /** Helper functions for XML parsing, wrapping functionality in JetScapeXML:
    */
   tinyxml2::XMLElement *GetXMLElement(std::initializer_list<const char *> path,
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeParticleData.h"
+#include "JetScapeParticles.h"
+#include "JetScapeLogger.h"
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+
+namespace Jetscape {
+
+const JetScapeParticleData &JetScapeParticleData::Instance() {
+  // built by the first caller, the others wait for it
+  static const JetScapeParticleData table;
+  return table;
+}
+
+JetScapeParticleData::JetScapeParticleData() {
+  Pythia8::ParticleData &pdt =
+      JetScapeParticleBase::InternalHelperPythia.particleData;
+  for (int id = pdt.nextId(0); id != 0; id = pdt.nextId(id)) {
+    Entry e = {id, pdt.m0(id), pdt.charge(id), pdt.isHadron(id),
+               pdt.isParton(id)};
+    entries.push_back(e);
+    if (pdt.isParticle(-id)) {
+      Entry anti = {-id, pdt.m0(-id), pdt.charge(-id), pdt.isHadron(-id),
+                    pdt.isParton(-id)};
+      entries.push_back(anti);
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return a.id < b.id; });
+  VERBOSE(2) << "Particle data table with " << entries.size() << " entries";
+}
+
+const JetScapeParticleData::Entry *JetScapeParticleData::Find(int id) const {
+  auto it = std::lower_bound(
+      entries.begin(), entries.end(), id,
+      [](const Entry &e, int value) { return e.id < value; });
+  if (it == entries.end() || it->id != id) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+double JetScapeParticleData::m0(int id) const {
+  const Entry *e = Find(id);
+  return e ? e->m0 : 0.;
+}
+
+double JetScapeParticleData::charge(int id) const {
+  const Entry *e = Find(id);
+  return e ? e->charge : 0.;
+}
+
+bool JetScapeParticleData::isHadron(int id) const {
+  const Entry *e = Find(id);
+  return e && e->isHadron;
+}
+
+bool JetScapeParticleData::isParton(int id) const {
+  const Entry *e = Find(id);
+  return e && e->isParton;
+}
+
+void JetScapeParticleData::WarnUnknown(int id) {
+  static std::mutex mtx;
+  static std::set<int> warned;
+  std::lock_guard<std::mutex> lock(mtx);
+  if (warned.insert(id).second) {
+    JSWARN << "id = " << id << " is not in the particle data table.";
+  }
+}
+
+} // end namespace Jetscape
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Read-only snapshot of the Pythia particle data table
+
+#ifndef JETSCAPEPARTICLEDATA_H
+#define JETSCAPEPARTICLEDATA_H
+
+#include <vector>
+
+namespace Jetscape {
+
+/**
+   Mass, charge and classification of every particle Pythia knows about,
+   copied once from its default particle data. The table never changes
+   after it is built, so it can be read from any number of threads
+   without locking. Particles constructed by the framework look up their
+   rest mass here instead of going through a shared Pythia object.
+   Unknown ids have mass and charge 0 and are neither hadrons nor partons.
+ */
+class JetScapeParticleData {
+
+public:
+  struct Entry {
+    int id;
+    double m0;
+    double charge;
+    bool isHadron;
+    bool isParton;
+  };
+
+  /// The table, built from Pythia on first use.
+  static const JetScapeParticleData &Instance();
+
+  bool isParticle(int id) const { return Find(id) != nullptr; }
+  double m0(int id) const;
+  double charge(int id) const;
+  bool isHadron(int id) const;
+  bool isParton(int id) const;
+
+  /// nullptr for unknown ids
+  const Entry *Find(int id) const;
+
+  /// Warns once per id that id is not in the table.
+  static void WarnUnknown(int id);
+
+private:
+  JetScapeParticleData();
+
+  std::vector<Entry> entries; ///< sorted by id
+};
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEPARTICLEDATA_H
@@ -22,6 +22,7 @@
 #include <assert.h>
 #include "JetScapeLogger.h"
 #include "JetScapeParticles.h"
+#include "JetScapeParticleData.h"
 #include "JetScapeConstants.h"
 
 namespace Jetscape {
@@ -49,8 +50,8 @@ JetScapeParticleBase::JetScapeParticleBase(int label, int id, int stat,
   set_id(id);
   init_jet_v();
 
-  assert(InternalHelperPythia.particleData.isParticle(id));
-  set_restmass(InternalHelperPythia.particleData.m0(id));
+  assert(JetScapeParticleData::Instance().isParticle(id));
+  set_restmass(JetScapeParticleData::Instance().m0(id));
 
   reset_momentum(pt * cos(phi), pt * sin(phi), pt * sinh(eta), e);
   set_stat(stat);
@@ -76,11 +77,11 @@ JetScapeParticleBase::JetScapeParticleBase(int label, int id, int stat,
   set_id(id);
   init_jet_v();
 
-  assert(InternalHelperPythia.particleData.isParticle(id));
+  assert(JetScapeParticleData::Instance().isParticle(id));
   if ((std::abs(pid()) == 1) || (std::abs(pid()) == 2) || (std::abs(pid()) == 3)) {
         set_restmass(0.0);
   } else {
-        set_restmass(InternalHelperPythia.particleData.m0(id));
+        set_restmass(JetScapeParticleData::Instance().m0(id));
   }
 
   reset_momentum(p);
@@ -255,7 +256,7 @@ Parton::Parton(int label, int id, int stat, const FourVector &p,
                const FourVector &x)
     : JetScapeParticleBase::JetScapeParticleBase(label, id, stat, p, x) {
   CheckAcceptability(id);
-  assert(InternalHelperPythia.particleData.isParton(id) || isPhoton(id));
+  assert(JetScapeParticleData::Instance().isParton(id) || isPhoton(id));
   initialize_form_time();
   set_color(0);
   set_anti_color(0);
@@ -273,7 +274,7 @@ Parton::Parton(int label, int id, int stat, double pt, double eta, double phi,
     : JetScapeParticleBase::JetScapeParticleBase(label, id, stat, pt, eta, phi,
                                                  e, x) {
   CheckAcceptability(id);
-  assert(InternalHelperPythia.particleData.isParton(id) || isPhoton(id));
+  assert(JetScapeParticleData::Instance().isParton(id) || isPhoton(id));
   initialize_form_time();
   set_color(0);
   set_anti_color(0);
@@ -480,7 +481,8 @@ Hadron::Hadron(int label, int id, int stat, const FourVector &p,
 }
 
 bool Hadron::CheckOrForceHadron(const int id, const double mass) {
-  bool status = InternalHelperPythia.particleData.isHadron(id);
+  const JetScapeParticleData &pdt = JetScapeParticleData::Instance();
+  bool status = pdt.isHadron(id);
   if (status)
     return true;
 
@@ -488,12 +490,9 @@ bool Hadron::CheckOrForceHadron(const int id, const double mass) {
   // particles. Particularly leptons and gammas are the point here.
   // TODO: Handle non-partonic non-hadrons more gracefully
 
-  // -- Add unknown particles
-  if (!InternalHelperPythia.particleData.isParticle(
-          id)) { // avoid doing it over and over
-    JSWARN << "id = " << id << " is not recognized as a hadron! "
-           << "Add it as a new type of particle.";
-    InternalHelperPythia.particleData.addParticle(id, " ", 0, 0, 0, mass, 0.1);
+  // -- Accept unknown particles with the mass they were given
+  if (!pdt.isParticle(id)) {
+    JetScapeParticleData::WarnUnknown(id);
   }
 
   // -- now all that's left is known non-hadrons. We'll just accept those.
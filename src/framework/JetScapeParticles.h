@@ -272,6 +272,8 @@ public:
   // Be a bit careful with it!
   // Init is never called, and this object is not configured. All it can do is look up
   // in its original Data table
+  // It is only read to build JetScapeParticleData, use that for lookups
+  // from several threads
   static Pythia8::Pythia InternalHelperPythia;
 
 protected:
@@ -293,6 +295,8 @@ protected:
   // Be a bit careful with it!
   // Init is never called, and this object is not configured. All it can do is look up
   // in its original Data table
+  // It is only read to build JetScapeParticleData, use that for lookups
+  // from several threads
   //static Pythia8::Pythia InternalHelperPythia;
 
   /// check whether a module claimed responsibility of this particle
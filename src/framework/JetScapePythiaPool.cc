@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapePythiaPool.h"
+#include "JetScapeLogger.h"
+#include "JetScapeThreadPool.h"
+
+#include <random>
+#include <stdexcept>
+
+namespace Jetscape {
+
+JetScapePythiaPool::Lease::Lease(JetScapePythiaPool *pool_,
+                                 unsigned int index_, Pythia8::Pythia *pythia_)
+    : pool(pool_), index(index_), pythia(pythia_) {}
+
+JetScapePythiaPool::Lease::Lease(Lease &&other)
+    : pool(other.pool), index(other.index), pythia(other.pythia) {
+  other.pool = nullptr;
+}
+
+JetScapePythiaPool::Lease::~Lease() {
+  if (pool) {
+    pool->Release(index);
+  }
+}
+
+JetScapePythiaPool::JetScapePythiaPool() {}
+
+JetScapePythiaPool::~JetScapePythiaPool() {}
+
+void JetScapePythiaPool::ReadString(const std::string &setting) {
+  std::lock_guard<std::mutex> lock(mtx);
+  settings.push_back(setting);
+}
+
+void JetScapePythiaPool::Init(unsigned int n_instances) {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (char l : leased) {
+    if (l) {
+      throw std::runtime_error(
+          "JetScapePythiaPool::Init called while an instance is leased");
+    }
+  }
+  instances.clear();
+  if (n_instances < 1) {
+    n_instances = 1;
+  }
+  leased.assign(n_instances, 0);
+
+  // reading the settings is cheap, init() is not
+  for (unsigned int i = 0; i < n_instances; i++) {
+    instances.push_back(NewInstance(i));
+  }
+  std::vector<char> ok(n_instances, 0);
+  JetScapeThreadPool init_pool(n_instances);
+  init_pool.RunAndWait(n_instances,
+                       [this, &ok](int i) { ok[i] = instances[i]->init(); });
+  for (unsigned int i = 0; i < n_instances; i++) {
+    if (!ok[i]) {
+      JSWARN << "Pythia instance " << i << " failed to initialize";
+    }
+  }
+  VERBOSE(2) << "Initialized " << n_instances << " Pythia instance(s)";
+}
+
+JetScapePythiaPool::Lease JetScapePythiaPool::Acquire(unsigned int index) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (index >= instances.size()) {
+    throw std::out_of_range("JetScapePythiaPool: no instance " +
+                            std::to_string(index) + ", only " +
+                            std::to_string(instances.size()) +
+                            " made by Init");
+  }
+  // two callers on one instance would share its event record
+  if (leased[index]) {
+    throw std::runtime_error("JetScapePythiaPool: instance " +
+                             std::to_string(index) + " is leased already");
+  }
+  leased[index] = 1;
+  return Lease(this, index, instances[index].get());
+}
+
+void JetScapePythiaPool::Release(unsigned int index) {
+  std::lock_guard<std::mutex> lock(mtx);
+  leased[index] = 0;
+}
+
+unsigned int JetScapePythiaPool::GetNumberOfInstances() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return instances.size();
+}
+
+std::unique_ptr<Pythia8::Pythia>
+JetScapePythiaPool::NewInstance(unsigned int index) const {
+  std::unique_ptr<Pythia8::Pythia> pythia(
+      new Pythia8::Pythia("IntentionallyEmpty", false));
+  for (const auto &s : settings) {
+    pythia->readString(s);
+  }
+
+  OffsetSeed(*pythia, index);
+  return pythia;
+}
+
+void JetScapePythiaPool::Reseed(unsigned int seed) {
+  std::lock_guard<std::mutex> lock(mtx);
+  settings.push_back("Random:setSeed = on");
+  settings.push_back("Random:seed = " + std::to_string(seed));
+  for (unsigned int i = 0; i < instances.size(); i++) {
+    Pythia8::Pythia &pythia = *instances[i];
+    pythia.readString(settings[settings.size() - 2]);
+    pythia.readString(settings.back());
+    OffsetSeed(pythia, i);
+    pythia.rndm.init(pythia.settings.mode("Random:seed"));
+  }
+}
+
+void JetScapePythiaPool::OffsetSeed(Pythia8::Pythia &pythia,
+                                    unsigned int index) {
+  // identical seeds would give every instance the same events
+  if (index > 0) {
+    const int max_seed = 900000000; // largest seed Pythia accepts
+    int seed = 19780503;            // Pythia's default seed
+    if (pythia.settings.flag("Random:setSeed")) {
+      int configured = pythia.settings.mode("Random:seed");
+      if (configured > 0) {
+        seed = configured;
+      } else if (configured == 0) {
+        // time-based, which is the same for instances made together
+        seed = std::random_device{}() % max_seed;
+      }
+    }
+    seed = 1 + (seed - 1 + index) % max_seed;
+    pythia.readString("Random:setSeed = on");
+    pythia.readString("Random:seed = " + std::to_string(seed));
+  }
+}
+
+} // end namespace Jetscape
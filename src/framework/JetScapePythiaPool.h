@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Identically configured Pythia instances, leased by index
+
+#ifndef JETSCAPEPYTHIAPOOL_H
+#define JETSCAPEPYTHIAPOOL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Pythia8/Pythia.h"
+
+namespace Jetscape {
+
+/**
+   Holds Pythia instances that all read the same settings. They are
+   initialized together in Init, in parallel, so that the cost of
+   Pythia::init() is paid once at startup and never while hadronizing.
+   Callers lease an instance by an index they own, e.g. their worker or
+   thread pool slot, so the same caller always gets the same instance and
+   random numbers no matter which thread asks first. Instance 0 keeps the
+   configured random seed, the others have it offset by their index, or
+   drawn from std::random_device if the seed is time-based
+   (Random:seed = 0).
+ */
+class JetScapePythiaPool {
+
+public:
+  /// Use of one instance, it is given back to the pool on destruction.
+  class Lease {
+  public:
+    Lease(Lease &&other);
+    ~Lease();
+
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+    Lease &operator=(Lease &&) = delete;
+
+    Pythia8::Pythia &operator*() const { return *pythia; }
+    Pythia8::Pythia *operator->() const { return pythia; }
+    unsigned int GetIndex() const { return index; }
+
+  private:
+    friend class JetScapePythiaPool;
+    Lease(JetScapePythiaPool *pool, unsigned int index,
+          Pythia8::Pythia *pythia);
+
+    JetScapePythiaPool *pool;
+    unsigned int index;
+    Pythia8::Pythia *pythia;
+  };
+
+  JetScapePythiaPool();
+  ~JetScapePythiaPool();
+
+  JetScapePythiaPool(const JetScapePythiaPool &) = delete;
+  JetScapePythiaPool &operator=(const JetScapePythiaPool &) = delete;
+
+  /// Setting passed to Pythia::readString of every instance, in the order
+  /// given. Only takes effect for instances made by a later Init.
+  void ReadString(const std::string &setting);
+
+  /// Drops all instances and initializes n_instances (at least one) new ones.
+  /// No instance may be leased at that time.
+  void Init(unsigned int n_instances);
+
+  /// Restarts the random numbers of all instances from seed, offset by
+  /// their index as in Init. For forked processes that share the
+  /// initialized instances.
+  void Reseed(unsigned int seed);
+
+  /// Instance index until the lease is destroyed. Throws
+  /// std::out_of_range past the instances made by Init, and
+  /// std::runtime_error if the instance is leased already.
+  Lease Acquire(unsigned int index);
+
+  unsigned int GetNumberOfInstances();
+
+private:
+  std::unique_ptr<Pythia8::Pythia> NewInstance(unsigned int index) const;
+  static void OffsetSeed(Pythia8::Pythia &pythia, unsigned int index);
+  void Release(unsigned int index);
+
+  std::vector<std::string> settings;
+  std::vector<std::unique_ptr<Pythia8::Pythia>> instances;
+  std::vector<char> leased;
+  std::mutex mtx;
+};
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEPYTHIAPOOL_H
@@ -106,6 +106,8 @@ void JetScapeSignalManager::ConnectGetHydroCellSignal(
     auto hp = GetHydroPointer().lock();
     if (hp) {
       j->GetHydroCellSignal.connect(hp.get(), &FluidDynamics::GetHydroCell);
+      j->GetHydroCellsSignal.connect(hp.get(), &FluidDynamics::GetHydroCells);
+      j->SetMediumHandle(hp->GetMediumHandle());
       j->SetGetHydroCellSignalConnected(true);
       GetHydroCellSignal_map.emplace(num_GetHydroCellSignals,
                                      (weak_ptr<JetEnergyLoss>)j);
@@ -50,6 +50,13 @@ void JetScapeTask::InitTasks() {
     it->Init();
 }
 
+void JetScapeTask::ReseedTasks() {
+  for (auto it : tasks) {
+    it->Reseed();
+    it->ReseedTasks();
+  }
+}
+
 void JetScapeTask::Exec() { VERBOSE(7); }
 
 void JetScapeTask::ExecuteTasks() {
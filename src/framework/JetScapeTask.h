@@ -82,6 +82,23 @@ public:
   */
   virtual void InitTasks();
 
+  /** Called in a forked worker process, for tasks that were initialized
+      before the fork, once the worker's random seed is set. Tasks that keep
+      random engines or seeded generators of their own re-seed them here.
+   */
+  virtual void Reseed(){};
+
+  /** Recursively calls Reseed() on all the subtasks of a JetScapeTask.
+   */
+  virtual void ReseedTasks();
+
+  /** Tasks whose initialization cannot be shared by forked worker processes,
+      e.g. because it uses up the random seed, return true. They are then
+      initialized in every worker instead of once before forking. Checked
+      for the tasks attached to JetScape directly.
+   */
+  virtual bool InitInWorkers() const { return false; }
+
   // really decide and think what is the best way (workflow ...)
   /** Recursively calls Clear() function of the subtasks of a JetScapeTask.
    */
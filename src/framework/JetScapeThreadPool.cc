@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeThreadPool.h"
+
+namespace Jetscape {
+
+JetScapeThreadPool::JetScapeThreadPool(unsigned int n_threads)
+    : current_job(nullptr), n_jobs(0), next_job(0), n_busy(0),
+      generation(0), stop(false) {
+  for (unsigned int i = 1; i < n_threads; i++) {
+    workers.push_back(std::thread(&JetScapeThreadPool::WorkerLoop, this));
+  }
+}
+
+JetScapeThreadPool::~JetScapeThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stop = true;
+  }
+  start_cv.notify_all();
+  for (auto &t : workers) {
+    t.join();
+  }
+}
+
+void JetScapeThreadPool::RunAndWait(int m_n_jobs,
+                                    const std::function<void(int)> &job) {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    current_job = &job;
+    n_jobs = m_n_jobs;
+    next_job = 0;
+    error = nullptr;
+    generation++;
+  }
+  start_cv.notify_all();
+
+  Work();
+
+  std::exception_ptr job_error;
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    done_cv.wait(lock, [this] { return n_busy == 0; });
+    current_job = nullptr;
+    job_error = error;
+    error = nullptr;
+  }
+  if (job_error) {
+    std::rethrow_exception(job_error);
+  }
+}
+
+void JetScapeThreadPool::WorkerLoop() {
+  unsigned long seen = 0;
+  std::unique_lock<std::mutex> lock(mtx);
+  while (true) {
+    start_cv.wait(lock, [this, &seen] { return stop || generation != seen; });
+    if (stop) {
+      return;
+    }
+    seen = generation;
+    n_busy++;
+    lock.unlock();
+    Work();
+    lock.lock();
+    n_busy--;
+    if (n_busy == 0) {
+      done_cv.notify_all();
+    }
+  }
+}
+
+void JetScapeThreadPool::Work() {
+  while (true) {
+    const std::function<void(int)> *job = nullptr;
+    int i = 0;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (!current_job || next_job >= n_jobs) {
+        return;
+      }
+      job = current_job;
+      i = next_job++;
+    }
+    try {
+      (*job)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+}
+
+} // end namespace Jetscape
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// Fixed-size thread pool for running independent jobs of one event
+
+#ifndef JETSCAPETHREADPOOL_H
+#define JETSCAPETHREADPOOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Jetscape {
+
+/**
+   Runs job(0) ... job(n-1) on a fixed set of threads and waits for all
+   of them. The calling thread works on the jobs as well, so a pool of
+   size 1 starts no thread at all. Jobs are handed out in index order,
+   but may finish in any order; anything that has to be ordered must be
+   collected per index by the caller.
+ */
+class JetScapeThreadPool {
+
+public:
+  explicit JetScapeThreadPool(unsigned int n_threads);
+  ~JetScapeThreadPool();
+
+  JetScapeThreadPool(const JetScapeThreadPool &) = delete;
+  JetScapeThreadPool &operator=(const JetScapeThreadPool &) = delete;
+
+  unsigned int GetNumberOfThreads() const { return workers.size() + 1; }
+
+  /// Runs all jobs and returns when they are done. The first exception
+  /// thrown by a job is rethrown here, after all other jobs finished.
+  void RunAndWait(int n_jobs, const std::function<void(int)> &job);
+
+private:
+  void WorkerLoop();
+  void Work();
+
+  std::vector<std::thread> workers;
+  std::mutex mtx;
+  std::condition_variable start_cv;
+  std::condition_variable done_cv;
+
+  const std::function<void(int)> *current_job;
+  int n_jobs;
+  int next_job;
+  int n_busy;
+  unsigned long generation;
+  bool stop;
+  std::exception_ptr error;
+};
+
+} // end namespace Jetscape
+
+#endif // JETSCAPETHREADPOOL_H
@@ -63,6 +63,14 @@ public:
 
   virtual JetScapeEventHeader &GetHeader() { return header; };
 
+  /// True if AppendWorkerOutput is implemented, required to run with
+  /// several worker processes (see JetScape::SetNumberOfWorkers)
+  virtual bool SupportsWorkerOutput() { return false; }
+
+  /// Appends the events a worker process wrote to file_name with a writer
+  /// of the same type. Called in event order, between Init and Close.
+  virtual void AppendWorkerOutput(string file_name){};
+
 protected:
   string file_name_out;
   JetScapeEventHeader header;
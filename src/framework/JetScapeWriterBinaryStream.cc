@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// jetscape writer binary class
+
+#include "JetScapeWriterBinaryStream.h"
+#include "JetScapeLogger.h"
+
+namespace Jetscape {
+
+// Register the modules with the base class
+template <>
+RegisterJetScapeModule<JetScapeWriterBinaryStream<ofstream>>
+    JetScapeWriterBinaryStream<ofstream>::reg("JetScapeWriterBinary");
+template <>
+RegisterJetScapeModule<JetScapeWriterBinaryStream<ogzstream>>
+    JetScapeWriterBinaryStream<ogzstream>::regGZ("JetScapeWriterBinaryGZ");
+
+template <class T>
+JetScapeWriterBinaryStream<T>::JetScapeWriterBinaryStream(string m_file_name_out) {
+  SetOutputFileName(m_file_name_out);
+}
+
+template <class T> JetScapeWriterBinaryStream<T>::~JetScapeWriterBinaryStream() {
+  VERBOSE(8);
+  if (GetActive())
+    Close();
+}
+
+template <class T>
+void JetScapeWriterBinaryStream<T>::WriteRecord(BinaryFormat::RecordType type) {
+  uint8_t t = type;
+  uint32_t length = buffer.size();
+  output_file.write(reinterpret_cast<const char *>(&t), sizeof(t));
+  output_file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+  output_file.write(buffer.data(), buffer.size());
+  buffer.clear();
+}
+
+template <class T>
+void JetScapeWriterBinaryStream<T>::PackParticle(JetScapeParticleBase &p) {
+  BinaryFormat::Pack<int32_t>(buffer, p.plabel());
+  BinaryFormat::Pack<int32_t>(buffer, p.pid());
+  BinaryFormat::Pack<int32_t>(buffer, p.pstat());
+  BinaryFormat::Pack<double>(buffer, p.px());
+  BinaryFormat::Pack<double>(buffer, p.py());
+  BinaryFormat::Pack<double>(buffer, p.pz());
+  BinaryFormat::Pack<double>(buffer, p.e());
+  BinaryFormat::Pack<double>(buffer, p.x_in().x());
+  BinaryFormat::Pack<double>(buffer, p.x_in().y());
+  BinaryFormat::Pack<double>(buffer, p.x_in().z());
+  BinaryFormat::Pack<double>(buffer, p.x_in().t());
+}
+
+template <class T> void JetScapeWriterBinaryStream<T>::WriteHeaderToFile() {
+  VERBOSE(3) << "Run JetScapeWriterBinaryStream<T>: Write header of event # "
+             << GetCurrentEvent() << " ...";
+
+  BinaryFormat::Pack<int32_t>(buffer, GetCurrentEvent());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetSigmaGen());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetSigmaErr());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetPtHat());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetEventWeight());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetNpart());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetNcoll());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetTotalEntropy());
+  BinaryFormat::Pack<double>(buffer, GetHeader().GetEventPlaneAngle());
+  WriteRecord(BinaryFormat::EventHeaderRecord);
+}
+
+template <class T> void JetScapeWriterBinaryStream<T>::WriteEvent() {
+  WriteRecord(BinaryFormat::EventEndRecord);
+  // Complete events only, a reader on a fifo should not wait for the next one
+  output_file.flush();
+}
+
+template <class T>
+void JetScapeWriterBinaryStream<T>::Write(weak_ptr<PartonShower> ps) {
+  auto pShower = ps.lock();
+  if (!pShower)
+    return;
+
+  BinaryFormat::Pack<int32_t>(buffer, pShower->GetNumberOfVertices());
+  BinaryFormat::Pack<int32_t>(buffer, pShower->GetNumberOfPartons());
+  WriteRecord(BinaryFormat::PartonShowerRecord);
+
+  PartonShower::node_iterator nIt, nEnd;
+  for (nIt = pShower->nodes_begin(), nEnd = pShower->nodes_end(); nIt != nEnd;
+       ++nIt) {
+    auto v = pShower->GetVertex(*nIt);
+    BinaryFormat::Pack<int32_t>(buffer, nIt->id());
+    BinaryFormat::Pack<double>(buffer, v->x_in().x());
+    BinaryFormat::Pack<double>(buffer, v->x_in().y());
+    BinaryFormat::Pack<double>(buffer, v->x_in().z());
+    BinaryFormat::Pack<double>(buffer, v->x_in().t());
+    WriteRecord(BinaryFormat::VertexRecord);
+  }
+
+  PartonShower::edge_iterator eIt, eEnd;
+  for (eIt = pShower->edges_begin(), eEnd = pShower->edges_end(); eIt != eEnd;
+       ++eIt) {
+    BinaryFormat::Pack<int32_t>(buffer, eIt->source().id());
+    BinaryFormat::Pack<int32_t>(buffer, eIt->target().id());
+    PackParticle(*pShower->GetParton(*eIt));
+    WriteRecord(BinaryFormat::PartonRecord);
+  }
+}
+
+template <class T> void JetScapeWriterBinaryStream<T>::Write(weak_ptr<Hadron> h) {
+  auto hh = h.lock();
+  if (hh) {
+    PackParticle(*hh);
+    BinaryFormat::Pack<double>(buffer, hh->restmass());
+    WriteRecord(BinaryFormat::HadronRecord);
+  }
+}
+
+template <class T> void JetScapeWriterBinaryStream<T>::Init() {
+  if (GetActive()) {
+    JSINFO << "JetScape Binary Stream Writer initialized with output file = "
+           << GetOutputFileName();
+    output_file.open(GetOutputFileName().c_str(),
+                     std::ios::out | std::ios::binary);
+
+    output_file.write(BinaryFormat::Magic, sizeof(BinaryFormat::Magic));
+    output_file.write(reinterpret_cast<const char *>(&BinaryFormat::Version),
+                      sizeof(BinaryFormat::Version));
+    output_file.write(reinterpret_cast<const char *>(&BinaryFormat::EndianMarker),
+                      sizeof(BinaryFormat::EndianMarker));
+  }
+}
+
+template <class T>
+void JetScapeWriterBinaryStream<T>::AppendWorkerOutput(string file_name) {
+  std::ifstream in(file_name.c_str(), std::ios::in | std::ios::binary);
+  if (!in.good())
+    throw std::runtime_error("Cannot open worker output " + file_name);
+  // Skip the file header, this file already has one
+  in.seekg(sizeof(BinaryFormat::Magic) + sizeof(BinaryFormat::Version) +
+           sizeof(BinaryFormat::EndianMarker));
+  if (in.peek() != std::ifstream::traits_type::eof())
+    output_file << in.rdbuf();
+}
+
+template <class T> void JetScapeWriterBinaryStream<T>::Exec() {
+  // Nothing to do, the modules handle this
+}
+
+template class JetScapeWriterBinaryStream<ofstream>;
+
+#ifdef USE_GZIP
+template class JetScapeWriterBinaryStream<ogzstream>;
+#endif
+
+} // end namespace Jetscape
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+// jetscape writer binary class
+
+#ifndef JETSCAPEWRITERBINARYSTREAM_H
+#define JETSCAPEWRITERBINARYSTREAM_H
+
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#ifdef USE_GZIP
+#include "gzstream.h"
+#endif
+
+#include "JetScapeWriter.h"
+#include "JetScapeBinaryFormat.h"
+
+using std::ofstream;
+
+namespace Jetscape {
+
+/**
+   Writes events in the compact binary format described in
+   JetScapeBinaryFormat.h. Same content as JetScapeWriterStream, but
+   without any number formatting. Can be read back with JetScapeReader,
+   which detects the format automatically.
+ */
+template <class T> class JetScapeWriterBinaryStream : public JetScapeWriter {
+
+public:
+  JetScapeWriterBinaryStream<T>(){};
+  JetScapeWriterBinaryStream<T>(string m_file_name_out);
+  virtual ~JetScapeWriterBinaryStream<T>();
+
+  void Init();
+  void Exec();
+
+  bool GetStatus() { return output_file.good(); }
+  void Close() { output_file.close(); }
+
+  bool SupportsWorkerOutput() { return std::is_same<T, ofstream>::value; }
+  void AppendWorkerOutput(string file_name);
+
+  void Write(weak_ptr<PartonShower> ps);
+  void Write(weak_ptr<Hadron> h);
+  void WriteHeaderToFile();
+  void WriteEvent();
+
+protected:
+  T output_file; //!< Output file
+  string buffer; //!< Payload of the current record, reused
+
+  void WriteRecord(BinaryFormat::RecordType type);
+  void PackParticle(JetScapeParticleBase &p);
+
+  // Allows the registration of the module so that it is available to be used by the Jetscape framework.
+  static RegisterJetScapeModule<JetScapeWriterBinaryStream<ofstream>> reg;
+  static RegisterJetScapeModule<JetScapeWriterBinaryStream<ogzstream>> regGZ;
+};
+
+typedef JetScapeWriterBinaryStream<ofstream> JetScapeWriterBinary;
+#ifdef USE_GZIP
+typedef JetScapeWriterBinaryStream<ogzstream> JetScapeWriterBinaryGZ;
+#endif
+
+} // end namespace Jetscape
+
+#endif // JETSCAPEWRITERBINARYSTREAM_H
@@ -20,6 +20,9 @@
 #include "JetScapeLogger.h"
 #include "JetScapeXML.h"
 
+#include <cmath>
+#include <sstream>
+
 namespace Jetscape {
 
 // Register the modules with the base class
@@ -150,6 +153,39 @@ template <class T> void JetScapeWriterFinalStateStream<T>::Close() {
     output_file.close();
 }
 
+template <class T>
+void JetScapeWriterFinalStateStream<T>::AppendWorkerOutput(string file_name) {
+  std::ifstream in(file_name.c_str());
+  if (!in.good())
+    throw std::runtime_error("Cannot open worker output " + file_name);
+
+  // Skip the file header, copy the events and pick up the xsec line.
+  // The xsec is averaged over workers, weighted by their number of events.
+  std::string line;
+  std::getline(in, line);
+  int n_events = 0;
+  double sigma = 0, err = 0;
+  while (std::getline(in, line)) {
+    if (line.compare(0, 10, "#\tsigmaGen") == 0) {
+      std::istringstream ss(line);
+      std::string tag;
+      ss >> tag >> tag >> sigma >> tag >> err;
+      continue;
+    }
+    if (line.compare(0, 7, "#\tEvent") == 0)
+      n_events++;
+    output_file << line << "\n";
+  }
+
+  worker_events += n_events;
+  worker_sigma_sum += n_events * sigma;
+  worker_err2_sum += n_events * n_events * err * err;
+  if (worker_events > 0) {
+    GetHeader().SetSigmaGen(worker_sigma_sum / worker_events);
+    GetHeader().SetSigmaErr(std::sqrt(worker_err2_sum) / worker_events);
+  }
+}
+
 template class JetScapeWriterFinalStatePartonsStream<ofstream>;
 template class JetScapeWriterFinalStateHadronsStream<ofstream>;
 
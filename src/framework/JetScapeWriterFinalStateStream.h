@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <string>
+#include <type_traits>
 
 #ifdef USE_GZIP
 #include "gzstream.h"
@@ -49,6 +50,10 @@ public:
   // Close is utilized to add the xsec and error.
   void Close();
 
+  bool SupportsWorkerOutput() { return std::is_same<T, ofstream>::value; }
+  // Merges the per-worker xsec into the one written by Close
+  void AppendWorkerOutput(string file_name);
+
   void Write(weak_ptr<PartonShower> ps);
   void Write(weak_ptr<Hadron> h);
   // We aren't interested in the individual partons or vertices, so skip them.
@@ -65,6 +70,11 @@ public:
 protected:
   T output_file; //!< Output file
   std::vector<std::shared_ptr<JetScapeParticleBase>> particles;
+
+  // Worker output merged so far, to average the xsec
+  int worker_events = 0;
+  double worker_sigma_sum = 0;
+  double worker_err2_sum = 0;
 };
 
 template <class T>
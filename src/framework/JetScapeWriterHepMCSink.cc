@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeWriterHepMCSink.h"
+#include "JetScapeLogger.h"
+#include "HardProcess.h"
+#include "JetScapeSignalManager.h"
+#include "GTL/node.h"
+
+namespace Jetscape {
+
+JetScapeHepMCConsumerFactory::map_type
+    *JetScapeHepMCConsumerFactory::consumerMap;
+
+RegisterJetScapeHepMCConsumer<HepMCEventCounter>
+    HepMCEventCounter::reg("HepMCEventCounter");
+
+void HepMCEventCounter::Analyze(const HepMC3::GenEvent &evt) {
+  n_events++;
+  for (auto p : evt.particles()) {
+    if (p->status() == 1)
+      n_final++;
+  }
+}
+
+void HepMCEventCounter::Finish() {
+  JSINFO << "HepMCEventCounter: " << n_events << " events with "
+         << n_final << " final state particles";
+}
+
+JetScapeWriterHepMCSink::~JetScapeWriterHepMCSink() {
+  if (GetActive())
+    Close();
+}
+
+void JetScapeWriterHepMCSink::WriteGenEvent(shared_ptr<HepMC3::GenEvent> evt) {
+  for (auto c : consumers)
+    c->Analyze(*evt);
+}
+
+void JetScapeWriterHepMCSink::Close() {
+  if (closed)
+    return;
+  for (auto c : consumers)
+    c->Finish();
+  closed = true;
+}
+
+void JetScapeWriterHepMCSink::Init() {
+  if (GetActive()) {
+    // Consumers can be attached in the run macro or picked by name
+    std::string consumerName =
+        GetXMLElementText({"JetScapeWriterHepMCSinkConsumer"}, false);
+    std::stringstream names(consumerName);
+    std::string name;
+    while (names >> name) {
+      auto c = JetScapeHepMCConsumerFactory::createInstance(name);
+      if (!c) {
+        JSWARN << "Unknown HepMC consumer " << name;
+        throw std::runtime_error("Unknown HepMC consumer");
+      }
+      AddConsumer(c);
+    }
+
+    JSINFO << "JetScape HepMC Sink Writer initialized with "
+           << consumers.size() << " in-process consumer(s)";
+    if (consumers.empty()) {
+      JSWARN << "JetScapeWriterHepMCSink has no consumer, events are dropped";
+    }
+    for (auto c : consumers)
+      c->Init();
+  }
+}
+
+void JetScapeWriterHepMCSink::Exec() {
+  // Nothing to do
+}
+} // end namespace Jetscape
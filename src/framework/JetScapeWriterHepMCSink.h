@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef JETSCAPEWRITERHEPMCSINK_H
+#define JETSCAPEWRITERHEPMCSINK_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "JetScapeWriterHepMCBase.h"
+
+#include "HepMC3/GenEvent.h"
+
+namespace Jetscape {
+
+/**
+ * @class JetScapeHepMCConsumer
+ * @brief In-process receiver of the HepMC3 events built by JetScapeWriterHepMCSink.
+ *
+ * Analyze() sees the event in memory, nothing is serialized. The event is
+ * only valid during the call, a consumer that needs it later has to copy it.
+ * A Rivet AnalysisHandler can be wrapped by forwarding Analyze() to analyze().
+ */
+class JetScapeHepMCConsumer {
+
+public:
+  virtual ~JetScapeHepMCConsumer(){};
+
+  /// Called once from JetScapeWriterHepMCSink::Init()
+  virtual void Init(){};
+  /// Called once per event from JetScapeWriterHepMCSink::WriteEvent()
+  virtual void Analyze(const HepMC3::GenEvent &evt) = 0;
+  /// Called once when the writer is closed
+  virtual void Finish(){};
+};
+
+/// Factory for consumers, mirrors JetScapeModuleFactory so that consumers
+/// can be picked by name from the XML.
+class JetScapeHepMCConsumerFactory {
+public:
+  virtual ~JetScapeHepMCConsumerFactory() {}
+
+  typedef std::map<std::string, shared_ptr<JetScapeHepMCConsumer> (*)()>
+      map_type;
+
+  /// Creates an instance of a consumer based on the name if the name is registered in the map.
+  static shared_ptr<JetScapeHepMCConsumer> createInstance(std::string const &s) {
+    map_type::iterator it = getMap()->find(s);
+    if (it == getMap()->end()) {
+      return nullptr;
+    }
+    return it->second();
+  }
+
+protected:
+  static map_type *getMap() {
+    // Never deleted, same reasoning as JetScapeModuleFactory
+    if (!consumerMap) {
+      consumerMap = new map_type;
+    }
+    return consumerMap;
+  }
+
+private:
+  static map_type *consumerMap;
+};
+
+template <typename T> shared_ptr<JetScapeHepMCConsumer> createConsumerT() {
+  return std::make_shared<T>();
+}
+
+/// Registers consumers in the factory map
+template <typename T>
+class RegisterJetScapeHepMCConsumer : public JetScapeHepMCConsumerFactory {
+public:
+  RegisterJetScapeHepMCConsumer(std::string const &s) {
+    getMap()->insert(std::make_pair(s, &createConsumerT<T>));
+  }
+};
+
+/**
+ * @class HepMCEventCounter
+ * @brief Minimal consumer, counts events and final state particles.
+ */
+class HepMCEventCounter : public JetScapeHepMCConsumer {
+
+public:
+  void Analyze(const HepMC3::GenEvent &evt);
+  void Finish();
+
+  unsigned long GetNumberOfEvents() const { return n_events; }
+  unsigned long GetNumberOfFinalParticles() const { return n_final; }
+
+private:
+  unsigned long n_events = 0;
+  unsigned long n_final = 0;
+
+  static RegisterJetScapeHepMCConsumer<HepMCEventCounter> reg;
+};
+
+/**
+ * @class JetScapeWriterHepMCSink
+ * @brief Passes the HepMC3 event built by JetScapeWriterHepMCBase directly
+ * to in-process consumers instead of writing text.
+ */
+class JetScapeWriterHepMCSink : public JetScapeWriterHepMCBase {
+
+public:
+  JetScapeWriterHepMCSink() { SetId("HepMC sink writer"); };
+  JetScapeWriterHepMCSink(string m_file_name_out)
+      : JetScapeWriterHepMCBase(m_file_name_out) {
+    SetId("HepMC sink writer");
+  };
+  virtual ~JetScapeWriterHepMCSink();
+
+  void Init();
+  void Exec();
+
+  // same as failed() of the file writers, nothing is written that could fail
+  bool GetStatus() { return false; }
+  /// Calls Finish() of every consumer, once
+  void Close();
+
+  /// Attach a consumer, can be called from the run macro before Init()
+  void AddConsumer(shared_ptr<JetScapeHepMCConsumer> c) {
+    consumers.push_back(c);
+  }
+  const vector<shared_ptr<JetScapeHepMCConsumer>> &GetConsumers() const {
+    return consumers;
+  }
+
+protected:
+  void WriteGenEvent(shared_ptr<HepMC3::GenEvent> evt);
+
+private:
+  vector<shared_ptr<JetScapeHepMCConsumer>> consumers;
+  bool closed = false;
+};
+
+} // end namespace Jetscape
+
+#endif
\ No newline at end of file
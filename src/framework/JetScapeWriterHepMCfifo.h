@@ -3,6 +3,11 @@
 
 #include <fstream>
 #include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
@@ -11,8 +16,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
-#include "JetScapeWriter.h"
-#include "PartonShower.h"
+#include "JetScapeWriterHepMCBase.h"
 
 #include "HepMC3/GenEvent.h"
 #include "HepMC3/ReaderAscii.h"
@@ -20,13 +24,6 @@
 #include "HepMC3/Print.h"
 
 
-// using namespace HepMC;
-using HepMC3::GenEvent;
-using HepMC3::GenVertex;
-using HepMC3::GenParticle;
-using HepMC3::GenVertexPtr;
-using HepMC3::GenParticlePtr;
-
 // using namespace Jetscape;
 using namespace std;
 
@@ -35,12 +32,13 @@ using namespace std;
 namespace Jetscape {
 
 
-class JetScapeWriterHepMCfifo : public JetScapeWriter, public HepMC3::WriterAscii {
+class JetScapeWriterHepMCfifo : public JetScapeWriterHepMCBase,
+                                public HepMC3::WriterAscii {
 
 public:
   JetScapeWriterHepMCfifo() : HepMC3::WriterAscii("") { SetId("HepMCfifio writer"); };
   JetScapeWriterHepMCfifo(string m_file_name_out)
-     : JetScapeWriter(m_file_name_out), HepMC3::WriterAscii(m_file_name_out) {
+     : JetScapeWriterHepMCBase(m_file_name_out), HepMC3::WriterAscii(m_file_name_out) {
     SetId("HepMfifo writer");
     if(mkfifo(GetOutputFileName().c_str(), 0666) < 0) {
       if(errno != EEXIST) {
@@ -56,66 +54,49 @@ public:
   void Exec();
 
   bool GetStatus() { return failed(); }
-  void Close() { close(); }
+  void Close();
  
   // void Open() { open(); }
-  // // NEVER use this!
-  // // Can work with only one writer, but with a second one it gets called twice
-  // void WriteTask(weak_ptr<JetScapeWriter> w);
 
-  // overload write functions
-  void WriteEvent();
+  /** Number of finished events that may wait for the serializer thread.
+      0 (default) writes synchronously on the simulation thread.
+      Has to be set before Init() if not taken from the XML.
+   */
+  void SetQueueDepth(unsigned int m_queue_depth) { queue_depth = m_queue_depth; }
+  unsigned int GetQueueDepth() const { return queue_depth; }
+
+  /// Largest number of events seen waiting in the queue
+  unsigned int GetQueueHighWaterMark() const { return queue_high_water_mark; }
+  /// Number of times WriteEvent() had to wait for a free queue slot
+  unsigned long GetNumberOfStalls() const { return n_stalls; }
+  /// Total time [s] WriteEvent() spent waiting for a free queue slot
+  double GetStallTime() const { return stall_time.count(); }
 
-  // At parton level, we should never accept anything other than a full shower
-  // void Write(weak_ptr<Vertex> v);
-  void Write(weak_ptr<PartonShower> ps);
-  void Write(weak_ptr<Hadron> h);
-  void WriteHeaderToFile();
+protected:
+  void WriteGenEvent(shared_ptr<HepMC3::GenEvent> evt);
 
 private:
-  HepMC3::GenEvent evt;
-  vector<HepMC3::GenVertexPtr> vertices;
-  HepMC3::GenVertexPtr hadronizationvertex;
   // static RegisterJetScapeModule<JetScapeWriterHepMCfifo> reg;
-  /// WriteEvent needs to know whether it should overwrite final partons status to 1
-  bool hashadrons=false; 
-  
-  inline HepMC3::GenVertexPtr
-  castVtxToHepMC(const shared_ptr<Vertex> vtx) const {
-    double x = vtx->x_in().x();
-    double y = vtx->x_in().y();
-    double z = vtx->x_in().z();
-    double t = vtx->x_in().t();
-    HepMC3::FourVector vtxPosition(x, y, z, t);
-    // if ( t< 1e-6 ) t = 1e-6; // could do this. Exact 0 is bit quirky but works for hepmc
-    return make_shared<GenVertex>(vtxPosition);
-  }
-
-  inline HepMC3::GenParticlePtr
-  castPartonToHepMC(const shared_ptr<Parton> pparticle) const {
-    return castPartonToHepMC(*pparticle);
-  }
-
-  inline HepMC3::GenParticlePtr
-  castPartonToHepMC(const Parton &particle) const {
-    HepMC3::FourVector pmom(particle.px(), particle.py(), particle.pz(),
-                            particle.e());
-    return make_shared<GenParticle>(pmom, particle.pid(), particle.pstat());
-  }
-
-  inline HepMC3::GenParticlePtr
-  castHadronToHepMC(const shared_ptr<Hadron> pparticle) const {
-    return castHadronToHepMC(*pparticle);
-  }
-
-  inline HepMC3::GenParticlePtr
-  castHadronToHepMC(const Hadron &particle) const {
-    HepMC3::FourVector pmom(particle.px(), particle.py(), particle.pz(),
-                            particle.e());
-    return make_shared<GenParticle>(pmom, particle.pid(), particle.pstat());
-  }
-
-  //int m_precision; //!< Output precision
+
+  // Asynchronous output. The simulation thread hands finished events
+  // to a serializer thread, the fifo reader only throttles that thread
+  // until the bounded queue is full.
+  void StartSerializer();
+  void StopSerializer();
+  void SerializerLoop();
+
+  unsigned int queue_depth = 0;
+  std::deque<shared_ptr<HepMC3::GenEvent>> event_queue;
+  std::mutex queue_mutex;
+  std::condition_variable queue_not_empty;
+  std::condition_variable queue_not_full;
+  std::thread serializer;
+  bool serializer_running = false;
+  bool closed = false;
+
+  unsigned int queue_high_water_mark = 0;
+  unsigned long n_stalls = 0;
+  std::chrono::duration<double> stall_time{0};
 };
 
 } // end namespace Jetscape
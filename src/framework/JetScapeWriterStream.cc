@@ -109,6 +109,16 @@ template <class T> void JetScapeWriterStream<T>::Init() {
   }
 }
 
+template <class T>
+void JetScapeWriterStream<T>::AppendWorkerOutput(string file_name) {
+  std::ifstream in(file_name.c_str());
+  if (!in.good())
+    throw std::runtime_error("Cannot open worker output " + file_name);
+  // No preamble, the worker file is all event data
+  if (in.peek() != std::ifstream::traits_type::eof())
+    output_file << in.rdbuf();
+}
+
 template <class T> void JetScapeWriterStream<T>::Exec() {
   // JSINFO<<"Run JetScapeWriterStream<T>: Write event # "<<GetCurrentEvent()<<" ...";
 
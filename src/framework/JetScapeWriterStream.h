@@ -20,6 +20,7 @@
 
 #include <fstream>
 #include <string>
+#include <type_traits>
 
 #ifdef USE_GZIP
 #include "gzstream.h"
@@ -44,6 +45,9 @@ public:
   bool GetStatus() { return output_file.good(); }
   void Close() { output_file.close(); }
 
+  bool SupportsWorkerOutput() { return std::is_same<T, ofstream>::value; }
+  void AppendWorkerOutput(string file_name);
+
   void WriteInitFileXMLMain();
   void WriteInitFileXMLUser();
 
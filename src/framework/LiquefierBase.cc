@@ -14,6 +14,8 @@
  ******************************************************************************/
 #include "LiquefierBase.h"
 #include <math.h>
+#include <algorithm>
+#include <limits>
 
 namespace Jetscape {
 
@@ -21,27 +23,129 @@ LiquefierBase::LiquefierBase()
     : hydro_source_abs_err(1e-10), drop_stat(-11), miss_stat(-13),
       neg_stat(-17) {
   GetHydroCellSignalConnected = false;
+  grid_dtau = 1.0;
+  grid_dxy = 2.0;
+  grid_deta = 0.5;
+  droplet_tau_min = std::numeric_limits<Jetscape::real>::max();
+}
+
+void LiquefierBase::kernel_delay_range(Jetscape::real &delay_min,
+                                       Jetscape::real &delay_max) const {
+  delay_min = 0.0;
+  delay_max = std::numeric_limits<Jetscape::real>::max();
+}
+
+// Buckets are clamped to 16 bits per coordinate, far outside any medium
+static int GridIndex(double v, double width) {
+  double i = std::floor(v / width);
+  return static_cast<int>(std::max(-32768.0, std::min(32767.0, i)));
+}
+
+uint64_t LiquefierBase::droplet_grid_key(int itau, int ix, int iy,
+                                         int ieta) const {
+  return (uint64_t(itau + 32768) << 48) | (uint64_t(ix + 32768) << 32) |
+         (uint64_t(iy + 32768) << 16) | uint64_t(ieta + 32768);
+}
+
+void LiquefierBase::index_droplet(int idx) {
+  const auto x_drop = dropletlist[idx].get_xmu();
+  droplet_grid[droplet_grid_key(GridIndex(x_drop[0], grid_dtau),
+                                GridIndex(x_drop[1], grid_dxy),
+                                GridIndex(x_drop[2], grid_dxy),
+                                GridIndex(x_drop[3], grid_deta))]
+      .push_back(idx);
+  droplet_tau_min = std::min(droplet_tau_min, x_drop[0]);
+}
+
+void LiquefierBase::set_droplet_grid(Jetscape::real dtau, Jetscape::real dxy,
+                                     Jetscape::real deta) {
+  grid_dtau = dtau;
+  grid_dxy = dxy;
+  grid_deta = deta;
+  droplet_grid.clear();
+  for (int i = 0; i < dropletlist.size(); i++)
+    index_droplet(i);
+}
+
+void LiquefierBase::add_droplet_source(const Droplet &drop_i,
+                                       Jetscape::real tau, Jetscape::real x,
+                                       Jetscape::real y, Jetscape::real eta,
+                                       std::array<Jetscape::real, 4> &jmu) const {
+  const auto x_drop = drop_i.get_xmu();
+  double ds2 = tau * tau + x_drop[0] * x_drop[0] -
+               2.0 * tau * x_drop[0] * cosh(eta - x_drop[3]) -
+               (x - x_drop[1]) * (x - x_drop[1]) -
+               (y - x_drop[2]) * (y - x_drop[2]);
+
+  if (tau >= x_drop[0] && ds2 >= 0.0) {
+    std::array<Jetscape::real, 4> jmu_i = {0.0, 0.0, 0.0, 0.0};
+    smearing_kernel(tau, x, y, eta, drop_i, jmu_i);
+    for (int i = 0; i < 4; i++)
+      jmu[i] += jmu_i[i];
+  }
 }
 
 void LiquefierBase::get_source(Jetscape::real tau, Jetscape::real x,
                                Jetscape::real y, Jetscape::real eta,
                                std::array<Jetscape::real, 4> &jmu) const {
   jmu = {0.0, 0.0, 0.0, 0.0};
-  for (const auto &drop_i : dropletlist) {
+  if (dropletlist.empty())
+    return;
 
-    const auto x_drop = drop_i.get_xmu();
-    double ds2 = tau * tau + x_drop[0] * x_drop[0] -
-                 2.0 * tau * x_drop[0] * cosh(eta - x_drop[3]) -
-                 (x - x_drop[1]) * (x - x_drop[1]) -
-                 (y - x_drop[2]) * (y - x_drop[2]);
-
-    if (tau >= x_drop[0] && ds2 >= 0.0) {
-      std::array<Jetscape::real, 4> jmu_i = {0.0, 0.0, 0.0, 0.0};
-      smearing_kernel(tau, x, y, eta, drop_i, jmu_i);
-      for (int i = 0; i < 4; i++)
-        jmu[i] += jmu_i[i];
-    }
+  // Droplets that can contribute have tau_lo <= tau_drop <= tau_hi. Inside
+  // the light cone |dx_perp| <= tau - tau_drop and
+  // cosh(eta - eta_drop) <= (tau^2 + tau_drop^2)/(2 tau tau_drop), both
+  // largest for the earliest droplet. The margin absorbs rounding.
+  const double margin = 1e-3;
+  Jetscape::real delay_min, delay_max;
+  kernel_delay_range(delay_min, delay_max);
+  double tau_lo = std::max(double(tau) - delay_max, double(droplet_tau_min));
+  double tau_hi = double(tau) - std::max(double(delay_min), 0.0);
+  if (tau_lo > tau_hi + margin)
+    return;
+  tau_lo = std::max(tau_lo - margin, 0.0);
+  tau_hi += margin;
+  double reach_xy = tau - tau_lo + margin;
+  double reach_eta = std::numeric_limits<double>::max();
+  if (tau_lo > 0.0 && tau > 0.0)
+    reach_eta = std::acosh((double(tau) * tau + tau_lo * tau_lo) /
+                           (2.0 * tau * tau_lo)) +
+                margin;
+
+  const int itau0 = GridIndex(tau_lo, grid_dtau);
+  const int itau1 = GridIndex(tau_hi, grid_dtau);
+  const int ix0 = GridIndex(x - reach_xy, grid_dxy);
+  const int ix1 = GridIndex(x + reach_xy, grid_dxy);
+  const int iy0 = GridIndex(y - reach_xy, grid_dxy);
+  const int iy1 = GridIndex(y + reach_xy, grid_dxy);
+  const int ieta0 = GridIndex(eta - reach_eta, grid_deta);
+  const int ieta1 = GridIndex(eta + reach_eta, grid_deta);
+
+  // with more buckets than droplets the plain loop is cheaper
+  double n_buckets = double(itau1 - itau0 + 1) * (ix1 - ix0 + 1) *
+                     (iy1 - iy0 + 1) * (ieta1 - ieta0 + 1);
+  if (n_buckets > dropletlist.size()) {
+    for (const auto &drop_i : dropletlist)
+      add_droplet_source(drop_i, tau, x, y, eta, jmu);
+    return;
   }
+
+  static thread_local std::vector<int> candidates;
+  candidates.clear();
+  for (int itau = itau0; itau <= itau1; itau++)
+    for (int ix = ix0; ix <= ix1; ix++)
+      for (int iy = iy0; iy <= iy1; iy++)
+        for (int ieta = ieta0; ieta <= ieta1; ieta++) {
+          auto bucket =
+              droplet_grid.find(droplet_grid_key(itau, ix, iy, ieta));
+          if (bucket != droplet_grid.end())
+            candidates.insert(candidates.end(), bucket->second.begin(),
+                              bucket->second.end());
+        }
+  // same summation order as over the whole list
+  std::sort(candidates.begin(), candidates.end());
+  for (int idx : candidates)
+    add_droplet_source(dropletlist[idx], tau, x, y, eta, jmu);
 }
 
 //! This function check the energy momentum conservation at the vertex
@@ -216,7 +320,11 @@ void LiquefierBase::add_hydro_sources(std::vector<Parton> &pIn,
   }
 }
 
-void LiquefierBase::Clear() { dropletlist.clear(); }
+void LiquefierBase::Clear() {
+  dropletlist.clear();
+  droplet_grid.clear();
+  droplet_tau_min = std::numeric_limits<Jetscape::real>::max();
+}
 
 Jetscape::real LiquefierBase::get_dropletlist_total_energy() const {
   Jetscape::real total_E = 0.0;
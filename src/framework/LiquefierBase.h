@@ -21,6 +21,8 @@
 #include "FluidCellInfo.h"
 
 #include <array>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include "RealType.h"
 
@@ -54,11 +56,34 @@ private:
   const int neg_stat;
   const Jetscape::real hydro_source_abs_err;
 
+  // Droplet indices bucketed in (tau, x, y, eta), in insertion order
+  // within each bucket, so that get_source() only visits droplets that
+  // can reach a cell
+  std::unordered_map<uint64_t, std::vector<int>> droplet_grid;
+  Jetscape::real grid_dtau, grid_dxy, grid_deta;
+  Jetscape::real droplet_tau_min;
+
+  uint64_t droplet_grid_key(int itau, int ix, int iy, int ieta) const;
+  void index_droplet(int idx);
+  void add_droplet_source(const Droplet &drop_i, Jetscape::real tau,
+                          Jetscape::real x, Jetscape::real y,
+                          Jetscape::real eta,
+                          std::array<Jetscape::real, 4> &jmu) const;
+
+protected:
+  /** Bucket sizes of the droplet index, best of the order of the kernel
+      support. Only affects the speed of get_source(). */
+  void set_droplet_grid(Jetscape::real dtau, Jetscape::real dxy,
+                        Jetscape::real deta);
+
 public:
   LiquefierBase();
   ~LiquefierBase() { Clear(); }
 
-  void add_a_droplet(Droplet droplet_in) { dropletlist.push_back(droplet_in); }
+  void add_a_droplet(Droplet droplet_in) {
+    dropletlist.push_back(droplet_in);
+    index_droplet(dropletlist.size() - 1);
+  }
 
   int get_drop_stat() const { return (drop_stat); }
   int get_miss_stat() const { return (miss_stat); }
@@ -96,6 +121,16 @@ public:
     jmu = {0, 0, 0, 0};
   }
 
+  /** Range of tau - tau_drop outside of which smearing_kernel() vanishes.
+      get_source() skips the droplets outside of it; the default only
+      requires the droplet to lie in the past. */
+  virtual void kernel_delay_range(Jetscape::real &delay_min,
+                                  Jetscape::real &delay_max) const;
+
+  /** Sum of smearing_kernel() over all droplets whose forward light cone
+      contains the cell. Only droplets in the buckets the cell can be
+      reached from are visited, in the order they were added, so the
+      result is identical to summing over the whole list. */
   void get_source(Jetscape::real tau, Jetscape::real x, Jetscape::real y,
                   Jetscape::real eta, std::array<Jetscape::real, 4> &jmu) const;
 
@@ -17,7 +17,10 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <stdexcept>
+#include <GTL/topsort.h>
 #include "MakeUniqueHelper.h"
+#include "ShowerArena.h"
 
 using std::setprecision;
 using std::fixed;
@@ -32,15 +35,131 @@ PartonShower::PartonShower() : graph() { VERBOSESHOWER(8); }
 node PartonShower::new_vertex(shared_ptr<Vertex> v) {
   node n = graph::new_node();
   vMap[n] = v;
+  AddToOrder(n);
   return n;
 }
 
 int PartonShower::new_parton(node s, node t, shared_ptr<Parton> p) {
   edge e = graph::new_edge(s, t);
   pMap[e] = p;
+  AddToOrder(e);
   return e.id();
 }
 
+node PartonShower::new_vertex(const Vertex &v) {
+  if (!arena)
+    arena = ShowerArena::Acquire();
+  node n = graph::new_node();
+  vMap[n] = shared_ptr<Vertex>(arena, arena->vertices.Create(v));
+  AddToOrder(n);
+  return n;
+}
+
+int PartonShower::new_parton(node s, node t, const Parton &p) {
+  if (!arena)
+    arena = ShowerArena::Acquire();
+  edge e = graph::new_edge(s, t);
+  pMap[e] = shared_ptr<Parton>(arena, arena->partons.Create(p));
+  AddToOrder(e);
+  return e.id();
+}
+
+void PartonShower::AddToOrder(node n) {
+  if ((int)vOrder.size() + 1 != number_of_nodes()) {
+    SyncOrder();
+    return;
+  }
+  vIndex[n] = vOrder.size();
+  vIsLateRoot[n] = false;
+  vOrder.push_back(n);
+  vSortedValid = false;
+}
+
+void PartonShower::AddToOrder(edge e) {
+  if ((int)vOrder.size() != number_of_nodes() ||
+      (int)pOrder.size() + 1 != number_of_edges()) {
+    SyncOrder();
+    return;
+  }
+  node s = e.source();
+  node t = e.target();
+  if (vOrderTopological) {
+    if (vIsLateRoot[t]) {
+      // a late root that stops being a root can't simply be moved up front
+      vOrderTopological = false;
+    } else if (vIndex[s] >= vIndex[t]) {
+      if (s.indeg() > 0) {
+        vOrderTopological = false;
+      } else if (!vIsLateRoot[s]) {
+        vIsLateRoot[s] = true;
+        vLateRoots.push_back(s);
+      }
+    }
+  }
+  pIndex[e] = pOrder.size();
+  pOrder.push_back(e);
+  vSortedValid = false;
+}
+
+// Rebuilds the creation order if nodes or edges were added behind our back
+// (graph::load() and friends), in which case only a full sort is safe
+void PartonShower::SyncOrder() {
+  if ((int)vOrder.size() == number_of_nodes() &&
+      (int)pOrder.size() == number_of_edges())
+    return;
+
+  vOrder.clear();
+  pOrder.clear();
+  vLateRoots.clear();
+  node_iterator nIt, nEnd;
+  for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt) {
+    vIndex[*nIt] = vOrder.size();
+    vIsLateRoot[*nIt] = false;
+    vOrder.push_back(*nIt);
+  }
+  edge_iterator eIt, eEnd;
+  for (eIt = edges_begin(), eEnd = edges_end(); eIt != eEnd; ++eIt) {
+    pIndex[*eIt] = pOrder.size();
+    pOrder.push_back(*eIt);
+  }
+  vOrderTopological = false;
+  vSortedValid = false;
+}
+
+const vector<node> &PartonShower::GetOrderedVertices() {
+  SyncOrder();
+  if (vOrderTopological && vLateRoots.empty())
+    return vOrder;
+
+  if (!vSortedValid) {
+    vSorted.clear();
+    vSorted.reserve(vOrder.size());
+    if (vOrderTopological) {
+      vSorted = vLateRoots;
+      for (auto &n : vOrder) {
+        if (!vIsLateRoot[n])
+          vSorted.push_back(n);
+      }
+    } else {
+      if (!is_acyclic())
+        throw std::runtime_error("PROBLEM in PartonShower: Graph is not acyclic.");
+      topsort topsortsearch;
+      topsortsearch.scan_whole_graph(true);
+      topsortsearch.start_node(); // defaults to first node
+      topsortsearch.run(*this);
+      vSorted.assign(topsortsearch.top_order_begin(),
+                     topsortsearch.top_order_end());
+    }
+    vSortedValid = true;
+  }
+  return vSorted;
+}
+
+const vector<edge> &PartonShower::GetOrderedPartons() {
+  SyncOrder();
+  return pOrder;
+}
+
 /*
 void PartonShower::FillPartonVec()
 {
@@ -185,7 +304,8 @@ shared_ptr<Vertex> PartonShower::GetVertexAt(int n) {
 
 PartonShower::~PartonShower() {
   VERBOSESHOWER(8);
-  pFinal.clear(); //pVec.clear();vVec.clear();
+  // graph::~graph() calls clear(), but no longer our pre_clear_handler()
+  pre_clear_handler();
 }
 
 void PartonShower::save_node_info_handler(ostream *o, node n) const {
@@ -221,6 +341,16 @@ void PartonShower::pre_clear_handler() {
   for (nIt = nodes_begin(), nEnd = nodes_end(); nIt != nEnd; ++nIt) {
     vMap[*nIt] = nullptr;
   }
+
+  pFinal.clear(); //pVec.clear();vVec.clear();
+  ShowerArena::Release(arena);
+
+  vOrder.clear();
+  pOrder.clear();
+  vLateRoots.clear();
+  vOrderTopological = true;
+  vSorted.clear();
+  vSortedValid = false;
 }
 
 void PartonShower::PrintNodes(bool verbose) {
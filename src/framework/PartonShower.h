@@ -33,6 +33,7 @@ namespace Jetscape {
 // and after transformer class. TBD ...
 class Vertex;
 class Parton;
+class ShowerArena;
 
 class PartonShower : public graph {
 
@@ -43,6 +44,11 @@ public:
   node new_vertex(shared_ptr<Vertex> v);
   int new_parton(node s, node t, shared_ptr<Parton> p);
 
+  // Same as above, but v and p are copied into the shower's arena instead
+  // of being allocated one by one. The returned pointers work the same.
+  node new_vertex(const Vertex &v);
+  int new_parton(node s, node t, const Parton &p);
+
   shared_ptr<Vertex> GetVertex(node n) { return vMap[n]; }
   shared_ptr<Parton> GetParton(edge e) { return pMap[e]; }
 
@@ -52,6 +58,18 @@ public:
   node GetNodeAt(int n);
   edge GetEdgeAt(int n);
 
+  // Vertices in topological order (a parton's source before its target)
+  // and partons in creation order. Showers built with new_vertex() and
+  // new_parton() stay in that order while they grow, so this costs nothing;
+  // anything else (e.g. a shower loaded from GML) is sorted once on demand.
+  const vector<node> &GetOrderedVertices();
+  const vector<edge> &GetOrderedPartons();
+
+  // Dense index of a vertex or parton in creation order,
+  // in [0, GetNumberOfVertices()) and [0, GetNumberOfPartons())
+  int GetVertexIndex(node n) { return vIndex[n]; }
+  int GetPartonIndex(edge e) { return pIndex[e]; }
+
   int GetNumberOfParents(int n);
   int GetNumberOfChilds(int n);
 
@@ -87,6 +105,28 @@ private:
 
   vector<shared_ptr<Parton>> pFinal;
 
+  // storage of the partons and vertices added by value, recycled after
+  // clear() once nobody outside holds on to them
+  shared_ptr<ShowerArena> arena;
+
+  void AddToOrder(node n);
+  void AddToOrder(edge e);
+  void SyncOrder();
+
+  vector<node> vOrder;
+  vector<edge> pOrder;
+  node_map<int> vIndex;
+  edge_map<int> pIndex;
+
+  // roots created after the vertex they feed, e.g. for negative partons;
+  // they only have to be moved to the front to keep the order topological
+  vector<node> vLateRoots;
+  node_map<bool> vIsLateRoot;
+  bool vOrderTopological = true;
+
+  vector<node> vSorted;
+  bool vSortedValid = false;
+
   //Check map data format (pointer to edge/node !??)
   //map<weak_ptr<Parton>, edge> pToEdgeMap;
   //map<weak_ptr<Vertex>, node> vToNodeMap;
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "ShowerArena.h"
+
+namespace Jetscape {
+
+// a few are enough to cover the showers one thread has alive at a time
+static const std::size_t MaxFreeArenas = 8;
+
+// Showers can outlive the thread local list at thread or program exit,
+// after that arenas are simply freed
+static thread_local bool free_arenas_destroyed = false;
+
+struct FreeArenaList {
+  std::vector<std::shared_ptr<ShowerArena>> arenas;
+  ~FreeArenaList() { free_arenas_destroyed = true; }
+};
+
+static std::vector<std::shared_ptr<ShowerArena>> *FreeArenas() {
+  if (free_arenas_destroyed)
+    return nullptr;
+  static thread_local FreeArenaList free_arenas;
+  return &free_arenas.arenas;
+}
+
+std::shared_ptr<ShowerArena> ShowerArena::Acquire() {
+  auto free_arenas = FreeArenas();
+  if (!free_arenas || free_arenas->empty())
+    return std::make_shared<ShowerArena>();
+  auto arena = std::move(free_arenas->back());
+  free_arenas->pop_back();
+  return arena;
+}
+
+void ShowerArena::Release(std::shared_ptr<ShowerArena> &arena) {
+  auto free_arenas = FreeArenas();
+  // Nobody else can take a new reference once ours is the only one
+  if (arena && arena.use_count() == 1 && free_arenas &&
+      free_arenas->size() < MaxFreeArenas) {
+    arena->partons.Clear();
+    arena->vertices.Clear();
+    free_arenas->push_back(std::move(arena));
+  }
+  arena.reset();
+}
+
+std::size_t ShowerArena::NumberOfFreeArenas() {
+  auto free_arenas = FreeArenas();
+  return free_arenas ? free_arenas->size() : 0;
+}
+
+} // end namespace Jetscape
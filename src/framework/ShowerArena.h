@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ * 
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+// Pooled storage for the partons and vertices of a PartonShower
+
+#ifndef SHOWERARENA_H
+#define SHOWERARENA_H
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "JetClass.h"
+
+namespace Jetscape {
+
+/** Objects of type T constructed in place in fixed-size chunks. Addresses
+    stay valid until Clear(), which destroys the objects but keeps the
+    chunks for the next use.
+  */
+template <class T> class ObjectPool {
+public:
+  ObjectPool() : n_used(0) {}
+  ~ObjectPool() { Clear(); }
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  template <class... Args> T *Create(Args &&... args) {
+    std::size_t chunk = n_used / ChunkSize;
+    if (chunk == chunks.size())
+      chunks.emplace_back(new Storage[ChunkSize]);
+    T *obj = new (&chunks[chunk][n_used % ChunkSize])
+        T(std::forward<Args>(args)...);
+    n_used++;
+    return obj;
+  }
+
+  void Clear() {
+    while (n_used > 0) {
+      n_used--;
+      reinterpret_cast<T *>(&chunks[n_used / ChunkSize][n_used % ChunkSize])
+          ->~T();
+    }
+  }
+
+  std::size_t Size() const { return n_used; }
+  std::size_t Capacity() const { return chunks.size() * ChunkSize; }
+
+private:
+  static const std::size_t ChunkSize = 256;
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+  std::vector<std::unique_ptr<Storage[]>> chunks;
+  std::size_t n_used;
+};
+
+/** Partons and vertices of one shower. The shared_ptrs handed out by
+    PartonShower point into the arena and share its ownership, so the
+    arena lives as long as any of them. Arenas no longer referenced are
+    kept per thread and reused by the next shower.
+  */
+class ShowerArena {
+public:
+  ObjectPool<Parton> partons;
+  ObjectPool<Vertex> vertices;
+
+  /** @return A cleared arena, recycled if one is available. */
+  static std::shared_ptr<ShowerArena> Acquire();
+
+  /** Drops the reference in arena. If it was the last one the arena is
+      cleared and kept for Acquire().
+    */
+  static void Release(std::shared_ptr<ShowerArena> &arena);
+
+  /** Number of arenas kept for reuse by the calling thread. */
+  static std::size_t NumberOfFreeArenas();
+};
+
+} // end namespace Jetscape
+
+#endif // SHOWERARENA_H
@@ -14,18 +14,21 @@
  ******************************************************************************/
 // This is a general basic class for a hyper-surface finder
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include "RealType.h"
 #include "SurfaceFinder.h"
 #include "cornelius.h"
 #include "FluidEvolutionHistory.h"
 #include "JetScapeLogger.h"
+#include "JetScapeThreadPool.h"
 
 namespace Jetscape {
 
 SurfaceFinder::SurfaceFinder(const Jetscape::real T_in,
                              const EvolutionHistory &bulk_data)
-    : bulk_info(bulk_data) {
+    : bulk_info(bulk_data), n_threads(1) {
 
   T_cut = T_in;
   JSINFO << "Find a surface with temperature T = " << T_cut;
@@ -40,6 +43,35 @@ SurfaceFinder::SurfaceFinder(const Jetscape::real T_in,
 
 SurfaceFinder::~SurfaceFinder() { surface_cell_list.clear(); }
 
+// false if each pair of opposite corners lies on one side of T_cut,
+// then Cornelius is not called for the cube
+static bool CubeIntersects3D(Jetscape::real T_cut, double ***cube) {
+  bool intersect = true;
+  if ((T_cut - cube[0][0][0]) * (cube[1][1][1] - T_cut) < 0.0)
+    if ((T_cut - cube[0][1][0]) * (cube[1][0][1] - T_cut) < 0.0)
+      if ((T_cut - cube[0][1][1]) * (cube[1][0][0] - T_cut) < 0.0)
+        if ((T_cut - cube[0][0][1]) * (cube[1][1][0] - T_cut) < 0.0)
+          intersect = false;
+
+  return (intersect);
+}
+
+static bool CubeIntersects4D(Jetscape::real T_cut, double ****cube) {
+  bool intersect = true;
+  if ((T_cut - cube[0][0][0][0]) * (cube[1][1][1][1] - T_cut) < 0.0)
+    if ((T_cut - cube[0][0][1][1]) * (cube[1][1][0][0] - T_cut) < 0.0)
+      if ((T_cut - cube[0][1][0][1]) * (cube[1][0][1][0] - T_cut) < 0.0)
+        if ((T_cut - cube[0][1][1][0]) * (cube[1][0][0][1] - T_cut) < 0.0)
+          if ((T_cut - cube[0][0][0][1]) * (cube[1][1][1][0] - T_cut) < 0.0)
+            if ((T_cut - cube[0][0][1][0]) * (cube[1][1][0][1] - T_cut) < 0.0)
+              if ((T_cut - cube[0][1][0][0]) * (cube[1][0][1][1] - T_cut) < 0.0)
+                if ((T_cut - cube[0][1][1][1]) * (cube[1][0][0][0] - T_cut) <
+                    0.0)
+                  intersect = false;
+
+  return (intersect);
+}
+
 void SurfaceFinder::Find_full_hypersurface() {
   if (boost_invariant) {
     JSINFO << "Finding a 2+1D hyper-surface at T = " << T_cut << " GeV ...";
@@ -54,8 +86,6 @@ bool SurfaceFinder::check_intersect_3D(Jetscape::real tau, Jetscape::real x,
                                        Jetscape::real y, Jetscape::real dt,
                                        Jetscape::real dx, Jetscape::real dy,
                                        double ***cube) {
-  bool intersect = true;
-
   auto tau_low = tau - dt / 2.;
   auto tau_high = tau + dt / 2.;
   auto x_left = x - dx / 2.;
@@ -80,91 +110,29 @@ bool SurfaceFinder::check_intersect_3D(Jetscape::real tau, Jetscape::real x,
   fluid_cell = bulk_info.get(tau_high, x_right, y_right, 0.0);
   cube[1][1][1] = fluid_cell.temperature;
 
-  if ((T_cut - cube[0][0][0]) * (cube[1][1][1] - T_cut) < 0.0)
-    if ((T_cut - cube[0][1][0]) * (cube[1][0][1] - T_cut) < 0.0)
-      if ((T_cut - cube[0][1][1]) * (cube[1][0][0] - T_cut) < 0.0)
-        if ((T_cut - cube[0][0][1]) * (cube[1][1][0] - T_cut) < 0.0)
-          intersect = false;
-
-  return (intersect);
+  return (CubeIntersects3D(T_cut, cube));
 }
 
 void SurfaceFinder::Find_full_hypersurface_3D() {
-  auto grid_tau0 = bulk_info.Tau0();
-  auto grid_tauf = bulk_info.TauMax();
-  auto grid_x0 = bulk_info.XMin();
-  auto grid_y0 = bulk_info.YMin();
-  ;
-
-  Jetscape::real grid_dt = 0.1;
-  Jetscape::real grid_dx = 0.2;
-  Jetscape::real grid_dy = 0.2;
-
-  const int dim = 3;
-  double lattice_spacing[dim];
-  lattice_spacing[0] = grid_dt;
-  lattice_spacing[1] = grid_dx;
-  lattice_spacing[2] = grid_dy;
-
-  std::unique_ptr<Cornelius> cornelius_ptr(new Cornelius());
-  cornelius_ptr->init(dim, T_cut, lattice_spacing);
-
-  const int ntime = static_cast<int>((grid_tauf - grid_tau0) / grid_dt);
-  const int nx = static_cast<int>(std::abs(2. * grid_x0) / grid_dx);
-  const int ny = static_cast<int>(std::abs(2. * grid_y0) / grid_dy);
-
-  double ***cube = new double **[2];
-  for (int i = 0; i < 2; i++) {
-    cube[i] = new double *[2];
-    for (int j = 0; j < 2; j++) {
-      cube[i][j] = new double[2];
-      for (int k = 0; k < 2; k++)
-        cube[i][j][k] = 0.0;
-    }
-  }
-
-  for (int itime = 0; itime < ntime; itime++) {
-    // loop over time evolution
-    auto tau_local = grid_tau0 + (itime + 0.5) * grid_dt;
-    for (int i = 0; i < nx; i++) {
-      // loops over the transverse plane
-      auto x_local = grid_x0 + (i + 0.5) * grid_dx;
-      for (int j = 0; j < ny; j++) {
-        auto y_local = grid_y0 + (j + 0.5) * grid_dy;
-        bool intersect = check_intersect_3D(tau_local, x_local, y_local,
-                                            grid_dt, grid_dx, grid_dy, cube);
-        if (intersect) {
-          cornelius_ptr->find_surface_3d(cube);
-          for (int isurf = 0; isurf < cornelius_ptr->get_Nelements(); isurf++) {
-            auto tau_center = (cornelius_ptr->get_centroid_elem(isurf, 0) +
-                               tau_local - grid_dt / 2.);
-            auto x_center = (cornelius_ptr->get_centroid_elem(isurf, 1) +
-                             x_local - grid_dx / 2.);
-            auto y_center = (cornelius_ptr->get_centroid_elem(isurf, 2) +
-                             y_local - grid_dy / 2.);
-
-            auto da_tau = cornelius_ptr->get_normal_elem(isurf, 0);
-            auto da_x = cornelius_ptr->get_normal_elem(isurf, 1);
-            auto da_y = cornelius_ptr->get_normal_elem(isurf, 2);
-
-            auto fluid_cell =
-                bulk_info.get(tau_center, x_center, y_center, 0.0);
-            auto surface_cell =
-                PrepareASurfaceCell(tau_center, x_center, y_center, 0.0, da_tau,
-                                    da_x, da_y, 0.0, fluid_cell);
-            surface_cell_list.push_back(surface_cell);
-          }
-        }
-      }
-    }
-  }
-
-  for (int i = 0; i < 2; i++) {
-    for (int j = 0; j < 2; j++)
-      delete[] cube[i][j];
-    delete[] cube[i];
-  }
-  delete[] cube;
+  Lattice lattice;
+  lattice.dim = 3;
+  lattice.tau0 = bulk_info.Tau0();
+  lattice.x0 = bulk_info.XMin();
+  lattice.y0 = bulk_info.YMin();
+  lattice.eta0 = 0.0;
+
+  lattice.dt = 0.1;
+  lattice.dx = 0.2;
+  lattice.dy = 0.2;
+  lattice.deta = 0.0;
+
+  lattice.ntime = static_cast<int>((bulk_info.TauMax() - lattice.tau0) /
+                                   lattice.dt);
+  lattice.nx = static_cast<int>(std::abs(2. * lattice.x0) / lattice.dx);
+  lattice.ny = static_cast<int>(std::abs(2. * lattice.y0) / lattice.dy);
+  lattice.neta = 0;
+
+  FindInParallel(lattice);
 }
 
 bool SurfaceFinder::check_intersect_4D(Jetscape::real tau, Jetscape::real x,
@@ -172,9 +140,6 @@ bool SurfaceFinder::check_intersect_4D(Jetscape::real tau, Jetscape::real x,
                                        Jetscape::real dt, Jetscape::real dx,
                                        Jetscape::real dy, Jetscape::real deta,
                                        double ****cube) {
-
-  bool intersect = true;
-
   auto tau_low = tau - dt / 2.;
   auto tau_high = tau + dt / 2.;
   auto x_left = x - dx / 2.;
@@ -217,124 +182,212 @@ bool SurfaceFinder::check_intersect_4D(Jetscape::real tau, Jetscape::real x,
   fluid_cell = bulk_info.get(tau_high, x_right, y_right, eta_right);
   cube[1][1][1][1] = fluid_cell.temperature;
 
-  if ((T_cut - cube[0][0][0][0]) * (cube[1][1][1][1] - T_cut) < 0.0)
-    if ((T_cut - cube[0][0][1][1]) * (cube[1][1][0][0] - T_cut) < 0.0)
-      if ((T_cut - cube[0][1][0][1]) * (cube[1][0][1][0] - T_cut) < 0.0)
-        if ((T_cut - cube[0][1][1][0]) * (cube[1][0][0][1] - T_cut) < 0.0)
-          if ((T_cut - cube[0][0][0][1]) * (cube[1][1][1][0] - T_cut) < 0.0)
-            if ((T_cut - cube[0][0][1][0]) * (cube[1][1][0][1] - T_cut) < 0.0)
-              if ((T_cut - cube[0][1][0][0]) * (cube[1][0][1][1] - T_cut) < 0.0)
-                if ((T_cut - cube[0][1][1][1]) * (cube[1][0][0][0] - T_cut) <
-                    0.0)
-                  intersect = false;
-
-  return (intersect);
+  return (CubeIntersects4D(T_cut, cube));
 }
 
 void SurfaceFinder::Find_full_hypersurface_4D() {
-  auto grid_tau0 = bulk_info.Tau0();
-  auto grid_tauf = bulk_info.TauMax();
-  auto grid_x0 = bulk_info.XMin();
-  auto grid_y0 = bulk_info.YMin();
-  ;
-  auto grid_eta0 = bulk_info.EtaMin();
-  ;
-
-  Jetscape::real grid_dt = 0.1;
-  Jetscape::real grid_dx = 0.2;
-  Jetscape::real grid_dy = 0.2;
-  Jetscape::real grid_deta = 0.2;
-
-  const int dim = 4;
-  double lattice_spacing[dim];
-  lattice_spacing[0] = grid_dt;
-  lattice_spacing[1] = grid_dx;
-  lattice_spacing[2] = grid_dy;
-  lattice_spacing[3] = grid_deta;
+  Lattice lattice;
+  lattice.dim = 4;
+  lattice.tau0 = bulk_info.Tau0();
+  lattice.x0 = bulk_info.XMin();
+  lattice.y0 = bulk_info.YMin();
+  lattice.eta0 = bulk_info.EtaMin();
+
+  lattice.dt = 0.1;
+  lattice.dx = 0.2;
+  lattice.dy = 0.2;
+  lattice.deta = 0.2;
+
+  lattice.ntime = static_cast<int>((bulk_info.TauMax() - lattice.tau0) /
+                                   lattice.dt);
+  lattice.nx = static_cast<int>(std::abs(2. * lattice.x0) / lattice.dx);
+  lattice.ny = static_cast<int>(std::abs(2. * lattice.y0) / lattice.dy);
+  lattice.neta =
+      static_cast<int>(std::abs(2. * lattice.eta0) / lattice.deta);
+
+  FindInParallel(lattice);
+}
+
+// Blocks of consecutive time slices are independent, so they run on the
+// pool and their cells are appended in block order: the list comes out the
+// same as from one serial pass over the time slices.
+void SurfaceFinder::FindInParallel(const Lattice &lattice) {
+  if (lattice.ntime <= 0)
+    return;
+
+  int n_workers = std::max(1, n_threads);
+  // a few blocks per thread, since early time slices have larger surfaces
+  int n_blocks = std::min(lattice.ntime, 4 * n_workers);
+  if (n_workers == 1)
+    n_blocks = 1;
+
+  std::vector<std::vector<SurfaceCellInfo>> block_cells(n_blocks);
+  auto job = [&](int b) {
+    FindInTimeSlices(lattice, lattice.ntime * b / n_blocks,
+                     lattice.ntime * (b + 1) / n_blocks, block_cells[b]);
+  };
+  if (n_workers == 1) {
+    job(0);
+  } else {
+    JetScapeThreadPool pool(n_workers);
+    pool.RunAndWait(n_blocks, job);
+  }
+
+  for (auto &cells : block_cells)
+    surface_cell_list.insert(surface_cell_list.end(), cells.begin(),
+                             cells.end());
+}
+
+// Temperatures at the cube corners of time plane itime, [l][i][j] with
+// l < neta + 1, i < nx + 1, j < ny + 1. Each corner is shared by up to 16
+// cubes but interpolated once, and only the temperature is interpolated.
+void SurfaceFinder::FillTemperaturePlane(
+    const Lattice &lattice, int itime, FluidCellBatch &batch,
+    std::vector<Jetscape::real> &plane) const {
+  int n_sheet = (lattice.nx + 1) * (lattice.ny + 1);
+  plane.resize((lattice.neta + 1) * n_sheet);
+
+  // same corner coordinates as check_intersect_3D/4D, up to rounding
+  Jetscape::real tau = lattice.tau0 + (itime + 0.5) * lattice.dt;
+  tau = tau - lattice.dt / 2.;
+  for (int l = 0; l <= lattice.neta; l++) {
+    Jetscape::real eta = 0.0;
+    if (lattice.dim == 4) {
+      eta = lattice.eta0 + (l + 0.5) * lattice.deta;
+      eta = eta - lattice.deta / 2.;
+    }
+    batch.clear();
+    for (int i = 0; i <= lattice.nx; i++) {
+      Jetscape::real x = lattice.x0 + (i + 0.5) * lattice.dx;
+      x = x - lattice.dx / 2.;
+      for (int j = 0; j <= lattice.ny; j++) {
+        Jetscape::real y = lattice.y0 + (j + 0.5) * lattice.dy;
+        y = y - lattice.dy / 2.;
+        batch.add_point(tau, x, y, eta);
+      }
+    }
+    bulk_info.get_batch(batch);
+    std::copy(batch.entry[ENTRY_TEMPERATURE].begin(),
+              batch.entry[ENTRY_TEMPERATURE].end(),
+              plane.begin() + l * n_sheet);
+  }
+}
+
+void SurfaceFinder::FindInTimeSlices(
+    const Lattice &lattice, int itime_begin, int itime_end,
+    std::vector<SurfaceCellInfo> &cells) const {
+  const int dim = lattice.dim;
+  double lattice_spacing[4] = {lattice.dt, lattice.dx, lattice.dy,
+                               lattice.deta};
 
   std::unique_ptr<Cornelius> cornelius_ptr(new Cornelius());
   cornelius_ptr->init(dim, T_cut, lattice_spacing);
 
-  const int ntime = static_cast<int>((grid_tauf - grid_tau0) / grid_dt);
-  const int nx = static_cast<int>(std::abs(2. * grid_x0) / grid_dx);
-  const int ny = static_cast<int>(std::abs(2. * grid_y0) / grid_dy);
-  const int neta = static_cast<int>(std::abs(2. * grid_eta0) / grid_deta);
-
-  double ****cube = new double ***[2];
+  // cube[tau][x][y] or cube4[tau][x][y][eta], as Cornelius wants them
+  double ***cube = new double **[2];
+  double ****cube4 = new double ***[2];
   for (int i = 0; i < 2; i++) {
-    cube[i] = new double **[2];
+    cube[i] = new double *[2];
+    cube4[i] = new double **[2];
     for (int j = 0; j < 2; j++) {
-      cube[i][j] = new double *[2];
-      for (int k = 0; k < 2; k++) {
-        cube[i][j][k] = new double[2];
-        for (int l = 0; l < 2; l++) {
-          cube[i][j][k][l] = 0.0;
-        }
-      }
+      cube[i][j] = new double[2];
+      cube4[i][j] = new double *[2];
+      for (int k = 0; k < 2; k++)
+        cube4[i][j][k] = new double[2];
     }
   }
 
-  for (int itime = 0; itime < ntime; itime++) {
+  int n_sheet = (lattice.nx + 1) * (lattice.ny + 1);
+  int n_eta_cells = (dim == 4) ? lattice.neta : 1;
+
+  FluidCellBatch batch;
+  batch.mask = FieldMask(ENTRY_TEMPERATURE);
+  std::vector<Jetscape::real> plane[2];
+  FillTemperaturePlane(lattice, itime_begin, batch, plane[0]);
+
+  for (int itime = itime_begin; itime < itime_end; itime++) {
     // loop over time evolution
-    auto tau_local = grid_tau0 + (itime + 0.5) * grid_dt;
-    for (int l = 0; l < neta; l++) {
-      auto eta_local = grid_eta0 + (l + 0.5) * grid_deta;
-      // loops over the transverse plane
-      for (int i = 0; i < nx; i++) {
+    FillTemperaturePlane(lattice, itime + 1, batch, plane[1]);
+    auto tau_local = lattice.tau0 + (itime + 0.5) * lattice.dt;
+    for (int l = 0; l < n_eta_cells; l++) {
+      auto eta_local = lattice.eta0 + (l + 0.5) * lattice.deta;
+      for (int i = 0; i < lattice.nx; i++) {
         // loops over the transverse plane
-        auto x_local = grid_x0 + (i + 0.5) * grid_dx;
-        for (int j = 0; j < ny; j++) {
-          auto y_local = grid_y0 + (j + 0.5) * grid_dy;
-          bool intersect =
-              check_intersect_4D(tau_local, x_local, y_local, eta_local,
-                                 grid_dt, grid_dx, grid_dy, grid_deta, cube);
-          if (intersect) {
-            cornelius_ptr->find_surface_4d(cube);
-            for (int isurf = 0; isurf < cornelius_ptr->get_Nelements();
-                 isurf++) {
-              auto tau_center = (cornelius_ptr->get_centroid_elem(isurf, 0) +
-                                 tau_local - grid_dt / 2.);
-              auto x_center = (cornelius_ptr->get_centroid_elem(isurf, 1) +
-                               x_local - grid_dx / 2.);
-              auto y_center = (cornelius_ptr->get_centroid_elem(isurf, 2) +
-                               y_local - grid_dy / 2.);
-              auto eta_center = (cornelius_ptr->get_centroid_elem(isurf, 3) +
-                                 eta_local - grid_deta / 2.);
-
-              auto da_tau = (cornelius_ptr->get_normal_elem(isurf, 0));
-              auto da_x = (cornelius_ptr->get_normal_elem(isurf, 1));
-              auto da_y = (cornelius_ptr->get_normal_elem(isurf, 2));
-              auto da_eta = (cornelius_ptr->get_normal_elem(isurf, 3));
-
-              auto fluid_cell =
-                  bulk_info.get(tau_center, x_center, y_center, eta_center);
-              auto surface_cell = PrepareASurfaceCell(
-                  tau_center, x_center, y_center, eta_center, da_tau, da_x,
-                  da_y, da_eta, fluid_cell);
-              surface_cell_list.push_back(surface_cell);
+        auto x_local = lattice.x0 + (i + 0.5) * lattice.dx;
+        for (int j = 0; j < lattice.ny; j++) {
+          auto y_local = lattice.y0 + (j + 0.5) * lattice.dy;
+
+          for (int a = 0; a < 2; a++)
+            for (int b = 0; b < 2; b++)
+              for (int c = 0; c < 2; c++) {
+                int node = (i + b) * (lattice.ny + 1) + j + c;
+                if (dim == 4) {
+                  cube4[a][b][c][0] = plane[a][l * n_sheet + node];
+                  cube4[a][b][c][1] = plane[a][(l + 1) * n_sheet + node];
+                } else {
+                  cube[a][b][c] = plane[a][node];
+                }
+              }
+
+          bool intersect = (dim == 4) ? CubeIntersects4D(T_cut, cube4)
+                                      : CubeIntersects3D(T_cut, cube);
+          if (!intersect)
+            continue;
+
+          if (dim == 4)
+            cornelius_ptr->find_surface_4d(cube4);
+          else
+            cornelius_ptr->find_surface_3d(cube);
+          for (int isurf = 0; isurf < cornelius_ptr->get_Nelements(); isurf++) {
+            auto tau_center = (cornelius_ptr->get_centroid_elem(isurf, 0) +
+                               tau_local - lattice.dt / 2.);
+            auto x_center = (cornelius_ptr->get_centroid_elem(isurf, 1) +
+                             x_local - lattice.dx / 2.);
+            auto y_center = (cornelius_ptr->get_centroid_elem(isurf, 2) +
+                             y_local - lattice.dy / 2.);
+            auto eta_center = 0.0;
+            auto da_eta = 0.0;
+            if (dim == 4) {
+              eta_center = (cornelius_ptr->get_centroid_elem(isurf, 3) +
+                            eta_local - lattice.deta / 2.);
+              da_eta = cornelius_ptr->get_normal_elem(isurf, 3);
             }
+
+            auto da_tau = cornelius_ptr->get_normal_elem(isurf, 0);
+            auto da_x = cornelius_ptr->get_normal_elem(isurf, 1);
+            auto da_y = cornelius_ptr->get_normal_elem(isurf, 2);
+
+            auto fluid_cell =
+                bulk_info.get(tau_center, x_center, y_center, eta_center);
+            cells.push_back(PrepareASurfaceCell(tau_center, x_center,
+                                                y_center, eta_center, da_tau,
+                                                da_x, da_y, da_eta,
+                                                fluid_cell));
           }
         }
       }
     }
+    plane[0].swap(plane[1]);
   }
 
   for (int i = 0; i < 2; i++) {
     for (int j = 0; j < 2; j++) {
-      for (int k = 0; k < 2; k++) {
-        delete[] cube[i][j][k];
-      }
+      for (int k = 0; k < 2; k++)
+        delete[] cube4[i][j][k];
+      delete[] cube4[i][j];
       delete[] cube[i][j];
     }
+    delete[] cube4[i];
     delete[] cube[i];
   }
+  delete[] cube4;
   delete[] cube;
 }
 
 SurfaceCellInfo SurfaceFinder::PrepareASurfaceCell(
     Jetscape::real tau, Jetscape::real x, Jetscape::real y, Jetscape::real eta,
     Jetscape::real da0, Jetscape::real da1, Jetscape::real da2,
-    Jetscape::real da3, const FluidCellInfo fluid_cell) {
+    Jetscape::real da3, const FluidCellInfo fluid_cell) const {
 
   SurfaceCellInfo temp_cell;
   temp_cell.tau = tau;
@@ -30,15 +30,37 @@ private:
   Jetscape::real T_cut;
   const EvolutionHistory &bulk_info;
   bool boost_invariant;
+  int n_threads;
 
   std::vector<SurfaceCellInfo> surface_cell_list;
 
+  // The cubes Cornelius works on, neta = 0 for a 2+1D surface
+  struct Lattice {
+    int dim;
+    int ntime, nx, ny, neta;
+    Jetscape::real tau0, x0, y0, eta0;
+    Jetscape::real dt, dx, dy, deta;
+  };
+
+  void FindInTimeSlices(const Lattice &lattice, int itime_begin,
+                        int itime_end,
+                        std::vector<SurfaceCellInfo> &cells) const;
+  void FillTemperaturePlane(const Lattice &lattice, int itime,
+                            FluidCellBatch &batch,
+                            std::vector<Jetscape::real> &plane) const;
+  void FindInParallel(const Lattice &lattice);
+
 public:
   SurfaceFinder(const Jetscape::real T_in, const EvolutionHistory &bulk_data);
   ~SurfaceFinder();
 
   void Find_full_hypersurface();
 
+  /** Number of threads the time slices are split across; 0 or 1 runs on
+      the calling thread only. The surface is the same for any number. */
+  void set_number_of_threads(int n) { n_threads = n; }
+  int get_number_of_threads() const { return (n_threads); }
+
   int get_number_of_surface_cells() const { return (surface_cell_list.size()); }
   SurfaceCellInfo get_surface_cell_with_idx(int idx) const {
     return (surface_cell_list[idx]);
@@ -63,7 +85,7 @@ public:
                                       Jetscape::real y, Jetscape::real eta,
                                       Jetscape::real da0, Jetscape::real da1,
                                       Jetscape::real da2, Jetscape::real da3,
-                                      const FluidCellInfo fluid_cell);
+                                      const FluidCellInfo fluid_cell) const;
 };
 
 } // namespace Jetscape
@@ -25,10 +25,9 @@ using namespace Pythia8;
 RegisterJetScapeModule<ColoredHadronization>
     ColoredHadronization::reg("ColoredHadronization");
 
-Pythia8::Pythia ColoredHadronization::pythia("IntentionallyEmpty", false);
-
 ColoredHadronization::ColoredHadronization() {
   SetId("MyHadroTest");
+  pythia_pool = make_shared<JetScapePythiaPool>();
   VERBOSE(8);
 }
 
@@ -49,39 +48,39 @@ void ColoredHadronization::Init() {
   VERBOSE(2) << "Start Hadronizing using the PYTHIA module...";
 
   // Show initialization at DEBUG or high verbose level
-  pythia.readString("Init:showProcesses = off");
-  pythia.readString("Init:showChangedSettings = off");
-  pythia.readString("Init:showMultipartonInteractions = off");
-  pythia.readString("Init:showChangedParticleData = off");
+  pythia_pool->ReadString("Init:showProcesses = off");
+  pythia_pool->ReadString("Init:showChangedSettings = off");
+  pythia_pool->ReadString("Init:showMultipartonInteractions = off");
+  pythia_pool->ReadString("Init:showChangedParticleData = off");
   if (JetScapeLogger::Instance()->GetDebug() ||
       JetScapeLogger::Instance()->GetVerboseLevel() > 2) {
-    pythia.readString("Init:showProcesses = on");
-    pythia.readString("Init:showChangedSettings = on");
-    pythia.readString("Init:showMultipartonInteractions = on");
-    pythia.readString("Init:showChangedParticleData = on");
+    pythia_pool->ReadString("Init:showProcesses = on");
+    pythia_pool->ReadString("Init:showChangedSettings = on");
+    pythia_pool->ReadString("Init:showMultipartonInteractions = on");
+    pythia_pool->ReadString("Init:showChangedParticleData = on");
   }
 
   // No event record printout.
-  pythia.readString("Next:numberShowInfo = 0");
-  pythia.readString("Next:numberShowProcess = 0");
-  pythia.readString("Next:numberShowEvent = 0");
+  pythia_pool->ReadString("Next:numberShowInfo = 0");
+  pythia_pool->ReadString("Next:numberShowProcess = 0");
+  pythia_pool->ReadString("Next:numberShowEvent = 0");
   if (JetScapeLogger::Instance()->GetDebug() ||
       JetScapeLogger::Instance()->GetVerboseLevel() > 2) {
-    pythia.readString("Next:numberShowInfo = 1");
-    pythia.readString("Next:numberShowProcess = 1");
-    pythia.readString("Next:numberShowEvent = 1");
+    pythia_pool->ReadString("Next:numberShowInfo = 1");
+    pythia_pool->ReadString("Next:numberShowProcess = 1");
+    pythia_pool->ReadString("Next:numberShowEvent = 1");
   }
 
-  pythia.readString("ProcessLevel:all = off");
-  pythia.readString("PartonLevel:FSR=off");
+  pythia_pool->ReadString("ProcessLevel:all = off");
+  pythia_pool->ReadString("PartonLevel:FSR=off");
   if (weak_decays == "off") {
     JSINFO << "Weak decays are turned off";
-    pythia.readString("HadronLevel:Decay = off");
+    pythia_pool->ReadString("HadronLevel:Decay = off");
   } else {
     JSINFO << "Weak decays are turned on";
-    pythia.readString("HadronLevel:Decay = on");
-    pythia.readString("ParticleDecays:limitTau0 = on");
-    pythia.readString("ParticleDecays:tau0Max = 10.0");
+    pythia_pool->ReadString("HadronLevel:Decay = on");
+    pythia_pool->ReadString("ParticleDecays:limitTau0 = on");
+    pythia_pool->ReadString("ParticleDecays:tau0Max = 10.0");
   }
 
   std::stringstream lines;
@@ -91,10 +90,11 @@ void ColoredHadronization::Init() {
     if (s.find_first_not_of(" \t\v\f\r") == s.npos)
       continue; // skip empty lines
     JSINFO << "Also reading in: " << s;
-    pythia.readString(s);
+    pythia_pool->ReadString(s);
   }
 
-  pythia.init();
+  pythia_pool->Init(
+      GetXMLElementInt({"JetHadronization", "nPythiaInstances"}, false));
 }
 
 void ColoredHadronization::WriteTask(weak_ptr<JetScapeWriter> w) {
@@ -110,6 +110,9 @@ void ColoredHadronization::DoHadronization(
     vector<vector<shared_ptr<Parton>>> &shower,
     vector<shared_ptr<Hadron>> &hOut, vector<shared_ptr<Parton>> &pOut) {
 
+  // events are hadronized one at a time, so always with instance 0
+  auto pythia_lease = pythia_pool->Acquire(0);
+  Pythia &pythia = *pythia_lease;
   Event &event = pythia.event;
   event.reset();
   double pz = p_fake;
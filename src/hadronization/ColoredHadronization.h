@@ -17,7 +17,7 @@
 #define COLOREDHADRONIZATION_H
 
 #include "HadronizationModule.h"
-#include "Pythia8/Pythia.h"
+#include "JetScapePythiaPool.h"
 
 using namespace Jetscape;
 
@@ -39,7 +39,7 @@ private:
   static RegisterJetScapeModule<ColoredHadronization> reg;
 
 protected:
-  static Pythia8::Pythia pythia;
+  shared_ptr<JetScapePythiaPool> pythia_pool;
 };
 
 #endif // COLOREDHADRONIZATION_H
@@ -34,11 +34,9 @@ using namespace Pythia8;
 RegisterJetScapeModule<ColorlessHadronization>
     ColorlessHadronization::reg("ColorlessHadronization");
 
-// Initialize static helper here
-Pythia8::Pythia ColorlessHadronization::pythia("IntentionallyEmpty", false);
-
 ColorlessHadronization::ColorlessHadronization() {
   SetId("ColorlessHadronization");
+  pythia_pool = make_shared<JetScapePythiaPool>();
   VERBOSE(8);
 }
 
@@ -64,12 +62,12 @@ void ColorlessHadronization::Init() {
   VERBOSE(8);
 
   // No event record printout.
-  pythia.readString("Next:numberShowInfo = 0");
-  pythia.readString("Next:numberShowProcess = 0");
-  pythia.readString("Next:numberShowEvent = 0");
+  pythia_pool->ReadString("Next:numberShowInfo = 0");
+  pythia_pool->ReadString("Next:numberShowProcess = 0");
+  pythia_pool->ReadString("Next:numberShowEvent = 0");
 
   // Standard settings
-  pythia.readString("ProcessLevel:all = off");
+  pythia_pool->ReadString("ProcessLevel:all = off");
 
   // Don't let pi0 decay
   //pythia.readString("111:mayDecay = off");
@@ -77,16 +75,16 @@ void ColorlessHadronization::Init() {
   // Don't let any hadron decay
   //pythia.readString("HadronLevel:Decay = off");
 
-  pythia.readString("PartonLevel:FSR=off");
+  pythia_pool->ReadString("PartonLevel:FSR=off");
 
   if (weak_decays == "off") {
     JSINFO << "Weak decays are turned off";
-    pythia.readString("HadronLevel:Decay = off");
+    pythia_pool->ReadString("HadronLevel:Decay = off");
   } else {
     JSINFO << "Weak decays are turned on";
-    pythia.readString("HadronLevel:Decay = on");
-    pythia.readString("ParticleDecays:limitTau0 = on");
-    pythia.readString("ParticleDecays:tau0Max = 10.0");
+    pythia_pool->ReadString("HadronLevel:Decay = on");
+    pythia_pool->ReadString("ParticleDecays:limitTau0 = on");
+    pythia_pool->ReadString("ParticleDecays:tau0Max = 10.0");
   }
   
   std::stringstream lines;
@@ -96,13 +94,14 @@ void ColorlessHadronization::Init() {
     if (s.find_first_not_of(" \t\v\f\r") == s.npos)
       continue; // skip empty lines
     JSINFO << "Also reading in: " << s;
-    pythia.readString(s);
+    pythia_pool->ReadString(s);
   }
 
   // Initialize random number distribution
   ZeroOneDistribution = std::uniform_real_distribution<double> { 0.0, 1.0 };
   // And initialize
-  pythia.init();
+  pythia_pool->Init(
+      GetXMLElementInt({"JetHadronization", "nPythiaInstances"}, false));
 }
 
 void ColorlessHadronization::WriteTask(weak_ptr<JetScapeWriter> w) {
@@ -118,6 +117,9 @@ void ColorlessHadronization::DoHadronization(
     vector<shared_ptr<Hadron>> &hOut, vector<shared_ptr<Parton>> &pOut) {
   VERBOSE(1) << "Start Hadronizing using PYTHIA Lund string model (does NOT "
                 "use color flow, needs to be tested)...";
+  // events are hadronized one at a time, so always with instance 0
+  auto pythia_lease = pythia_pool->Acquire(0);
+  Pythia &pythia = *pythia_lease;
   Event &event = pythia.event;
   ParticleData &pdt = pythia.particleData;
 
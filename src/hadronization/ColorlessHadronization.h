@@ -18,7 +18,7 @@
 
 #include "HadronizationModule.h"
 #include "JetScapeLogger.h"
-#include "Pythia8/Pythia.h"
+#include "JetScapePythiaPool.h"
 
 using namespace Jetscape;
 
@@ -42,7 +42,7 @@ private:
   static RegisterJetScapeModule<ColorlessHadronization> reg;
 
 protected:
-  static Pythia8::Pythia pythia;
+  shared_ptr<JetScapePythiaPool> pythia_pool;
   std::uniform_real_distribution<double> ZeroOneDistribution;
 };
 
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <sstream>
 #include <random>
+#include <limits>
 #include <algorithm>
 
 using namespace Jetscape;
@@ -32,9 +33,6 @@ using namespace Pythia8;
 RegisterJetScapeModule<HybridHadronization>
     HybridHadronization::reg("HybridHadronization");
 
-// Initialize static helper here
-Pythia8::Pythia HybridHadronization::pythia("IntentionallyEmpty", false);
-
 //RNG - Mersenne Twist - 64 bit
 //std::mt19937_64 eng(std::random_device{}());
 //std::mt19937_64 eng(1);
@@ -46,6 +44,12 @@ double HybridHadronization::ran() {
 
 HybridHadronization::HybridHadronization() {
   SetId("HybridHadronization");
+  pythia_pool = make_shared<JetScapePythiaPool>();
+  reco_cutoff = 0.;
+  reco_check = 0;
+  reco_formed = 0;
+  reco_pruned_formed = 0;
+  reco_bound_violations = 0;
   VERBOSE(8);
 }
 
@@ -73,6 +77,87 @@ double HybridHadronization::SigBL2_calc(double SigBR2, double qm1, double qm2,
          (qm3 * (qm1 + qm2) / (qm1 + qm2 + qm3));
 }
 
+//summed Wigner function up to maxE_level, for U the sum of all the u's (x,y,z for each relative coordinate)
+//exp(-U) * sum_n U^n/n!, which decreases with U
+double HybridHadronization::wigner_sum(double u) {
+  double term = std::exp(-u);
+  double sum = term;
+  for (int iE = 1; iE <= maxE_level; ++iE) {
+    term *= u / double(iE);
+    sum += term;
+  }
+  return sum;
+}
+
+//bounds for skipping recombination candidates in recomb()
+//in the rest frame of a pair, the momentum part of U for a meson is 0.5*q^2*SigM2/hbarc^2, q^2 from relmom2()
+//for a baryon, the rest frame momenta are bounded by |k_rho| + |k_lambda|, and so are the pair momenta q_ij
+//so U >= SigB2*max(q_ij^2)/(4*hbarc^2); the smallest widths are used so that the bounds hold for all species
+void HybridHadronization::set_reco_pruning() {
+  double hbarc2 = hbarc * hbarc;
+  double SigMmin2 = std::min({SigPi2, SigPhi2, SigK2, SigJpi2, SigDs2, SigD2,
+                              SigUps2, SigBc2, SigB2});
+  double SigBmin2 = std::min(
+      {SigNucR2,  SigNucL2,  SigOmgR2,  SigOmgL2,  SigXiR2,   SigXiL2,
+       SigSigR2,  SigSigL2,  SigOcccR2, SigOcccL2, SigOccR2,  SigOccL2,
+       SigXiccR2, SigXiccL2, SigOcR2,   SigOcL2,   SigXicR2,  SigXicL2,
+       SigSigcR2, SigSigcL2, SigObbbR2, SigObbbL2, SigObbcR2, SigObbcL2,
+       SigObbR2,  SigObbL2,  SigXibbR2, SigXibbL2, SigObccR2, SigObccL2,
+       SigObcR2,  SigObcL2,  SigXibcR2, SigXibcL2, SigObR2,   SigObL2,
+       SigXibR2,  SigXibL2,  SigSigbR2, SigSigbL2});
+
+  //smallest U for which recofactor * wigner_sum(U) < reco_cutoff
+  auto Ucut = [this](double recofactor) {
+    if (reco_cutoff <= 0.) {
+      return std::numeric_limits<double>::infinity();
+    }
+    if (recofactor <= reco_cutoff) {
+      return 0.;
+    }
+    double Ulow = 0., Uhigh = 1.;
+    while (recofactor * wigner_sum(Uhigh) >= reco_cutoff) {
+      Ulow = Uhigh;
+      Uhigh *= 2.;
+    }
+    for (int i = 0; i < 60; ++i) {
+      double Umid = 0.5 * (Ulow + Uhigh);
+      if (recofactor * wigner_sum(Umid) >= reco_cutoff) {
+        Ulow = Umid;
+      } else {
+        Uhigh = Umid;
+      }
+    }
+    return Uhigh;
+  };
+
+  for (int nth = 0; nth < 2; ++nth) {
+    double recofactor =
+        sh_recofactor * ((nth == 0) ? sh_recofactor : th_recofactor);
+    reco_q2max_meson[nth] = Ucut(recofactor) * 2. * hbarc2 / SigMmin2;
+  }
+  for (int nth = 0; nth < 3; ++nth) {
+    double recofactor =
+        std::pow(sh_recofactor, 3 - nth) * std::pow(th_recofactor, nth);
+    reco_q2max_baryon[nth] = Ucut(recofactor) * 4. * hbarc2 / SigBmin2;
+  }
+}
+
+//bookkeeping for reco_check: a candidate the bounds would have skipped must not be able to pass reco_cutoff
+void HybridHadronization::count_reco_check(bool pruned, double prob,
+                                           double rnd) {
+  if (prob >= rnd) {
+    ++reco_formed;
+  }
+  if (pruned) {
+    if (prob >= reco_cutoff) {
+      ++reco_bound_violations;
+    }
+    if (prob >= rnd) {
+      ++reco_pruned_formed;
+    }
+  }
+}
+
 void HybridHadronization::Init() {
 
   tinyxml2::XMLElement *hadronization = GetXMLElement({"JetHadronization"});
@@ -148,6 +233,15 @@ void HybridHadronization::Init() {
     }
     xml_intin = -1;
 
+    xml_doublein =
+        GetXMLElementDouble({"JetHadronization", "reco_Wigner_cutoff"}, false);
+    if (xml_doublein >= 0.) {
+      reco_cutoff = xml_doublein;
+    }
+    xml_doublein = -1.;
+
+    reco_check = GetXMLElementInt({"JetHadronization", "reco_check"}, false);
+
     // random seed
     // xml limits us to unsigned int :-/ -- but so does 32 bits Mersenne Twist
     tinyxml2::XMLElement *RandomXmlDescription = GetXMLElement({"Random"});
@@ -315,37 +409,45 @@ void HybridHadronization::Init() {
         SigBR2_calc(R2chg_Sigb, Qm_b, Qm_ud, Qm_ud, chg_d, chg_u, chg_u);
     SigSigbL2 = SigBL2_calc(SigSigbR2, Qm_b, Qm_ud, Qm_ud);
 
+    //momentum bounds for skipping recombination candidates, if reco_cutoff is set
+    set_reco_pruning();
+    if (reco_cutoff > 0.) {
+      JSINFO << "Skipping recombination candidates with Wigner probability "
+                "below "
+             << reco_cutoff << (reco_check ? " (check only)" : "");
+    }
+
     // No event record printout.
-    pythia.readString("Next:numberShowInfo = 0");
-    pythia.readString("Next:numberShowProcess = 0");
-    pythia.readString("Next:numberShowEvent = 0");
+    pythia_pool->ReadString("Next:numberShowInfo = 0");
+    pythia_pool->ReadString("Next:numberShowProcess = 0");
+    pythia_pool->ReadString("Next:numberShowEvent = 0");
 
     // Show initialization at DEBUG or high verbose level
-    pythia.readString("Init:showProcesses = off");
-    pythia.readString("Init:showChangedSettings = off");
-    pythia.readString("Init:showMultipartonInteractions = off");
-    pythia.readString("Init:showChangedParticleData = off");
+    pythia_pool->ReadString("Init:showProcesses = off");
+    pythia_pool->ReadString("Init:showChangedSettings = off");
+    pythia_pool->ReadString("Init:showMultipartonInteractions = off");
+    pythia_pool->ReadString("Init:showChangedParticleData = off");
     if (JetScapeLogger::Instance()->GetDebug() ||
         JetScapeLogger::Instance()->GetVerboseLevel() > 2) {
-      pythia.readString("Init:showProcesses = on");
-      pythia.readString("Init:showChangedSettings = on");
-      pythia.readString("Init:showMultipartonInteractions = on");
-      pythia.readString("Init:showChangedParticleData = on");
+      pythia_pool->ReadString("Init:showProcesses = on");
+      pythia_pool->ReadString("Init:showChangedSettings = on");
+      pythia_pool->ReadString("Init:showMultipartonInteractions = on");
+      pythia_pool->ReadString("Init:showChangedParticleData = on");
     }
 
     // No event record printout.
-    pythia.readString("Next:numberShowInfo = 0");
-    pythia.readString("Next:numberShowProcess = 0");
-    pythia.readString("Next:numberShowEvent = 0");
+    pythia_pool->ReadString("Next:numberShowInfo = 0");
+    pythia_pool->ReadString("Next:numberShowProcess = 0");
+    pythia_pool->ReadString("Next:numberShowEvent = 0");
     if (JetScapeLogger::Instance()->GetDebug() ||
         JetScapeLogger::Instance()->GetVerboseLevel() > 2) {
-      pythia.readString("Next:numberShowInfo = 1");
-      pythia.readString("Next:numberShowProcess = 1");
-      pythia.readString("Next:numberShowEvent = 1");
+      pythia_pool->ReadString("Next:numberShowInfo = 1");
+      pythia_pool->ReadString("Next:numberShowProcess = 1");
+      pythia_pool->ReadString("Next:numberShowEvent = 1");
     }
 
     // Standard settings
-    pythia.readString("ProcessLevel:all = off");
+    pythia_pool->ReadString("ProcessLevel:all = off");
     //pythia.readString("PartonLevel:FSR=off"); //is this necessary?
 
     // Don't let pi0 decay
@@ -355,14 +457,14 @@ void HybridHadronization::Init() {
     //pythia.readString("HadronLevel:Decay = off");
 
     //setting seed, or using random seed
-    pythia.readString("Random:setSeed = on");
-    pythia.readString("Random:seed = " + std::to_string(rand_seed));
+    pythia_pool->ReadString("Random:setSeed = on");
+    pythia_pool->ReadString("Random:seed = " + std::to_string(rand_seed));
 
     //additional settings
     //turning off pythia checks for runtime decrease (can be turned back on if necessary, but it shouldn't make much of a difference)
-    pythia.readString(
+    pythia_pool->ReadString(
         "Check:event = off"); // is probably a bad idea, but shouldn't really be necessary... will use a bit of runtime on event checks...
-    pythia.readString(
+    pythia_pool->ReadString(
         "Check:history = off"); // might be a good idea to set 'off' as it saves runtime - provided we know that we've set up mother/daughter relations correctly...
 
     //making the pythia event checks a little less stringent (PYTHIA documentation already states that LHC events will occasionally violate default constraint, without concern)
@@ -372,36 +474,37 @@ void HybridHadronization::Init() {
     //pythia.readString("Check:mTolErr   = 1e-1");   // setting EP/M conservation violation constraint somewhat weaker, just for ease
 
     //setting a decay threshold for subsequent hadron production
-    pythia.readString(
+    pythia_pool->ReadString(
         "ParticleDecays:limitTau0 = on"); //When on, only particles with tau0 < tau0Max are decayed
     //pythia.readString("ParticleDecays:tau0Max = 0.000003"); //The above tau0Max, expressed in mm/c :: default = 10. :: default, mayDecay()=true for tau0 below 1000 mm
     //set to 1E-17sec (in mm/c) to be smaller than pi0 lifetime
-    pythia.readString("ParticleDecays:tau0Max = 10.0");
+    pythia_pool->ReadString("ParticleDecays:tau0Max = 10.0");
 
     //allowing for partonic space-time information to be used by PYTHIA
-    pythia.readString(
+    pythia_pool->ReadString(
         "PartonVertex:setVertex = on"); //this might allow PYTHIA to keep track of partonic space-time information (default was for 'rope hadronization')
 
     //using QCD based color reconnection (original PYTHIA MPI based CR can't be used at hadron level)
-    pythia.readString(
+    pythia_pool->ReadString(
         "ColourReconnection:reconnect = on"); //allowing color reconnections (should have been default on, but doing it here for clarity)
-    pythia.readString(
+    pythia_pool->ReadString(
         "ColourReconnection:mode = 1"); //sets the color reconnection scheme to 'new' QCD based scheme (TODO: make sure this is better than (2)gluon move)
-    pythia.readString(
+    pythia_pool->ReadString(
         "ColourReconnection:forceHadronLevelCR = on"); //allowing color reconnections for these constructed strings!
     //a few params for the QCD based color reconnection scheme are set below.
-    pythia.readString(
+    pythia_pool->ReadString(
         "MultipartonInteractions:pT0Ref = 2.15"); //not sure if this is needed for this setup, but is part of the recommended 'default'
-    pythia.readString(
+    pythia_pool->ReadString(
         "ColourReconnection:allowDoubleJunRem = off"); //default on - allows directly connected double junction systems to split into two strings
-    pythia.readString("ColourReconnection:junctionCorrection = 1.15");
-    pythia.readString(
+    pythia_pool->ReadString("ColourReconnection:junctionCorrection = 1.15");
+    pythia_pool->ReadString(
         "ColourReconnection:timeDilationMode = 3"); //allow reconnection if single pair of dipoles are in causal contact (maybe try 5 as well?)
-    pythia.readString(
+    pythia_pool->ReadString(
         "ColourReconnection:timeDilationPar = 0.18"); //parameter used in causal interaction between strings (mode set above)(maybe try 0.073?)
 
     // And initialize
-    pythia.init();
+    pythia_pool->Init(
+        GetXMLElementInt({"JetHadronization", "nPythiaInstances"}, false));
 
     //setting up thermal partons...
     //read in thermal partons, THEN do sibling setup...
@@ -415,6 +518,25 @@ void HybridHadronization::Init() {
   }
 }
 
+// Forked workers keep the initialized Pythia instances and only restart
+// the random numbers from their own seed
+void HybridHadronization::Reseed() {
+  HadronizationModule<HybridHadronization>::Reseed();
+  tinyxml2::XMLElement *xmle = GetXMLElement({"Random", "seed"}, false);
+  if (!xmle) {
+    return;
+  }
+  unsigned int seed = 0;
+  xmle->QueryUnsignedText(&seed);
+  if (seed == 0 || seed == std::numeric_limits<unsigned int>::max()) {
+    return;
+  }
+  VERBOSE(7) << "Reseeding PYTHIA(hadronization) to " << seed;
+  rand_seed = seed;
+  eng.seed(rand_seed);
+  pythia_pool->Reseed(rand_seed);
+}
+
 void HybridHadronization::WriteTask(weak_ptr<JetScapeWriter> w) {
   VERBOSE(8);
   auto f = w.lock();
@@ -430,6 +552,9 @@ void HybridHadronization::DoHadronization(
 
   VERBOSE(2) << "Start Hybrid Hadronization using both Recombination and "
                 "PYTHIA Lund string model.";
+  // events are hadronized one at a time, so always with instance 0
+  auto pythia_lease = pythia_pool->Acquire(0);
+  Pythia &pythia = *pythia_lease;
   pythia.event.reset();
   HH_shower.clear();
 
@@ -572,7 +697,7 @@ void HybridHadronization::DoHadronization(
     }
 
     //running remaining partons through PYTHIA8 string fragmentation
-    run_successfully = invoke_py();
+    run_successfully = invoke_py(pythia);
 
     //for a successful run, go though final hadrons here and set parton parents up
     if (run_successfully) {
@@ -932,6 +1057,11 @@ void HybridHadronization::recomb() {
   //clearing remnants, in case it hasn't been done before
   HH_remnants.clear();
 
+  //reco_check counts are reported per event (a retried event only counts its last attempt)
+  reco_formed = 0;
+  reco_pruned_formed = 0;
+  reco_bound_violations = 0;
+
   //constructing a list of all the strings in the event
   std::vector<int> list_strs;
   //adding the first string to the list
@@ -1075,6 +1205,20 @@ void HybridHadronization::recomb() {
   parton_collection considering;
   int element[3];
 
+  //with reco_cutoff set, q2 and q3 only run over the partons whose momentum relative to q1 allows the cutoff to be passed
+  //(see set_reco_pruning); next_cand[i] is the first such position in perm2 at or after i - all of them without pruning
+  //the order of the search is kept, only provably hopeless candidates (and their random numbers) are skipped
+  int n_reco = showerquarks.num() + HH_thermal.num();
+  bool reco_prune = (reco_cutoff > 0.) && !reco_check;
+  std::vector<int> next_cand(n_reco + 1);
+  std::vector<double> q1_relmom2(n_reco, 0.);
+  for (int i = 0; i <= n_reco; ++i) {
+    next_cand[i] = i;
+  }
+  auto reco_parton = [&](int perm) -> HHparton & {
+    return (perm > 0) ? showerquarks[perm - 1] : HH_thermal[-perm - 1];
+  };
+
   for (int q1 = 0; q1 < showerquarks.num(); ++q1) {
     //accessing first considered quark
     //set q1 variables here
@@ -1106,11 +1250,29 @@ void HybridHadronization::recomb() {
     considering.add(showerquarks[element[0]]);
     showerquarks[element[0]].status(-991);
 
-    for (int q2 = 0; q2 < showerquarks.num() + HH_thermal.num(); ++q2) {
+    //relative momenta to q1, and the candidate list if pruning
+    //a q2 of the same sign can still make a baryon with either a shower or a thermal q3, so the looser bound is used
+    if (reco_cutoff > 0.) {
+      for (int i = n_reco - 1; i >= 0; --i) {
+        HHparton &ptn = reco_parton(perm2[i]);
+        int nth = (perm2[i] < 0) ? 1 : 0;
+        q1_relmom2[i] = relmom2(considering[0].p_in(), ptn.p_in());
+        double q2max = (ptn.id() * considering[0].id() < 0)
+                           ? reco_q2max_meson[nth]
+                           : std::max(reco_q2max_baryon[nth],
+                                      reco_q2max_baryon[nth + 1]);
+        if (reco_prune) {
+          next_cand[i] = (q1_relmom2[i] <= q2max) ? i : next_cand[i + 1];
+        }
+      }
+    }
+
+    for (int q2 = next_cand[0]; q2 < n_reco; q2 = next_cand[q2 + 1]) {
       //set q2 variables here - if we can form a meson, then skip q3 loop
       //also skip q3 loop if q2 is at last quark
 
       double recofactor2 = 0.;
+      int nth2 = (perm2[q2] < 0) ? 1 : 0;
 
       //accessing the second considered quark
       //this will skip over non-quark entries in HH_thermal
@@ -1206,8 +1368,8 @@ void HybridHadronization::recomb() {
       //will skip third loop in this case - otherwise we will check if we can make a baryon...
       if ((considering[0].id() * considering[1].id() > 0) &&
           (q2 < showerquarks.num() + HH_thermal.num() - 1)) {
-        for (int q3 = q2 + 1; q3 < showerquarks.num() + HH_thermal.num();
-             ++q3) {
+        for (int q3 = next_cand[q2 + 1]; q3 < n_reco;
+             q3 = next_cand[q3 + 1]) {
 
           double recofactor3 = recofactor2;
 
@@ -1226,6 +1388,19 @@ void HybridHadronization::recomb() {
             element[2] = perm2[q3] + 1;
           }
 
+          //the baryon can't pass reco_cutoff if any of the pairs is too far apart in momentum
+          bool pruned3 = false;
+          if (reco_cutoff > 0.) {
+            double q2max =
+                reco_q2max_baryon[nth2 + ((perm2[q3] < 0) ? 1 : 0)];
+            pruned3 = (q1_relmom2[q2] > q2max) || (q1_relmom2[q3] > q2max) ||
+                      (relmom2(considering[1].p_in(),
+                               reco_parton(perm2[q3]).p_in()) > q2max);
+            if (pruned3 && reco_prune) {
+              continue;
+            }
+          }
+
           //now that we have q3, we need to check if it is valid:
           //q3 needs to be checked if used (all cases)
           //q3 needs to be checked if it is a erroneously accessed parton (not u,d,s quark)
@@ -1658,6 +1833,9 @@ void HybridHadronization::recomb() {
 
           //Checking if baryon is formed (either ground or excited state)
           double rndbaryon = ran();
+          if (reco_check && (reco_cutoff > 0.)) {
+            count_reco_check(pruned3, WigB[1] * recofactor3, rndbaryon);
+          }
 
           if (WigB[1] * recofactor3 >= rndbaryon) {
             //*******************************************string repair functionality below*******************************************
@@ -2207,6 +2385,10 @@ void HybridHadronization::recomb() {
 
         //Checking if meson is formed (either ground or excited state)
         double rndmeson = ran();
+        if (reco_check && (reco_cutoff > 0.)) {
+          count_reco_check(q1_relmom2[q2] > reco_q2max_meson[nth2],
+                           WigM[1] * recofactor2, rndmeson);
+        }
 
         if (WigM[1] * recofactor2 >= rndmeson) {
           //*******************************************string repair functionality below*******************************************
@@ -2515,6 +2697,17 @@ void HybridHadronization::recomb() {
   //since we've already read in the thermal parton array, can use that to get the 'fake' parton for the necessary string, if present?
   //include color after completion?
 
+  if (reco_check && (reco_cutoff > 0.)) {
+    JSINFO << "Recombination pruning check in this event: "
+           << reco_pruned_formed << " of "
+           << reco_formed << " hadrons came from candidates below "
+           << reco_cutoff << ", " << reco_bound_violations
+           << " candidates above it would have been skipped";
+    if (reco_bound_violations > 0) {
+      JSWARN << "Recombination pruning skips candidates above the cutoff!";
+    }
+  }
+
   //end of recombination routine
 }
 
@@ -6042,7 +6235,7 @@ void HybridHadronization::stringprep(parton_collection &SP_remnants,
 }
 
 //function to hand partons/strings and hadron resonances (and various other color neutral and colored objects) to Pythia8
-bool HybridHadronization::invoke_py() {
+bool HybridHadronization::invoke_py(Pythia &pythia) {
 
   Event &event = pythia.event;
 
@@ -18,7 +18,7 @@
 
 #include "HadronizationModule.h"
 #include "JetScapeLogger.h"
-#include "Pythia8/Pythia.h"
+#include "JetScapePythiaPool.h"
 
 #include <cmath>
 #include <random>
@@ -33,6 +33,7 @@ public:
   virtual ~HybridHadronization();
 
   void Init();
+  void Reseed();
   void DoHadronization(vector<vector<shared_ptr<Parton>>> &shower,
                        vector<shared_ptr<Hadron>> &hOut,
                        vector<shared_ptr<Parton>> &pOut);
@@ -58,6 +59,17 @@ private:
       SigObccR2, SigObccL2, SigObcR2, SigObcL2, SigXibcR2, SigXibcL2, SigObR2,
       SigObL2, SigXibR2, SigXibL2, SigSigbR2, SigSigbL2;
   double SigPi2, SigPhi2, SigK2, SigJpi2, SigDs2, SigD2, SigUps2, SigBc2, SigB2;
+
+  //recombination candidates whose Wigner probability (times recofactor) is provably below reco_cutoff are skipped
+  //the bound only uses the relative momenta of the partons; reco_check keeps the full search and counts what pruning would change
+  double reco_cutoff;
+  int reco_check;
+  //largest squared pair rest frame momentum [GeV^2] that can pass reco_cutoff, by number of thermal partons
+  double reco_q2max_meson[2], reco_q2max_baryon[3];
+  unsigned long reco_formed, reco_pruned_formed, reco_bound_violations;
+  void set_reco_pruning();
+  double wigner_sum(double u);
+  void count_reco_check(bool pruned, double prob, double rnd);
   const double pi = 3.1415926535897932384626433832795;
   int attempts_max;
   unsigned int rand_seed;
@@ -108,6 +120,22 @@ private:
     return vec_out;
   }
 
+  //squared momentum of either particle in the rest frame of the pair, from the invariants
+  //returns 0 (never pruned) unless both 4-vectors and their sum are timelike
+  static double relmom2(FourVector p1, FourVector p2) {
+    double p1p2 = p1.t() * p2.t() - p1.x() * p2.x() - p1.y() * p2.y() -
+                  p1.z() * p2.z();
+    double m1sq = p1.t() * p1.t() - p1.x() * p1.x() - p1.y() * p1.y() -
+                  p1.z() * p1.z();
+    double m2sq = p2.t() * p2.t() - p2.x() * p2.x() - p2.y() * p2.y() -
+                  p2.z() * p2.z();
+    double s = m1sq + m2sq + 2. * p1p2;
+    if (m1sq <= 0. || m2sq <= 0. || s <= 0.) {
+      return 0.;
+    }
+    return (p1p2 * p1p2 - m1sq * m2sq) / s;
+  }
+
   //3-vec (4-vec w/3 components) diff^2 function
   static double dif2(FourVector vec1, FourVector vec2) {
     return (vec2.x() - vec1.x()) * (vec2.x() - vec1.x()) +
@@ -481,10 +509,10 @@ private:
                   parton_collection &SP_prepremn, bool cutstr);
 
   //function to hand partons/strings and hadron resonances (and other color neutral objects) to Pythia8
-  bool invoke_py();
+  bool invoke_py(Pythia8::Pythia &pythia);
 
 protected:
-  static Pythia8::Pythia pythia;
+  shared_ptr<JetScapePythiaPool> pythia_pool;
 };
 
 #endif // HYBRIDHADRONIZATION_H
@@ -81,36 +81,41 @@ void Brick::GetHydroInfo(
     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
   // create the unique FluidCellInfo here
   fluid_cell_info_ptr = make_unique<FluidCellInfo>();
+  FillHydroCell(t, x, y, z, *fluid_cell_info_ptr);
+}
 
+void Brick::FillHydroCell(Jetscape::real t, Jetscape::real x,
+                          Jetscape::real y, Jetscape::real z,
+                          FluidCellInfo &fluid_cell_info) {
   // assign all the quantites to JETSCAPE output
   // thermodyanmic quantities
 
   if (hydro_status == FINISHED) {
-    fluid_cell_info_ptr->energy_density = 0.0;
-    fluid_cell_info_ptr->entropy_density = 0.0;
+    fluid_cell_info.energy_density = 0.0;
+    fluid_cell_info.entropy_density = 0.0;
     if (bjorken_expansion_on) {
-      fluid_cell_info_ptr->temperature =
+      fluid_cell_info.temperature =
           T_brick * std::pow(start_time / t, 1.0 / 3.0);
     } else {
-      fluid_cell_info_ptr->temperature = T_brick;
+      fluid_cell_info.temperature = T_brick;
     }
-    fluid_cell_info_ptr->pressure = 0.0;
+    fluid_cell_info.pressure = 0.0;
     // QGP fraction
-    fluid_cell_info_ptr->qgp_fraction = 1.0;
+    fluid_cell_info.qgp_fraction = 1.0;
     // chemical potentials
-    fluid_cell_info_ptr->mu_B = 0.0;
-    fluid_cell_info_ptr->mu_C = 0.0;
-    fluid_cell_info_ptr->mu_S = 0.0;
+    fluid_cell_info.mu_B = 0.0;
+    fluid_cell_info.mu_C = 0.0;
+    fluid_cell_info.mu_S = 0.0;
     // dynamical quantites
-    fluid_cell_info_ptr->vx = 0.0;
-    fluid_cell_info_ptr->vy = 0.0;
-    fluid_cell_info_ptr->vz = 0.0;
+    fluid_cell_info.vx = 0.0;
+    fluid_cell_info.vy = 0.0;
+    fluid_cell_info.vz = 0.0;
     for (int i = 0; i < 4; i++) {
       for (int j = 0; j < 4; j++) {
-        fluid_cell_info_ptr->pi[i][j] = 0.0;
+        fluid_cell_info.pi[i][j] = 0.0;
       }
     }
-    fluid_cell_info_ptr->bulk_Pi = 0.0;
+    fluid_cell_info.bulk_Pi = 0.0;
   } else {
     JSWARN << "Hydro not run yet ...";
     exit(-1);
@@ -41,6 +41,8 @@ public:
   void GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                     Jetscape::real z,
                     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
+  void FillHydroCell(Jetscape::real t, Jetscape::real x, Jetscape::real y,
+                     Jetscape::real z, FluidCellInfo &fluid_cell_info);
 
   void GetHyperSurface(Jetscape::real T_cut,
                        SurfaceCellInfo *surface_list_ptr){};
@@ -86,12 +86,15 @@ void CLVisc::InitializeHydro(Parameter parameter_list) {
 void CLVisc::EvolveHydro() {
   VERBOSE(8);
   JSINFO << "Initialize density profiles in CLVisc ...";
-  std::vector<double> entropy_density = ini->GetEntropyDensityDistribution();
+  const std::vector<double> &initial_entropy_density =
+      ini->GetEntropyDensityDistribution();
   double dx = ini->GetXStep();
   if (pre_eq_ptr == nullptr) {
     if (initial_condition_scale_factor == 1.0) {
-      hydro_->read_ini(entropy_density);
+      hydro_->read_ini(initial_entropy_density);
     } else {
+      // only the rescaled profile needs a copy
+      std::vector<double> entropy_density = initial_entropy_density;
       std::for_each(
           entropy_density.begin(), entropy_density.end(),
           [&](double &sd) { sd = initial_condition_scale_factor * sd; });
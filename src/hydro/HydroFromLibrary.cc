@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#include "JetScapeLogger.h"
+#include "HydroFromLibrary.h"
+
+using namespace Jetscape;
+
+// Register the module with the base class
+RegisterJetScapeModule<HydroFromLibrary>
+    HydroFromLibrary::reg("HydroFromLibrary");
+
+HydroFromLibrary::HydroFromLibrary() {
+  hydro_status = NOT_START;
+  first_event_ = 0;
+  n_reuse_hydro_ = 1;
+  SetId("HydroFromLibrary");
+}
+
+HydroFromLibrary::~HydroFromLibrary() {}
+
+void HydroFromLibrary::InitializeHydro(Parameter parameter_list) {
+  VERBOSE(8);
+  std::string file_name =
+      GetXMLElementText({"Hydro", "hydro_from_library", "library_file"});
+  library_.reset(new HydroEventLibrary(file_name));
+  if (library_->GetNumberOfEvents() == 0) {
+    throw std::runtime_error("HydroFromLibrary: no events in " + file_name);
+  }
+  first_event_ =
+      GetXMLElementInt({"Hydro", "hydro_from_library", "first_event"}, false);
+
+  // the hydro only runs for every n_reuse_hydro_-th event
+  n_reuse_hydro_ = 1;
+  std::string reuse_hydro = GetXMLElementText({"setReuseHydro"}, false);
+  int n_reuse_hydro = GetXMLElementInt({"nReuseHydro"}, false);
+  if ((int)reuse_hydro.find("true") >= 0 && n_reuse_hydro > 0) {
+    n_reuse_hydro_ = n_reuse_hydro;
+  }
+
+  JSINFO << "Hydro events from " << file_name << " ("
+         << library_->GetNumberOfEvents() << " events), starting at event "
+         << first_event_;
+  hydro_status = INITIALIZED;
+}
+
+void HydroFromLibrary::EvolveHydro() {
+  VERBOSE(8);
+  // by event number, so that worker processes pick different events,
+  // starting over after the last one
+  int event = (first_event_ + GetCurrentEvent() / n_reuse_hydro_) %
+              library_->GetNumberOfEvents();
+  library_->Load(event, bulk_info);
+  hydro_tau_0 = bulk_info.Tau0();
+  hydro_tau_max = bulk_info.TauMax();
+  JSINFO << "Using hydro event " << event << " of the library, "
+         << bulk_info.get_data_size() << " fluid cells";
+  hydro_status = FINISHED;
+}
+
+void HydroFromLibrary::GetHydroInfo(
+    Jetscape::real t, Jetscape::real x, Jetscape::real y, Jetscape::real z,
+    std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
+  fluid_cell_info_ptr = std::unique_ptr<FluidCellInfo>(
+      new FluidCellInfo(bulk_info.get_tz(t, x, y, z)));
+}
+
+void HydroFromLibrary::GetHydroCells(FluidCellBatch &cells) {
+  bulk_info.get_tz_batch(cells);
+}
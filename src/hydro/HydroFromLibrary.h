@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) The JETSCAPE Collaboration, 2018
+ *
+ * Modular, task-based framework for simulating all aspects of heavy-ion collisions
+ *
+ * For the list of contributors see AUTHORS.
+ *
+ * Report issues at https://github.com/JETSCAPE/JETSCAPE/issues
+ *
+ * or via email to bugs.jetscape@gmail.com
+ *
+ * Distributed under the GNU General Public License 3.0 (GPLv3 or later).
+ * See COPYING for details.
+ ******************************************************************************/
+
+#ifndef HYDROFROMLIBRARY_H
+#define HYDROFROMLIBRARY_H
+
+#include "FluidDynamics.h"
+#include "HydroEventLibrary.h"
+
+#include <memory>
+
+using namespace Jetscape;
+
+class HydroFromLibrary : public FluidDynamics {
+  // reads evolution histories written to a HydroEventLibrary, e.g. by
+  // MUSIC with <Hydro><evolutionLibraryOutput>, in place from the file
+private:
+  std::unique_ptr<HydroEventLibrary> library_;
+  int first_event_;
+  int n_reuse_hydro_;
+
+  // Allows the registration of the module so that it is available to be used by the Jetscape framework.
+  static RegisterJetScapeModule<HydroFromLibrary> reg;
+
+public:
+  HydroFromLibrary();
+  ~HydroFromLibrary();
+
+  //! This function opens the library
+  void InitializeHydro(Parameter parameter_list);
+
+  //! This function maps the library event of the current event into bulk_info
+  void EvolveHydro();
+
+  //! This function provide fluid cell information at a given
+  //! space-time point
+  void GetHydroInfo(Jetscape::real t, Jetscape::real x, Jetscape::real y,
+                    Jetscape::real z,
+                    std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
+  void GetHydroCells(FluidCellBatch &cells);
+  MediumHandle GetMediumHandle() { return MediumHandle(this, &bulk_info); }
+
+  void GetHyperSurface(Jetscape::real T_cut,
+                       SurfaceCellInfo *surface_list_ptr){};
+};
+
+#endif // HYDROFROMLIBRARY_H
@@ -17,6 +17,7 @@
 #include <sys/stat.h>
 #include <MakeUniqueHelper.h>
 
+#include <cstdio>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -146,7 +147,6 @@ void MpiMusic::InitializeHydro(Parameter parameter_list) {
 void MpiMusic::EvolveHydro() {
   VERBOSE(8);
   JSINFO << "Initialize density profiles in MUSIC ...";
-  std::vector<double> entropy_density = ini->GetEntropyDensityDistribution();
   double dx = ini->GetXStep();
   double dz = ini->GetZStep();
   double z_max = ini->GetZMax();
@@ -187,15 +187,14 @@ void MpiMusic::EvolveHydro() {
       // in memory for jet energy loss calculations
       PassHydroEvolutionHistoryToFramework();
       JSINFO << "number of fluid cells received by the JETSCAPE: "
-             << bulk_info.data.size();
+             << bulk_info.get_data_size();
     }
     music_hydro_ptr->clear_hydro_info_from_memory();
 
     // add hydro_id to the hydro evolution filename
-    std::ostringstream system_command;
-    system_command << "mv evolution_all_xyeta.dat "
-                   << "evolution_all_xyeta_" << GetId() << ".dat";
-    system(system_command.str().c_str());
+    std::string evolution_filename =
+        "evolution_all_xyeta_" + GetId() + ".dat";
+    std::rename("evolution_all_xyeta.dat", evolution_filename.c_str());
 
     //std::vector<SurfaceCellInfo> surface_cells;
     //if (freezeout_temperature > 0.0) {
@@ -259,29 +258,32 @@ void MpiMusic::PassHydroEvolutionHistoryToFramework() {
 
   SetHydroGridInfo();
 
+  // one cell at a time into the layout bulk_info keeps, see
+  // FluidDynamics::SetEvolutionStorage()
+  bulk_info.ReserveCells(number_of_cells);
   fluidCell *fluidCell_ptr = new fluidCell;
+  FluidCellInfo fluid_cell_info;
   for (int i = 0; i < number_of_cells; i++) {
-    std::unique_ptr<FluidCellInfo> fluid_cell_info_ptr(new FluidCellInfo);
     music_hydro_ptr->get_fluid_cell_with_index(i, fluidCell_ptr);
 
-    fluid_cell_info_ptr->energy_density = fluidCell_ptr->ed;
-    fluid_cell_info_ptr->entropy_density = fluidCell_ptr->sd;
-    fluid_cell_info_ptr->temperature = fluidCell_ptr->temperature;
-    fluid_cell_info_ptr->pressure = fluidCell_ptr->pressure;
-    fluid_cell_info_ptr->vx = fluidCell_ptr->vx;
-    fluid_cell_info_ptr->vy = fluidCell_ptr->vy;
-    fluid_cell_info_ptr->vz = fluidCell_ptr->vz;
-    fluid_cell_info_ptr->mu_B = 0.0;
-    fluid_cell_info_ptr->mu_C = 0.0;
-    fluid_cell_info_ptr->mu_S = 0.0;
-    fluid_cell_info_ptr->qgp_fraction = 0.0;
+    fluid_cell_info.energy_density = fluidCell_ptr->ed;
+    fluid_cell_info.entropy_density = fluidCell_ptr->sd;
+    fluid_cell_info.temperature = fluidCell_ptr->temperature;
+    fluid_cell_info.pressure = fluidCell_ptr->pressure;
+    fluid_cell_info.vx = fluidCell_ptr->vx;
+    fluid_cell_info.vy = fluidCell_ptr->vy;
+    fluid_cell_info.vz = fluidCell_ptr->vz;
+    fluid_cell_info.mu_B = 0.0;
+    fluid_cell_info.mu_C = 0.0;
+    fluid_cell_info.mu_S = 0.0;
+    fluid_cell_info.qgp_fraction = 0.0;
     for (int i = 0; i < 4; i++) {
       for (int j = 0; j < 4; j++) {
-        fluid_cell_info_ptr->pi[i][j] = fluidCell_ptr->pi[i][j];
+        fluid_cell_info.pi[i][j] = fluidCell_ptr->pi[i][j];
       }
     }
-    fluid_cell_info_ptr->bulk_Pi = fluidCell_ptr->bulkPi;
-    StoreHydroEvolutionHistory(fluid_cell_info_ptr);
+    fluid_cell_info.bulk_Pi = fluidCell_ptr->bulkPi;
+    bulk_info.StoreCell(fluid_cell_info);
   }
   delete fluidCell_ptr;
 }
@@ -300,6 +302,10 @@ void MpiMusic::GetHydroInfo_JETSCAPE(
   fluid_cell_info_ptr = std::unique_ptr<FluidCellInfo>(new FluidCellInfo(temp));
 }
 
+void MpiMusic::GetHydroCells(FluidCellBatch &cells) {
+  bulk_info.get_tz_batch(cells);
+}
+
 void MpiMusic::GetHydroInfo_MUSIC(
     Jetscape::real t, Jetscape::real x, Jetscape::real y, Jetscape::real z,
     std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr) {
@@ -109,6 +109,8 @@ public:
   void GetHydroInfo_MUSIC(Jetscape::real t, Jetscape::real x, Jetscape::real y,
                           Jetscape::real z,
                           std::unique_ptr<FluidCellInfo> &fluid_cell_info_ptr);
+  void GetHydroCells(FluidCellBatch &cells);
+  MediumHandle GetMediumHandle() { return MediumHandle(this, &bulk_info); }
 
   void SetHydroGridInfo();
   void PassHydroEvolutionHistoryToFramework();
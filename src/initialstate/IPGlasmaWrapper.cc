@@ -43,12 +43,12 @@ void IPGlasmaWrapper::InitTask() {
 
 void IPGlasmaWrapper::Exec() {
     Clear();
-    Jetscape::JSINFO << "Run IPGlasma ...";
+    JSINFO << "Run IPGlasma ...";
     try {
         IPGlasma_ptr_->generateAnEvent(event_id_);
         event_id_++;
     } catch (std::exception &err) {
-        Jetscape::JSWARN << err.what();
+        JSWARN << err.what();
         std::exit(-1);
     }
     ReadNbcList("NcollList0.dat");
@@ -56,16 +56,16 @@ void IPGlasmaWrapper::Exec() {
 
 
 void IPGlasmaWrapper::Clear() {
-    Jetscape::JSINFO << "clear initial condition vectors";
+    JSINFO << "clear initial condition vectors";
 }
 
 
 void IPGlasmaWrapper::ReadNbcList(std::string filename) {
-    Jetscape::JSINFO << "Read in binary collision list from "
-                     << filename << "...";
+    JSINFO << "Read in binary collision list from "
+           << filename << "...";
     std::ifstream infile(filename.c_str());
     if (!infile.good()) {
-        Jetscape::JSWARN << "Can not open " << filename;
+        JSWARN << "Can not open " << filename;
         exit(1);
     }
 
@@ -80,7 +80,7 @@ void IPGlasmaWrapper::ReadNbcList(std::string filename) {
     ncoll_ = binary_collision_x_.size();
     rand_int_ptr_ = (
         std::make_shared<std::uniform_int_distribution<int>>(0, ncoll_-1));
-    Jetscape::JSINFO << "Ncoll = " << ncoll_;
+    JSINFO << "Ncoll = " << ncoll_;
 }
 
 
@@ -32,7 +32,7 @@ void InitialFromFile::InitTask() {}
 
 void InitialFromFile::Exec() {
   Clear();
-  Jetscape::JSINFO << "Read initial condition from file";
+  JSINFO << "Read initial condition from file";
   try {
 
     std::string initialProfilePath =
@@ -61,20 +61,20 @@ void InitialFromFile::Exec() {
     status = H5Fclose(H5file_ptr_);
 
   } catch (std::exception &err) {
-    Jetscape::JSWARN << err.what();
+    JSWARN << err.what();
     std::exit(-1);
   }
 }
 
 void InitialFromFile::ReadConfigs() {
-  Jetscape::JSINFO << "Read initial state configurations from file";
+  JSINFO << "Read initial state configurations from file";
   double grid_step = h5_helper_->readH5Attribute_double(H5group_ptr_, "dxy");
   dim_x_ = h5_helper_->readH5Attribute_int(H5group_ptr_, "Nx");
   dim_y_ = h5_helper_->readH5Attribute_int(H5group_ptr_, "Ny");
   double xmax = dim_x_ * grid_step / 2;
   SetRanges(xmax, xmax, 0.0);
   SetSteps(grid_step, grid_step, 0.0);
-  Jetscape::JSINFO << "xmax = " << xmax;
+  JSINFO << "xmax = " << xmax;
 
   npart = h5_helper_->readH5Attribute_double(H5group_ptr_, "npart");
   ncoll = h5_helper_->readH5Attribute_double(H5group_ptr_, "ncoll");
@@ -82,7 +82,7 @@ void InitialFromFile::ReadConfigs() {
 }
 
 void InitialFromFile::ReadNbcDist() {
-  Jetscape::JSINFO << "Read number of binary collisions from file";
+  JSINFO << "Read number of binary collisions from file";
   auto dataset = H5Dopen(H5group_ptr_, "Ncoll_density", H5P_DEFAULT);
   int dimx = dim_x_;
   int dimy = dim_y_;
@@ -94,11 +94,12 @@ void InitialFromFile::ReadNbcDist() {
       num_of_binary_collisions_.push_back(temp_data[i][j]);
     }
   }
+  BuildBinaryCollisionSampler();
   status = H5Dclose(dataset);
 }
 
 void InitialFromFile::ReadEntropyDist() {
-  Jetscape::JSINFO << "Read initial entropy density distribution from file";
+  JSINFO << "Read initial entropy density distribution from file";
   auto dataset = H5Dopen(H5group_ptr_, "matter_density", H5P_DEFAULT);
   int dimx = dim_x_;
   int dimy = dim_y_;
@@ -114,9 +115,10 @@ void InitialFromFile::ReadEntropyDist() {
 }
 
 void InitialFromFile::Clear() {
-  Jetscape::JSINFO << "clear initial condition vectors";
+  JSINFO << "clear initial condition vectors";
   entropy_density_distribution_.clear();
   num_of_binary_collisions_.clear();
+  ClearBinaryCollisionSampler();
 }
 
 void InitialFromFile::Write(weak_ptr<JetScapeWriter> w) {}
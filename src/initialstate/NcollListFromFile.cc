@@ -30,7 +30,7 @@ NcollListFromFile::~NcollListFromFile() {}
 
 void NcollListFromFile::Exec() {
   Clear();
-  Jetscape::JSINFO << "Read binary collision list from file ...";
+  JSINFO << "Read binary collision list from file ...";
   try {
     std::string initialProfilePath =
         GetXMLElementText({"IS", "initial_Ncoll_list"});
@@ -43,24 +43,24 @@ void NcollListFromFile::Exec() {
 
     ReadNbcList(path_with_filename.str());
   } catch (std::exception &err) {
-    Jetscape::JSWARN << err.what();
+    JSWARN << err.what();
     std::exit(-1);
   }
 }
 
 
 void NcollListFromFile::Clear() {
-  Jetscape::JSINFO << "clear initial condition vectors";
+  JSINFO << "clear initial condition vectors";
   binary_collision_x_.clear();
   binary_collision_y_.clear();
 }
 
 
 void NcollListFromFile::ReadNbcList(std::string filename) {
-  Jetscape::JSINFO << "Read in binary collision list ...";
+  JSINFO << "Read in binary collision list ...";
   std::ifstream infile(filename.c_str());
   if (!infile.good()) {
-    Jetscape::JSWARN << "Can not open " << filename;
+    JSWARN << "Can not open " << filename;
     exit(1);
   }
 
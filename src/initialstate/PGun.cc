@@ -16,15 +16,13 @@
 
 #include "PGun.h"
 #include "JetScapeParticles.h"
-#include "Pythia8/Pythia.h"
+#include "JetScapeParticleData.h"
 
 using namespace Jetscape;
 
 // Register the module with the base class
 RegisterJetScapeModule<PGun> PGun::reg("PGun");
 
-Pythia8::Pythia PGun::InternalHelperPythia("IntentionallyEmpty", false);
-
 PGun::PGun() : HardProcess() {
   fixed_pT = 0;
   parID = 21;
@@ -78,7 +76,7 @@ void PGun::Exec() {
   //	 if(tempRand < 0.50) parID = -parID;
   //      }
   //     mass = 0.0;
-  mass = InternalHelperPythia.particleData.m0(parID);
+  mass = JetScapeParticleData::Instance().m0(parID);
   //JSINFO << BOLDYELLOW << " Mass = " << mass ;
   pT = fixed_pT; //max_pT*(rand()/maxN);
 
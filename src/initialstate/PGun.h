@@ -19,14 +19,11 @@
 
 #include "HardProcess.h"
 #include "JetScapeLogger.h"
-#include "Pythia8/Pythia.h"
 
 using namespace Jetscape;
 
 class PGun : public HardProcess {
 
-  static Pythia8::Pythia InternalHelperPythia;
-
 private:
   double fixed_pT;
   double parID;
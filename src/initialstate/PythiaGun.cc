@@ -149,6 +149,21 @@ void PythiaGun::InitTask() {
     
 }
 
+// Forked workers keep the initialized Pythia and only restart its random
+// numbers from their own seed
+void PythiaGun::Reseed() {
+  HardProcess::Reseed();
+  tinyxml2::XMLElement *xmle = GetXMLElement({"Random", "seed"}, false);
+  if (!xmle) {
+    return;
+  }
+  unsigned int seed = 0;
+  xmle->QueryUnsignedText(&seed);
+  VERBOSE(7) << "Reseeding pythia to " << seed;
+  readString("Random:seed = " + std::to_string(seed));
+  rndm.init(settings.mode("Random:seed"));
+}
+
 void PythiaGun::Exec() {
   VERBOSE(1) << "Run Hard Process : " << GetId() << " ...";
   VERBOSE(8) << "Current Event #" << GetCurrentEvent();
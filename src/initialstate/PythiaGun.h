@@ -50,6 +50,7 @@ public:
 
   void InitTask();
   void Exec();
+  void Reseed();
 
   // Getters
   double GetpTHatMin() const { return pTHatMin; }
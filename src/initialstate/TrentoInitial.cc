@@ -404,6 +404,7 @@ void TrentoInitial::Exec() {
   for (int i = 0; i < ncoll_field.num_elements(); i++) {
     num_of_binary_collisions_.push_back(ncoll_field.data()[i]);
   }
+  BuildBinaryCollisionSampler();
   JSINFO << " TRENTO event generated and loaded ";
 }
 
@@ -411,6 +412,7 @@ void TrentoInitial::Clear() {
   VERBOSE(2) << " : Finish creating initial condition ";
   entropy_density_distribution_.clear();
   num_of_binary_collisions_.clear();
+  ClearBinaryCollisionSampler();
 }
 
 } // end namespace Jetscape
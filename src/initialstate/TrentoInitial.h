@@ -64,6 +64,8 @@ public:
   void Exec();
   void Clear();
   void InitTask();
+  // the random seed is built into the generator made by InitTask
+  bool InitInWorkers() const { return true; }
 
   struct RangeFailure : public std::runtime_error {
     using std::runtime_error::runtime_error;
@@ -123,7 +123,7 @@ void AdSCFT::DoEnergyLoss(double deltaT, double time, double Q2,
     x[3] = pIn[i].x_in().t() + (time - initR0) * w[3];
 
     //Extract fluid properties
-    std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+    FluidCellInfo check_fluid_info;
     double tau = std::sqrt(x[3] * x[3] - x[2] * x[2]);
     double temp, vx, vy, vz;
     //Only get a temp!=0 if in_vac=0
@@ -131,7 +131,7 @@ void AdSCFT::DoEnergyLoss(double deltaT, double time, double Q2,
     if (tau >= tStart &&
         !in_vac) //Should use tau, not t, in absence of preequilibrium eloss
     {
-      GetHydroCellSignal(x[3], x[0], x[1], x[2], check_fluid_info_ptr);
+      GetMediumCell(x[3], x[0], x[1], x[2], check_fluid_info);
       if (!GetJetSignalConnected()) {
         JSWARN << "Couldn't find a hydro module attached!";
         throw std::runtime_error(
@@ -139,12 +139,12 @@ void AdSCFT::DoEnergyLoss(double deltaT, double time, double Q2,
       }
 
       VERBOSE(8) << MAGENTA << "Temperature from Brick (Signal) = "
-                 << check_fluid_info_ptr->temperature;
+                 << check_fluid_info.temperature;
 
-      temp = check_fluid_info_ptr->temperature;
-      vx = check_fluid_info_ptr->vx;
-      vy = check_fluid_info_ptr->vy;
-      vz = check_fluid_info_ptr->vz;
+      temp = check_fluid_info.temperature;
+      vx = check_fluid_info.vx;
+      vy = check_fluid_info.vy;
+      vz = check_fluid_info.vz;
     } else
       temp = 0., vx = 0., vy = 0., vz = 0.;
     JSDEBUG << " system time= " << time << " parton time= " << x[3]
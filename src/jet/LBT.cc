@@ -26,6 +26,16 @@
 
 #include "FluidDynamics.h"
 #include "LBTMutex.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #define MAGENTA "\033[35m"
 
 using namespace Jetscape;
@@ -35,7 +45,7 @@ using namespace std;
 RegisterJetScapeModule<LBT> LBT::reg("Lbt");
 
 // initialize static members
-bool LBT::flag_init = 0;
+std::once_flag LBT::tables_loaded;
 double LBT::Rg[60][20] = {
     {0.0}}; //total gluon scattering rate as functions of initial energy and temperature
 double LBT::Rg1[60][20] = {{0.0}}; //gg-gg              CT1
@@ -57,21 +67,23 @@ double LBT::RHQ11[60][20] = {{0.0}};  //Qq->Qq
 double LBT::RHQ12[60][20] = {{0.0}};  //Qg->Qg
 double LBT::qhatHQ[60][20] = {{0.0}}; //qhat of heavy quark
 
-double LBT::dNg_over_dt_c[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::dNg_over_dt_q[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::dNg_over_dt_g[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::max_dNgfnc_c[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::max_dNgfnc_q[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
-double LBT::max_dNgfnc_g[t_gn + 2][temp_gn + 1][HQener_gn + 1] = {{{0.0}}};
+LBT::RadiationTable *LBT::dNg_over_dt_c = nullptr;
+LBT::RadiationTable *LBT::dNg_over_dt_q = nullptr;
+LBT::RadiationTable *LBT::dNg_over_dt_g = nullptr;
+LBT::RadiationTable *LBT::max_dNgfnc_c = nullptr;
+LBT::RadiationTable *LBT::max_dNgfnc_q = nullptr;
+LBT::RadiationTable *LBT::max_dNgfnc_g = nullptr;
 
 double LBT::initMCX[maxMC] = {0.0};
 double LBT::initMCY[maxMC] = {0.0};
-double LBT::distFncB[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distFncF[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distMaxB[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distMaxF[N_T][N_p1][N_e2] = {{{0.0}}};
-double LBT::distFncBM[N_T][N_p1] = {{0.0}};
-double LBT::distFncFM[N_T][N_p1] = {{0.0}};
+LBT::DistTable *LBT::distFncB = nullptr;
+LBT::DistTable *LBT::distFncF = nullptr;
+LBT::DistTable *LBT::distMaxB = nullptr;
+LBT::DistTable *LBT::distMaxF = nullptr;
+double (*LBT::distFncBM)[N_p1] = nullptr;
+double (*LBT::distFncFM)[N_p1] = nullptr;
+
+const char *LBT::BinaryTablesFile = "LBT-tables/LBT-tables.bin";
 
 LBT::LBT() {
   SetId("LBT");
@@ -127,10 +139,9 @@ void LBT::Init() {
          << " Q0: " << Q00 << "  only_leading: " << Kprimary
          << "  alpha_s: " << fixAlphas << "  hydro_Tc: " << hydro_Tc<<", tStart="<<tStart;
 
-  if (!flag_init) {
-    read_tables(); // initialize various tables
-    flag_init = true;
-  }
+  // initialize various tables, once for all instances; they are only read
+  // afterwards, so that the copies made for each shower can run concurrently
+  std::call_once(tables_loaded, [this]() { read_tables(); });
 
   //...define derived quantities
   temp00 = temp0;
@@ -142,10 +153,8 @@ void LBT::Init() {
   //...Debye Mass square
   qhat0 = DebyeMass2(Kqhat0, alphas, temp0);
 
-  //...initialize the random number generator
-  srand((unsigned)time(NULL));
-  NUM1 = -1 * rand();
-  //    NUM1=-33;
+  //...random numbers are drawn from the framework engine, see ran0()
+  ZeroOneDistribution = uniform_real_distribution<double>{0.0, 1.0};
 }
 
 void LBT::WriteTask(weak_ptr<JetScapeWriter> w) {
@@ -234,7 +243,7 @@ void LBT::DoEnergyLoss(double deltaT, double time, double Q2,
       V[1][j] = Vfrozen[1][j];
       V[2][j] = Vfrozen[2][j];
       V[3][j] = Vfrozen[3][j];
-      V[0][j] = -log(1.0 - ran0(&NUM1));
+      V[0][j] = -log(1.0 - ran0());
 
       for (int k = 0; k <= 3; k++)
         Prad[k][j] = P[k][j];
@@ -279,7 +288,7 @@ void LBT::DoEnergyLoss(double deltaT, double time, double Q2,
       V0[1][j] = Vfrozen0[1][j];
       V0[2][j] = Vfrozen0[2][j];
       V0[3][j] = Vfrozen0[3][j];
-      V0[0][j] = -log(1.0 - ran0(&NUM1));
+      V0[0][j] = -log(1.0 - ran0());
 
       // for(int k=0;k<=3;k++) Prad[k][j] = P[k][j];
 
@@ -645,18 +654,18 @@ void LBT::LBT0(int &n, double &ti) {
         //              } else if(bulkFlag==0) { // static medium
 
         //Extract fluid properties
-        std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+        FluidCellInfo check_fluid_info;
 
         SpatialRapidity = 0.5 * std::log((tcar0 + zcar0) / (tcar0 - zcar0));
 
-        GetHydroCellSignal(tcar0, xcar0, ycar0, zcar0, check_fluid_info_ptr);
-        //VERBOSE(7)<< MAGENTA<<"Temperature from Brick (Signal) = "<<check_fluid_info_ptr->temperature;
+        GetMediumCell(tcar0, xcar0, ycar0, zcar0, check_fluid_info);
+        //VERBOSE(7)<< MAGENTA<<"Temperature from Brick (Signal) = "<<check_fluid_info.temperature;
 
-        temp00 = check_fluid_info_ptr->temperature;
-        sd00 = check_fluid_info_ptr->entropy_density;
-        VX00 = check_fluid_info_ptr->vx;
-        VY00 = check_fluid_info_ptr->vy;
-        VZ00 = check_fluid_info_ptr->vz;
+        temp00 = check_fluid_info.temperature;
+        sd00 = check_fluid_info.entropy_density;
+        VX00 = check_fluid_info.vx;
+        VY00 = check_fluid_info.vy;
+        VZ00 = check_fluid_info.vz;
 
         if (tcar0 < tStart * cosh(SpatialRapidity)) {
           temp00 = 0.0;
@@ -738,12 +747,12 @@ void LBT::LBT0(int &n, double &ti) {
           //VY=0.0;
           //VZ=0.0;
 
-          std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+          FluidCellInfo check_fluid_info;
 
           SpatialRapidity = 0.5 * std::log((tcar + zcar) / (tcar - zcar));
 
-          GetHydroCellSignal(tcar, xcar, ycar, zcar, check_fluid_info_ptr);
-          //VERBOSE(7)<< MAGENTA<<"Temperature from Brick (Signal) = "<<check_fluid_info_ptr->temperature;
+          GetMediumCell(tcar, xcar, ycar, zcar, check_fluid_info);
+          //VERBOSE(7)<< MAGENTA<<"Temperature from Brick (Signal) = "<<check_fluid_info.temperature;
 
           if (!GetJetSignalConnected()) {
             JSWARN << "Couldn't find a hydro module attached!";
@@ -751,11 +760,11 @@ void LBT::LBT0(int &n, double &ti) {
                                      "in_vac to 1 in the XML file");
           }
 
-          temp0 = check_fluid_info_ptr->temperature;
-          sd = check_fluid_info_ptr->entropy_density;
-          VX = check_fluid_info_ptr->vx;
-          VY = check_fluid_info_ptr->vy;
-          VZ = check_fluid_info_ptr->vz;
+          temp0 = check_fluid_info.temperature;
+          sd = check_fluid_info.entropy_density;
+          VX = check_fluid_info.vx;
+          VY = check_fluid_info.vy;
+          VZ = check_fluid_info.vz;
 
           if (tcar < tStart * cosh(SpatialRapidity)) {
             temp0 = 0.0;
@@ -968,15 +977,15 @@ void LBT::LBT0(int &n, double &ti) {
           else
             dtLoc = ti - tLoc;
 
-          std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+          FluidCellInfo check_fluid_info;
 
           SpatialRapidity = 0.5 * std::log((tLoc + zLoc) / (tLoc - zLoc));
 
-          GetHydroCellSignal(tLoc, xLoc, yLoc, zLoc, check_fluid_info_ptr);
-          tempLoc = check_fluid_info_ptr->temperature;
-          vxLoc = check_fluid_info_ptr->vx;
-          vyLoc = check_fluid_info_ptr->vy;
-          vzLoc = check_fluid_info_ptr->vz;
+          GetMediumCell(tLoc, xLoc, yLoc, zLoc, check_fluid_info);
+          tempLoc = check_fluid_info.temperature;
+          vxLoc = check_fluid_info.vx;
+          vyLoc = check_fluid_info.vy;
+          vzLoc = check_fluid_info.vz;
 
           if (tLoc < tStart * cosh(SpatialRapidity)) {
             tempLoc = 0.0;
@@ -1064,7 +1073,7 @@ void LBT::LBT0(int &n, double &ti) {
           probCol = 0.0;
         probTot = probCol + probRad;
 
-        if (ran0(&NUM1) <
+        if (ran0() <
             probTot) { // !Yes, collision! Either elastic or inelastic.
 
           flagScatter = 1;
@@ -1182,7 +1191,7 @@ void LBT::LBT0(int &n, double &ti) {
                 n_sp2 += 1;
               }
 
-              if (ran0(&NUM1) <
+              if (ran0() <
                   probRad /
                       probTot) { // radiation -- either heavy or light parton:
 
@@ -1256,7 +1265,7 @@ void LBT::LBT0(int &n, double &ti) {
                   eGluon = eGluon + pc4[0];
                   nGluon = nGluon + 1.0;
 
-                  V[0][np0] = -log(1.0 - ran0(&NUM1));
+                  V[0][np0] = -log(1.0 - ran0());
 
                   // add multiple radiation for heavy quark
                   while (nrad > 1) {
@@ -1313,7 +1322,7 @@ void LBT::LBT0(int &n, double &ti) {
                       eGluon = eGluon + pc4[0];
                       nGluon = nGluon + 1.0;
 
-                      V[0][np0] = -log(1.0 - ran0(&NUM1));
+                      V[0][np0] = -log(1.0 - ran0());
 
                     } else { //end multiple radiation
                       break;
@@ -1325,7 +1334,7 @@ void LBT::LBT0(int &n, double &ti) {
                   //                          cout<<"radiate! <Ng>: "<<nrad0<<"  real Ng H: "<< ctGluon << endl;
                 } // icl23 == 1, 1st gluon radiation from heavy quark
 
-              } // if(ran0(&NUM1)<probRad/probTot)
+              } // if(ran0()<probRad/probTot)
 
             } //if(Ejp>2*sqrt(qhat0))
 
@@ -1338,12 +1347,12 @@ void LBT::LBT0(int &n, double &ti) {
           if (abs(KATT1[i]) == 4 || abs(KATT1[i]) == 5)
             radng[i] = 0.0; // do it below
           tiscatter[i] = tcar;
-          V[0][i] = -log(1.0 - ran0(&NUM1));
+          V[0][i] = -log(1.0 - ran0());
 
           for (unsigned ip = nnpp + 1; ip <= np0; ++ip) {
             tiscatter[ip] = tcar;
-            V[0][ip] = -log(1.0 - ran0(&NUM1));
-            V0[0][ip] = -log(1.0 - ran0(&NUM1));
+            V[0][ip] = -log(1.0 - ran0());
+            V0[0][ip] = -log(1.0 - ran0());
             tirad[ip] = tcar;
             Tint_lrf[ip] = 0.0;
             radng[ip] = 0.0;
@@ -1461,12 +1470,61 @@ void LBT::read_tables() { // intialize various tables for LBT
   if (fixPosition != 1)
     read_xyMC(numInitXY);
 
+  if (MapBinaryTables(BinaryTablesFile)) {
+    cout << "Initialization completed for LBT (binary tables)." << endl;
+    return;
+  }
+  ReadTextTables(KINT0 != 0);
+
+  cout << "Initialization completed for LBT." << endl;
+}
+
+// Points the large tables into one block of doubles, laid out as in the
+// binary file, and returns its length
+size_t LBT::SetTablePointers(double *block) {
+  const size_t radiation_size =
+      size_t(t_gn + 2) * (temp_gn + 1) * (HQener_gn + 1);
+  const size_t dist_size = size_t(N_T) * N_p1 * N_e2;
+  const size_t dist_max_size = size_t(N_T) * N_p1;
+
+  if (block) {
+    RadiationTable **radiation[] = {&dNg_over_dt_c, &dNg_over_dt_q,
+                                    &dNg_over_dt_g, &max_dNgfnc_c,
+                                    &max_dNgfnc_q,  &max_dNgfnc_g};
+    for (int i = 0; i < 6; i++)
+      *radiation[i] =
+          reinterpret_cast<RadiationTable *>(block + i * radiation_size);
+    block += 6 * radiation_size;
+    DistTable **dist[] = {&distFncB, &distMaxB, &distFncF, &distMaxF};
+    for (int i = 0; i < 4; i++)
+      *dist[i] = reinterpret_cast<DistTable *>(block + i * dist_size);
+    block += 4 * dist_size;
+    distFncBM = reinterpret_cast<double(*)[N_p1]>(block);
+    distFncFM = reinterpret_cast<double(*)[N_p1]>(block + dist_max_size);
+  }
+  return 6 * radiation_size + 4 * dist_size + 2 * dist_max_size;
+}
+
+bool LBT::ReadTextTables(bool radiation) {
+  // zero filled like the static arrays this replaces; calloc leaves the
+  // pages untouched until written, so unread tables cost no memory
+  static double *tables_storage = nullptr;
+  if (!tables_storage) {
+    tables_storage = static_cast<double *>(
+        calloc(SetTablePointers(nullptr), sizeof(double)));
+    if (!tables_storage)
+      throw std::runtime_error("LBT: cannot allocate the tables");
+  }
+  SetTablePointers(tables_storage);
+  bool complete = true;
+
   //...read scattering rate
   int it, ie;
   int n = 450;
   ifstream f1("LBT-tables/ratedata");
   if (!f1.is_open()) {
     cout << "Erro openning date file1!\n";
+    complete = false;
   } else {
     for (int i = 1; i <= n; i++) {
       f1 >> it >> ie;
@@ -1482,6 +1540,7 @@ void LBT::read_tables() { // intialize various tables for LBT
   ifstream f11("LBT-tables/ratedata-HQ");
   if (!f11.is_open()) {
     cout << "Erro openning HQ data file!\n";
+    complete = false;
   } else {
     for (int i = 1; i <= n; i++) {
       f11 >> it >> ie;
@@ -1491,12 +1550,13 @@ void LBT::read_tables() { // intialize various tables for LBT
   f11.close();
 
   // read radiation table for heavy quark
-  if (KINT0 != 0) {
+  if (radiation) {
     ifstream f12("LBT-tables/dNg_over_dt_cD6.dat");
     ifstream f13("LBT-tables/dNg_over_dt_qD6.dat");
     ifstream f14("LBT-tables/dNg_over_dt_gD6.dat");
     if (!f12.is_open() || !f13.is_open() || !f14.is_open()) {
       cout << "Erro openning HQ radiation table file!\n";
+      complete = false;
     } else {
       for (int k = 1; k <= t_gn; k++) {
         char dummyChar[100];
@@ -1542,6 +1602,7 @@ void LBT::read_tables() { // intialize various tables for LBT
   ifstream fileB("LBT-tables/distB.dat");
   if (!fileB.is_open()) {
     cout << "Erro openning data file distB.dat!" << endl;
+    complete = false;
   } else {
     for (int i = 0; i < N_T; i++) {
       for (int j = 0; j < N_p1; j++) {
@@ -1565,6 +1626,7 @@ void LBT::read_tables() { // intialize various tables for LBT
   ifstream fileF("LBT-tables/distF.dat");
   if (!fileF.is_open()) {
     cout << "Erro openning data file distF.dat!" << endl;
+    complete = false;
   } else {
     for (int i = 0; i < N_T; i++) {
       for (int j = 0; j < N_p1; j++) {
@@ -1585,71 +1647,109 @@ void LBT::read_tables() { // intialize various tables for LBT
   }
   fileF.close();
 
-  cout << "Initialization completed for LBT." << endl;
+  return complete;
 }
 
-//..............................................................subroutine
-//..............................................................
+// Binary tables: a header, the 17 rate tables of 60 x 20 doubles and the
+// block of large tables (see SetTablePointers), all in host byte order
+namespace {
+struct LBTTablesHeader {
+  char magic[8];
+  uint32_t endian_marker;
+  uint32_t version;
+  int32_t dims[8];
+};
+const char LBTTablesMagic[8] = {'J', 'S', 'L', 'B', 'T', 'T', 'B', 'L'};
+const uint32_t LBTTablesEndianMarker = 0x01020304;
+const uint32_t LBTTablesVersion = 1;
+} // namespace
+
+#define LBT_RATE_TABLES                                                        \
+  {qhatG, Rg, Rg1, Rg2, Rg3, qhatLQ, Rq, Rq3, Rq4, Rq5, Rq6, Rq7, Rq8, RHQ,    \
+   RHQ11, RHQ12, qhatHQ}
+
+bool LBT::MapBinaryTables(std::string file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  double(*rates[])[20] = LBT_RATE_TABLES;
+  const int n_rates = sizeof(rates) / sizeof(rates[0]);
+  const size_t rates_size = n_rates * sizeof(Rg);
+  const size_t expected_size = sizeof(LBTTablesHeader) + rates_size +
+                               SetTablePointers(nullptr) * sizeof(double);
+  if (size_t(st.st_size) != expected_size) {
+    JSWARN << "LBT: " << file_name << " does not match the table dimensions "
+           << "of this build, reading the text tables";
+    close(fd);
+    return false;
+  }
+  void *map = mmap(nullptr, expected_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  LBTTablesHeader header;
+  std::memcpy(&header, map, sizeof(header));
+  const int32_t dims[8] = {t_gn, temp_gn, HQener_gn, N_T,
+                           N_p1, N_e2,    n_rates,   60 * 20};
+  if (std::memcmp(header.magic, LBTTablesMagic, 8) != 0 ||
+      header.endian_marker != LBTTablesEndianMarker ||
+      header.version != LBTTablesVersion ||
+      std::memcmp(header.dims, dims, sizeof(dims)) != 0) {
+    JSWARN << "LBT: " << file_name << " was written for another version or "
+           << "machine, reading the text tables";
+    munmap(map, expected_size);
+    return false;
+  }
 
-float LBT::ran0(long *idum)
-
-{
-  const int IM1 = 2147483563;
-  const int IM2 = 2147483399;
-  const double AM = (1.0 / IM1);
-  const int IMM1 = (IM1 - 1);
-  const int IA1 = 40014;
-  const int IA2 = 40692;
-  const int IQ1 = 53668;
-  const int IQ2 = 52774;
-  const int IR1 = 12211;
-  const int IR2 = 3791;
-  const int NTAB = 32;
-  const int NDIV = (1 + IMM1 / NTAB);
-  const double EPS = 1.2e-7;
-  const double RNMX = (1.0 - EPS);
-
-  int j;
-  long k;
-  static long idum2 = 123456789;
-  static long iy = 0;
-  static long iv[NTAB];
-  float temp;
-
-  if (*idum <= 0) {
-    if (-(*idum) < 1)
-      *idum = 1;
-    else
-      *idum = -(*idum);
-    for (j = NTAB + 7; j >= 0; j--) {
-      k = (*idum) / IQ1;
-      *idum = IA1 * (*idum - k * IQ1) - k * IR1;
-      if (*idum < 0)
-        *idum += IM1;
-      if (j < NTAB)
-        iv[j] = *idum;
-    }
-    iy = iv[0];
+  // the small rate tables are copied, the large ones used in place
+  const char *data = static_cast<const char *>(map) + sizeof(header);
+  for (int i = 0; i < n_rates; i++)
+    std::memcpy(rates[i], data + i * sizeof(Rg), sizeof(Rg));
+  SetTablePointers(reinterpret_cast<double *>(
+      const_cast<char *>(data + rates_size)));
+  return true;
+}
+
+void LBT::WriteBinaryTables(std::string file_name) {
+  LBTTablesHeader header;
+  double(*rates[])[20] = LBT_RATE_TABLES;
+  const int n_rates = sizeof(rates) / sizeof(rates[0]);
+  std::memcpy(header.magic, LBTTablesMagic, 8);
+  header.endian_marker = LBTTablesEndianMarker;
+  header.version = LBTTablesVersion;
+  const int32_t dims[8] = {t_gn, temp_gn, HQener_gn, N_T,
+                           N_p1, N_e2,    n_rates,   60 * 20};
+  std::memcpy(header.dims, dims, sizeof(dims));
+
+  // written next to the target and renamed, so that a running job never
+  // maps a partial file
+  std::string tmp_name = file_name + ".tmp";
+  std::ofstream out(tmp_name.c_str(), std::ios::binary);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (int i = 0; i < n_rates; i++)
+    out.write(reinterpret_cast<const char *>(rates[i]), sizeof(Rg));
+  out.write(reinterpret_cast<const char *>(dNg_over_dt_c),
+            SetTablePointers(nullptr) * sizeof(double));
+  out.close();
+  if (!out || std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+    std::remove(tmp_name.c_str());
+    throw std::runtime_error("LBT: cannot write " + file_name);
   }
-  k = (*idum) / IQ1;
-  *idum = IA1 * (*idum - k * IQ1) - k * IR1;
-  if (*idum < 0)
-    *idum += IM1;
-  k = idum2 / IQ2;
-  idum2 = IA2 * (idum2 - k * IQ2) - k * IR2;
-  if (idum2 < 0)
-    idum2 += IM2;
-  j = iy / NDIV;
-  iy = iv[j] - idum2;
-  iv[j] = *idum;
-  if (iy < 1)
-    iy += IMM1;
-  if ((temp = AM * iy) > RNMX)
-    return RNMX;
-  else
-    return temp;
 }
 
+//..............................................................subroutine
+//..............................................................
+
+// Draws from the engine of the module, which JetEnergyLossManager seeds for
+// every shower, so that concurrent showers are independent and reproducible
+double LBT::ran0() { return ZeroOneDistribution(*GetMt19937Generator()); }
+
 //.........................................................................
 double LBT::alphas0(int &Kalphas, double temp0) {
 
@@ -1819,7 +1919,7 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
     double R2 = RTEg2;
     double R3 = RTEg3;
 
-    double a = ran0(&NUM1);
+    double a = ran0();
 
     if (a <= R1 / R0) {
       CT = 1;
@@ -1830,7 +1930,7 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
 
     if (a > R1 / R0 && a <= (R1 + R2) / R0) {
       CT = 2;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ran0() * 6 + 1);
       if (b == 7) {
         b = 6;
       }
@@ -1841,7 +1941,7 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
 
     if (a > (R1 + R2) / R0 && a <= 1.0) {
       CT = 3;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ran0() * 6 + 1);
       if (b == 7) {
         b = 6;
       }
@@ -1855,14 +1955,14 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
     double R1 = RTEHQ11;
     double R2 = RTEHQ12;
 
-    double a = ran0(&NUM1);
+    double a = ran0();
 
     //          qhat_over_T3=qhatTP;  // what is read in is qhat/T^3 of quark
     //          D2piT=8.0*pi/qhat_over_T3;
 
     if (a <= R1 / R0) { //Qq->Qq
       CT = 11;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ran0() * 6 + 1);
       if (b == 7) {
         b = 6;
       }
@@ -1883,7 +1983,7 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
     double R7 = RTEq7;
     double R8 = RTEq8;
 
-    double a = ran0(&NUM1);
+    double a = ran0();
     if (a <= R3 / R00) {
       CT = 13;
       KATT3 = 21;
@@ -1894,7 +1994,7 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
     if (a > R3 / R00 && a <= (R3 + R4) / R00) {
       CT = 4;
     f1:
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ran0() * 6 + 1);
       if (b == 7) {
         b = 6;
       }
@@ -1917,7 +2017,7 @@ void LBT::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3, double RTE,
       CT = 6;
       KATT3 = -KATT0;
     f2:
-      b = floor(ran0(&NUM1) * 3 + 1);
+      b = floor(ran0() * 3 + 1);
       if (b == 4) {
         b = 3;
       }
@@ -2075,7 +2175,7 @@ void LBT::twflavor(int &CT, int &KATT0, int &KATT2, double E, double T) {
     //	R3  =RTEg3
 
     if (KATT20 == 21) {
-      double a = ran0(&NUM1);
+      double a = ran0();
       if (a <= R1 / (R1 + R2)) {
         CT = 1;
         //	        KATT3=KATT2
@@ -2086,7 +2186,7 @@ void LBT::twflavor(int &CT, int &KATT0, int &KATT2, double E, double T) {
       if (a > R1 / (R1 + R2)) {
         CT = 2;
         //	        KATT3=KATT2
-        b = floor(ran0(&NUM1) * 6 + 1);
+        b = floor(ran0() * 6 + 1);
         if (b == 7) {
           b = 6;
         }
@@ -2138,12 +2238,12 @@ void LBT::twflavor(int &CT, int &KATT0, int &KATT2, double E, double T) {
       }
 
       if (KATT20 == -KATT00) {
-        double a = ran0(&NUM1);
+        double a = ran0();
         if (a <= (R6) / R00) {
           CT = 6;
           //	         KATT3=KATT2
         tf2:
-          b = floor(ran0(&NUM1) * 3 + 1);
+          b = floor(ran0() * 3 + 1);
           if (b == 4) {
             b = 3;
           }
@@ -2353,9 +2453,9 @@ void LBT::colljet22(int CT, double temp, double qhat0ud, double v0[4],
          flag2 = 1;
          break;
       }
-      xw = 15.0 * ran0(&NUM1);
-      razim = 2.0 * pi * ran0(&NUM1);
-      rcos = 1.0 - 2.0 * ran0(&NUM1);
+      xw = 15.0 * ran0();
+      razim = 2.0 * pi * ran0();
+      rcos = 1.0 - 2.0 * ran0();
       rsin = sqrt(1.0 - rcos * rcos);
       //
       p2[0] = xw * temp;
@@ -2377,7 +2477,7 @@ void LBT::colljet22(int CT, double temp, double qhat0ud, double v0[4],
 
       //    use (s^2+u^2)/(t+qhat0ud)^2 as scattering cross section in the
       //
-      rant = ran0(&NUM1);
+      rant = ran0();
       tt = rant * ss;
 
       //		ic+=1;
@@ -2521,7 +2621,7 @@ void LBT::colljet22(int CT, double temp, double qhat0ud, double v0[4],
             (mmax + 4.0);
     }
 
-    rank = ran0(&NUM1);
+    rank = ran0();
   } while (rank > (msq * ff));
 
   if(flag1 == 1 || flag2 == 1){ // scatterings cannot be properly sampled
@@ -2563,7 +2663,7 @@ void LBT::colljet22(int CT, double temp, double qhat0ud, double v0[4],
   //    sample transverse momentum transfer with respect to jet momentum
   //    in cm frame
   //
-  double ranp = 2.0 * pi * ran0(&NUM1);
+  double ranp = 2.0 * pi * ran0();
   //
   //    transverse momentum transfer
   //
@@ -2725,7 +2825,7 @@ void LBT::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       flag1 = 1;
       break;
     }
-    xw = max_e2 * ran0(&NUM1);
+    xw = max_e2 * ran0();
     index_e2 = (int)((xw - min_e2) / bin_e2);
     if (index_e2 >= N_e2)
       index_e2 = N_e2 - 1;
@@ -2739,7 +2839,7 @@ void LBT::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       cout << "Wrong HQ channel ID" << endl;
       exit(EXIT_FAILURE);
     }
-  } while (ran0(&NUM1) > ff);
+  } while (ran0() > ff);
 
   e2 = xw * temp;
   e1 = p0[0];
@@ -2754,9 +2854,9 @@ void LBT::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       break;
     }
 
-    theta2 = pi * ran0(&NUM1);
-    theta4 = pi * ran0(&NUM1);
-    phi24 = 2.0 * pi * ran0(&NUM1);
+    theta2 = pi * ran0();
+    theta4 = pi * ran0();
+    phi24 = 2.0 * pi * ran0();
 
     cosTheta24 =
         sin(theta2) * sin(theta4) * cos(phi24) + cos(theta2) * cos(theta4);
@@ -2771,7 +2871,7 @@ void LBT::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
 
     // re-sample if the kinematic cuts are not satisfied
     if (ss <= 2.0 * qhat0ud || tt >= -qhat0ud || uu >= -qhat0ud) {
-      rank = ran0(&NUM1);
+      rank = ran0();
       sigFactor = 0.0;
       msq = 0.0;
       continue;
@@ -2791,7 +2891,7 @@ void LBT::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       msq = Mgc2gc(ss, tt, HQmass) / maxValue;
     }
 
-    rank = ran0(&NUM1);
+    rank = ran0();
 
   } while (rank > (msq * sigFactor));
 
@@ -2812,7 +2912,7 @@ void LBT::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
     p2[0] = e4;
 
     // rotate randomly in xy plane (jet is in z), because p3 is assigned in xz plane with bias
-    double th_rotate = 2.0 * pi * ran0(&NUM1);
+    double th_rotate = 2.0 * pi * ran0();
     double p3x_rotate = p3[1] * cos(th_rotate) - p3[2] * sin(th_rotate);
     double p3y_rotate = p3[1] * sin(th_rotate) + p3[2] * cos(th_rotate);
     double p2x_rotate = p2[1] * cos(th_rotate) - p2[2] * sin(th_rotate);
@@ -2934,7 +3034,7 @@ void LBT::twcoll(int CT, double qhat0ud, double v0[4], double p0[4],
   //
 
   do {
-    rant = ran0(&NUM1);
+    rant = ran0();
     tt = rant * ss;
 
     if ((tt < qhat0ud) || (tt > (ss - qhat0ud)))
@@ -3073,7 +3173,7 @@ void LBT::twcoll(int CT, double qhat0ud, double v0[4], double p0[4],
       //
     }
 
-    rank = ran0(&NUM1);
+    rank = ran0();
 
   } while (rank > msq);
 
@@ -3082,7 +3182,7 @@ void LBT::twcoll(int CT, double qhat0ud, double v0[4], double p0[4],
 
   if ((tt > qhat0ud) && (tt < (ss - qhat0ud))) {
 
-    ranp = 2.0 * pi * ran0(&NUM1);
+    ranp = 2.0 * pi * ran0();
     //
     //
     //
@@ -3198,12 +3298,12 @@ void LBT::collHQ23(int parID, double temp_med, double qhat0ud, double v0[4],
   do {
 
     do {
-      randomX = xLow + xInt * ran0(&NUM1);
-      randomY = ran0(&NUM1);
+      randomX = xLow + xInt * ran0();
+      randomY = ran0();
     } while (tau_f(randomX, randomY, HQenergy, HQmass) < 1.0 / pi / temp_med);
 
     count_sample = 0;
-    while (max_Ng * ran0(&NUM1) > dNg_over_dxdydt(parID, randomX, randomY,
+    while (max_Ng * ran0() > dNg_over_dxdydt(parID, randomX, randomY,
                                                   HQenergy, HQmass, temp_med,
                                                   Tdiff)) {
       count_sample = count_sample + 1;
@@ -3219,14 +3319,14 @@ void LBT::collHQ23(int parID, double temp_med, double qhat0ud, double v0[4],
       }
 
       do {
-        randomX = xLow + xInt * ran0(&NUM1);
-        randomY = ran0(&NUM1);
+        randomX = xLow + xInt * ran0();
+        randomY = ran0();
       } while (tau_f(randomX, randomY, HQenergy, HQmass) < 1.0 / pi / temp_med);
     }
 
     if (parID == 21 && randomX > 0.5)
       randomX = 1.0 - randomX;
-    theta_gluon = 2.0 * pi * ran0(&NUM1);
+    theta_gluon = 2.0 * pi * ran0();
     kperp_gluon = randomX * randomY * HQenergy;
     kpGluon[1] = kperp_gluon * cos(theta_gluon);
     kpGluon[2] = kperp_gluon * sin(theta_gluon);
@@ -3273,7 +3373,7 @@ void LBT::collHQ23(int parID, double temp_med, double qhat0ud, double v0[4],
     int yesA, yesB;
 
     do {
-      sqtheta = 2.0 * pi * ran0(&NUM1);
+      sqtheta = 2.0 * pi * ran0();
       sqx = qt * cos(sqtheta);
       sqy = qt * sin(sqtheta);
       sAA = (sE1 + sE2 - sk0) / (sp1z + sp2z - skz);
@@ -3480,12 +3580,12 @@ void LBT::radiationHQ(int parID, double qhat0ud, double v0[4], double P2[4],
   // comment do { for unit test
   do {
     do {
-      randomX = xLow + xInt * ran0(&NUM1);
-      randomY = ran0(&NUM1);
+      randomX = xLow + xInt * ran0();
+      randomY = ran0();
     } while (tau_f(randomX, randomY, HQenergy, HQmass) < 1.0 / pi / temp_med);
 
     count_sample = 0;
-    while (max_Ng * ran0(&NUM1) > dNg_over_dxdydt(parID, randomX, randomY,
+    while (max_Ng * ran0() > dNg_over_dxdydt(parID, randomX, randomY,
                                                   HQenergy, HQmass, temp_med,
                                                   Tdiff)) {
       count_sample = count_sample + 1;
@@ -3501,14 +3601,14 @@ void LBT::radiationHQ(int parID, double qhat0ud, double v0[4], double P2[4],
       }
 
       do {
-        randomX = xLow + xInt * ran0(&NUM1);
-        randomY = ran0(&NUM1);
+        randomX = xLow + xInt * ran0();
+        randomY = ran0();
       } while (tau_f(randomX, randomY, HQenergy, HQmass) < 1.0 / pi / temp_med);
     }
 
     if (parID == 21 && randomX > 0.5)
       randomX = 1.0 - randomX;
-    theta_gluon = 2.0 * pi * ran0(&NUM1);
+    theta_gluon = 2.0 * pi * ran0();
     kperp_gluon = randomX * randomY * HQenergy;
     kpGluon[1] = kperp_gluon * cos(theta_gluon);
     kpGluon[2] = kperp_gluon * sin(theta_gluon);
@@ -3580,7 +3680,7 @@ void LBT::radiationHQ(int parID, double qhat0ud, double v0[4], double P2[4],
     }
 
     do {
-      stheta12 = 2.0 * pi * ran0(&NUM1); // theta between k1 and k2
+      stheta12 = 2.0 * pi * ran0(); // theta between k1 and k2
       aaa = 4.0 * ((sp0z - sk2z) * (sp0z - sk2z) +
                    sk2p * sk2p * cos(stheta12) * cos(stheta12));
       bbb = -4.0 * sAA * (sp0z - sk2z);
@@ -3813,10 +3913,10 @@ int LBT::KPoisson(double alambda) {
 
   double KKPoisson = 0;
   target = exp(-alambda);
-  p = ran0(&NUM1);
+  p = ran0();
 
   while (p > target) {
-    p = p * ran0(&NUM1);
+    p = p * ran0();
     KKPoisson = KKPoisson + 1;
   }
   return KKPoisson;
@@ -4189,14 +4289,14 @@ void LBT::jetInitialize(int numXY) {
       V[2][i] = 0.0;
       V[3][i] = 0.0;
     } else {
-      int index_xy = (int)(ran0(&NUM1) * numXY);
+      int index_xy = (int)(ran0() * numXY);
       if (index_xy >= numXY)
         index_xy = numXY - 1;
       V[1][i] = initMCX[index_xy];
       V[2][i] = initMCY[index_xy];
       V[3][i] = 0.0;
     }
-    V[0][i] = -log(1.0 - ran0(&NUM1));
+    V[0][i] = -log(1.0 - ran0());
 
     if (fixMomentum == 1) { // initialize momentum
       P[1][i] = px0;
@@ -4208,11 +4308,11 @@ void LBT::jetInitialize(int numXY) {
       WT[i] = 1.0;
     } else {
       pT_len = ipTmax - ipTmin;
-      ipT = ipTmin + ran0(&NUM1) * pT_len;
-      phi = ran0(&NUM1) * 2.0 * pi;
+      ipT = ipTmin + ran0() * pT_len;
+      phi = ran0() * 2.0 * pi;
       ipx = ipT * cos(phi);
       ipy = ipT * sin(phi);
-      rapidity = 2.0 * eta_cut * ran0(&NUM1) - eta_cut;
+      rapidity = 2.0 * eta_cut * ran0() - eta_cut;
       ipz = sqrt(ipT * ipT + amss * amss) * sinh(rapidity);
       ip0 = sqrt(ipT * ipT + ipz * ipz + amss * amss);
       P[1][i] = ipx;
@@ -4280,7 +4380,7 @@ void LBT::setJetX(int numXY) {
     setY = 0.0;
     setZ = 0.0;
   } else {
-    int index_xy = (int)(ran0(&NUM1) * numXY);
+    int index_xy = (int)(ran0() * numXY);
     if (index_xy >= numXY)
       index_xy = numXY - 1;
     setX = initMCX[index_xy];
@@ -4293,7 +4393,7 @@ void LBT::setJetX(int numXY) {
     V[1][i] = setX;
     V[2][i] = setY;
     V[3][i] = setZ;
-    V[0][i] = -log(1.0 - ran0(&NUM1));
+    V[0][i] = -log(1.0 - ran0());
 
     V[1][i] = V[1][i] + P[1][i] / P[0][i] * tau0;
     V[2][i] = V[2][i] + P[2][i] / P[0][i] * tau0;
@@ -21,6 +21,8 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <mutex>
+#include <random>
 
 using namespace Jetscape;
 
@@ -45,12 +47,29 @@ public:
   virtual ~LBT();
 
   void Init();
+  // the tables are static but read-only after Init, random numbers come
+  // from the module's engine and the working arrays belong to the copy
+  bool SupportsParallelShowers() const { return true; }
   //void Exec();
   //void DoEnergyLoss(double deltaT, double Q2, const vector<Parton>& pIn, vector<Parton>& pOut);
   void DoEnergyLoss(double deltaT, double time, double Q2, vector<Parton> &pIn,
                     vector<Parton> &pOut);
   void WriteTask(weak_ptr<JetScapeWriter> w);
 
+  /** Reads the text tables from LBT-tables/, the radiation tables only if
+      requested. Used by read_tables() when there is no binary file.
+      Returns false if a file could not be opened. */
+  bool ReadTextTables(bool radiation);
+  /** Maps a file written by WriteBinaryTables() read-only, so that all
+      processes on a node share one copy in the page cache. Returns false,
+      leaving the tables untouched, if the file is missing or was written
+      for other table dimensions. */
+  static bool MapBinaryTables(std::string file_name);
+  /** Writes all tables in the layout expected by MapBinaryTables(). */
+  void WriteBinaryTables(std::string file_name);
+  //! Binary tables looked for by read_tables()
+  static const char *BinaryTablesFile;
+
 private:
   ///////////////////////////////////////////////////////////////////////////////////////////////////
   //
@@ -138,13 +157,11 @@ private:
   double qhat0; //Debye mass RENAME
   double qhat00;
 
-  //...input with current machine time
-  //...random number seed (any negative integer)
-  //  long  NUM1=-33;
-  long NUM1;
+  //...uniform random numbers from the framework engine, see ran0()
+  uniform_real_distribution<double> ZeroOneDistribution;
 
-  // flag to make sure initialize only once
-  static bool flag_init;
+  // makes sure the tables are initialized only once
+  static std::once_flag tables_loaded;
 
   //    scattering rate
   static double Rg
@@ -179,12 +196,16 @@ private:
   static const int t_gn = t_gn_1 + t_gn_2;
   static const int temp_gn = 100;
 
-  static double dNg_over_dt_c[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double dNg_over_dt_q[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double dNg_over_dt_g[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double max_dNgfnc_c[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double max_dNgfnc_q[t_gn + 2][temp_gn + 1][HQener_gn + 1];
-  static double max_dNgfnc_g[t_gn + 2][temp_gn + 1][HQener_gn + 1];
+  // The large tables below point either into the memory mapped binary
+  // tables or into tables_storage, see read_tables(); their first index
+  // runs over t_gn + 2 and N_T respectively
+  typedef double RadiationTable[temp_gn + 1][HQener_gn + 1];
+  static RadiationTable *dNg_over_dt_c;
+  static RadiationTable *dNg_over_dt_q;
+  static RadiationTable *dNg_over_dt_g;
+  static RadiationTable *max_dNgfnc_c;
+  static RadiationTable *max_dNgfnc_q;
+  static RadiationTable *max_dNgfnc_g;
 
   const double HQener_max = 1000.0;
   const double t_max_1 = 20.0;
@@ -306,9 +327,9 @@ private:
   static const int N_p1 = 500;
   static const int N_T = 60;
   static const int N_e2 = 75;
-  static double distFncB[N_T][N_p1][N_e2], distFncF[N_T][N_p1][N_e2],
-      distMaxB[N_T][N_p1][N_e2], distMaxF[N_T][N_p1][N_e2];
-  static double distFncBM[N_T][N_p1], distFncFM[N_T][N_p1];
+  typedef double DistTable[N_p1][N_e2];
+  static DistTable *distFncB, *distFncF, *distMaxB, *distMaxF;
+  static double (*distFncBM)[N_p1], (*distFncFM)[N_p1];
   double min_p1 = 0.0;
   double max_p1 = 1000.0;
   double bin_p1 = (max_p1 - min_p1) / N_p1;
@@ -335,7 +356,7 @@ private:
   void trans(double v[4], double p[4]);
   void transback(double v[4], double p[4]);
 
-  float ran0(long *idum);
+  double ran0();
 
   double alphas0(int &Kalphas, double temp0);
   double DebyeMass2(int &Kqhat0, double alphas, double temp0);
@@ -394,6 +415,7 @@ private:
   void jetInitialize(int numXY);
   void setJetX(int numXY);
   void read_tables();
+  static size_t SetTablePointers(double *block);
   void jetClean();
   void setParameter(string fileName);
   int checkParameter(int nArg);
@@ -17,6 +17,7 @@
 #include "JetScapeLogger.h"
 #include "JetScapeXML.h"
 #include <string>
+#include <algorithm>
 
 #include "tinyxml2.h"
 #include <iostream>
@@ -37,18 +38,21 @@ using std::ifstream;
 using std::ostream;
 using std::ios;
 
-int Martini::pLabelNew = 0;
-
 Martini::Martini() {
   SetId("Martini");
   VERBOSE(8);
 
+  pLabelNew = 0;
+
   //vectors for elastic rates:
   dGamma_qq = new vector<double>;
   dGamma_qg = new vector<double>;
   dGamma_qq_q = new vector<double>;
   dGamma_qg_q = new vector<double>;
 
+  tabulate_radiation = 0;
+  elasticFitAlpha = -1.;
+
   // create and set Martini Mutex
   auto martini_mutex = make_shared<MartiniMutex>();
   SetMutex(martini_mutex);
@@ -83,6 +87,8 @@ void Martini::Init() {
   hydro_Tc = GetXMLElementDouble({"Eloss", "Martini", "hydro_Tc"});
   recoil_on = GetXMLElementInt({"Eloss", "Martini", "recoil_on"});
   run_alphas = GetXMLElementInt({"Eloss", "Martini", "run_alphas"});
+  tabulate_radiation =
+      GetXMLElementInt({"Eloss", "Martini", "tabulate_radiation"}, false);
 
   alpha_em = 1. / 137.;
 
@@ -92,11 +98,24 @@ void Martini::Init() {
   // Initialize random number distribution
   ZeroOneDistribution = uniform_real_distribution<double>{0.0, 1.0};
 
-  readRadiativeRate(&dat, &Gam);
+  // elastic rate coefficients for fixed alpha_s; with run_alphas they are
+  // interpolated again whenever alpha_s changes
+  alpha_s = alpha_s0;
+  g = sqrt(4. * M_PI * alpha_s);
+  setElasticFits();
+
+  loadRadiativeRate();
   readElasticRateOmega();
   readElasticRateQ();
 }
 
+// Every copy numbers the partons of its own shower, so labels are the same
+// whichever order or thread the showers of an event run in.
+void Martini::SetShowerIndex(int index) {
+  JetEnergyLoss::SetShowerIndex(index);
+  pLabelNew = index * LabelsPerShower;
+}
+
 void Martini::DoEnergyLoss(double deltaT, double Time, double Q2,
                            vector<Parton> &pIn, vector<Parton> &pOut) {
   VERBOSESHOWER(5) << MAGENTA << "SentInPartons Signal received : " << deltaT
@@ -189,15 +208,15 @@ void Martini::DoEnergyLoss(double deltaT, double Time, double Q2,
     double boostedTStart = tStart * cosh(SpatialRapidity);
 
     // Extract fluid properties
-    std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
-    GetHydroCellSignal(Time, xx, yy, zz, check_fluid_info_ptr);
+    FluidCellInfo check_fluid_info;
+    GetMediumCell(Time, xx, yy, zz, check_fluid_info);
     VERBOSE(8) << MAGENTA << "Temperature from Brick (Signal) = "
-               << check_fluid_info_ptr->temperature;
+               << check_fluid_info.temperature;
 
-    vx = check_fluid_info_ptr->vx;
-    vy = check_fluid_info_ptr->vy;
-    vz = check_fluid_info_ptr->vz;
-    T = check_fluid_info_ptr->temperature;
+    vx = check_fluid_info.vx;
+    vy = check_fluid_info.vy;
+    vz = check_fluid_info.vz;
+    T = check_fluid_info.temperature;
 
     beta = sqrt(vx * vx + vy * vy + vz * vz);
 
@@ -1023,20 +1042,26 @@ RateRadiative Martini::getRateRadTotal(double pRest, double T) {
   double u = pRest / T; // making arguments in log to be dimensionless
 
   if (u > AMYpCut) {
-    rate.qqg = (0.8616 - 3.2913 / (u * u) + 2.1102 / u - 0.9485 / sqrt(u)) *
-               pow(g, 4.) * T;
-    rate.ggg = (1.9463 + 61.7856 / (u * u * u) - 30.7877 / (u * u) +
-                8.0409 / u - 2.6249 / sqrt(u)) *
-               pow(g, 4.) * T;
-    rate.gqq = (2.5830 / (u * u * u) - 1.7010 / (u * u) + 1.4977 / u -
-                1.1961 / pow(u, 0.8) + 0.1807 / sqrt(u)) *
-               pow(g, 4.) * T * nf;
-    rate.qqgamma =
-        (0.0053056 + 2.3279 / pow(u, 3.) - 0.6676 / u + 0.3223 / sqrt(u)) *
-        pow(g, 4.) * alpha_em / alpha_s * T;
-
+    double x = 1. / u;
+    double x2 = x * x;
+    double xSqrt = sqrt(x);
+    double logU = log(u);
+    double g4T = g * g * g * g * T;
+
+    rate.qqg = (0.8616 - 3.2913 * x2 + 2.1102 * x - 0.9485 * xSqrt) * g4T;
+    rate.ggg = (1.9463 + 61.7856 * x2 * x - 30.7877 * x2 + 8.0409 * x -
+                2.6249 * xSqrt) *
+               g4T;
+    rate.gqq = (2.5830 * x2 * x - 1.7010 * x2 + 1.4977 * x -
+                1.1961 * exp(-0.8 * logU) + 0.1807 * xSqrt) *
+               g4T * nf;
+    rate.qqgamma = (0.0053056 + 2.3279 * x2 * x - 0.6676 * x + 0.3223 * xSqrt) *
+                   g4T * alpha_em / alpha_s;
+
+    // log(g T u^(1/4) / 0.175) at u = 10 over the one at u
+    double logScale = log(g * T / .175);
     double runningFactor =
-        log(g * T * pow(10., 0.25) / .175) / log(g * T * pow(u, 0.25) / .175);
+        (logScale + 0.25 * log(10.)) / (logScale + 0.25 * logU);
     if (runningFactor < 1.) {
       rate.qqg *= runningFactor;
       rate.gqq *= runningFactor;
@@ -1089,11 +1114,6 @@ double Martini::getNewMomentumRad(double pRest, double T, int process) {
   double u = pRest / T; // making arguments in log to be dimensionless
 
   double kNew = 0.; // momentum of radiated gluon (dimentionless)
-  double y;         // kNew candidate
-  double x;         // random number, uniform on [0,1]
-  double randA; // uniform random number on [0, Area under the envelop function]
-  double fy;    // total area under the envelop function
-  double fyAct; // actual rate
 
   RateRadiative Pos, Neg;
   Pos = getRateRadPos(u, T);
@@ -1108,13 +1128,44 @@ double Martini::getNewMomentumRad(double pRest, double T, int process) {
      process == 3 : gluon radiating gluon
      process == 4 : gluon split into quark-antiquark pair */
 
+  // decide whether k shall be positive or negative
+  // if x (uniform on [0,1]) < area(k<0)/area(all k) then k < 0
   if (process == 1) {
-    // decide whether k shall be positive or negative
-    // if x (uniform on [0,1]) < area(k<0)/area(all k) then k < 0
     if (ZeroOneDistribution(*GetMt19937Generator()) <
         Neg.qqg / (Neg.qqg + Pos.qqg))
       posNegSwitch = 0;
+  } else if (process == 3) {
+    if (ZeroOneDistribution(*GetMt19937Generator()) <
+        Neg.ggg / (Neg.ggg + Pos.ggg))
+      posNegSwitch = 0;
+  } else if (process == 4) {
+    if (ZeroOneDistribution(*GetMt19937Generator()) <
+        Neg.gqq / (Neg.gqq + Pos.gqq))
+      posNegSwitch = 0;
+  } else if (process != 2) {
+    JSWARN << "Invalid process number (" << process << ")";
+    return kNew;
+  }
 
+  if (tabulate_radiation)
+    kNew = sampleRadiativeTable(u, process, posNegSwitch);
+  else
+    kNew = sampleRadiativeRejection(u, process, posNegSwitch);
+
+  return kNew * T; // kNew*T is in [GeV]
+}
+
+// samples k/T for a given sign of k with the rejection method
+double Martini::sampleRadiativeRejection(double u, int process,
+                                         int posNegSwitch) {
+  double kNew = 0.; // momentum of radiated gluon (dimentionless)
+  double y;         // kNew candidate
+  double x;         // random number, uniform on [0,1]
+  double randA; // uniform random number on [0, Area under the envelop function]
+  double fy;    // total area under the envelop function
+  double fyAct; // actual rate
+
+  if (process == 1) {
     if (posNegSwitch == 1) // if k > 0
     {
       do {
@@ -1161,12 +1212,6 @@ double Martini::getNewMomentumRad(double pRest, double T, int process) {
     // reject if x is larger than the ratio fyAct/fy
     kNew = y;
   } else if (process == 3) {
-    // decide whether k shall be positive or negative
-    // if x (uniform on [0,1]) < area(k<0)/area(all k) then k < 0
-    if (ZeroOneDistribution(*GetMt19937Generator()) <
-        Neg.ggg / (Neg.ggg + Pos.ggg))
-      posNegSwitch = 0;
-
     if (posNegSwitch == 1) // if k > 0
     {
       do {
@@ -1199,12 +1244,6 @@ double Martini::getNewMomentumRad(double pRest, double T, int process) {
       kNew = y;
     }
   } else if (process == 4) {
-    // decide whether k shall be positive or negative
-    // if x (uniform on [0,1]) < area(k<0)/area(all k) then k < 0
-    if (ZeroOneDistribution(*GetMt19937Generator()) <
-        Neg.gqq / (Neg.gqq + Pos.gqq))
-      posNegSwitch = 0;
-
     if (posNegSwitch == 1) // if k > 0
     {
       do {
@@ -1239,11 +1278,9 @@ double Martini::getNewMomentumRad(double pRest, double T, int process) {
       // reject if x is larger than the ratio fyAct/fy
       kNew = y;
     }
-  } else {
-    JSWARN << "Invalid process number (" << process << ")";
   }
 
-  return kNew * T; // kNew*T is in [GeV]
+  return kNew;
 }
 
 // calculates the area under the envelope function when using the rejection method
@@ -1286,6 +1323,79 @@ double Martini::function(double u, double y, int process) {
   return 0.;
 }
 
+// samples k/T for a given sign of k from the inverse-CDF tables
+double Martini::sampleRadiativeTable(double u, int process, int posNegSwitch) {
+  int branch = radiativeBranch(process, posNegSwitch);
+  if (!radiativeCDF)
+    return sampleRadiativeRejection(u, process, posNegSwitch);
+
+  // pick one of the neighbouring p nodes with the weights of the linear
+  // interpolation in log(p) done by use_table
+  int n_p = 0;
+  double a = 24.7743737154026 * log(u * 0.2493765586034912718l);
+  if (a >= NP - 2) {
+    n_p = NP - 2;
+  } else if (a > 0.) {
+    n_p = (int)a;
+    if (ZeroOneDistribution(*GetMt19937Generator()) < a - n_p)
+      n_p++;
+  }
+
+  const RadiativeCDF &table = (*radiativeCDF)[branch * (NP - 1) + n_p];
+  if (!(table.cdf.back() > 0.))
+    return sampleRadiativeRejection(u, process, posNegSwitch);
+
+  double r = ZeroOneDistribution(*GetMt19937Generator()) * table.cdf.back();
+  int i = std::upper_bound(table.cdf.begin(), table.cdf.end(), r) -
+          table.cdf.begin() - 1;
+  i = std::max(0, std::min(i, (int)table.cdf.size() - 2));
+
+  // inside the cell the density is taken linear in b
+  double w0 = table.pdf[i];
+  double w1 = table.pdf[i + 1];
+  double cell = table.cdf[i + 1] - table.cdf[i];
+  double area = cell > 0. ? (r - table.cdf[i]) / cell * 0.5 * (w0 + w1) : 0.;
+  double denom = w0 + sqrt(std::max(0., w0 * w0 + 2. * (w1 - w0) * area));
+  double t = denom > 0. ? 2. * area / denom : 0.5;
+  t = std::max(0., std::min(t, 1.));
+
+  // the support of the node differs slightly from the one at u
+  double yMin, yMax, dkdb;
+  radiativeSupport(branch, u, yMin, yMax);
+  double k = kFromIndex(u, table.b_min + (i + t) / NRadSubSteps, dkdb);
+  return std::max(yMin, std::min(k, yMax));
+}
+
+// sampling branch of process 1-4 and the sign of k
+int Martini::radiativeBranch(int process, int posNegSwitch) {
+  if (process == 1)
+    return posNegSwitch == 1 ? 0 : 1;
+  else if (process == 2)
+    return 2;
+  else if (process == 3)
+    return posNegSwitch == 1 ? 3 : 4;
+  else
+    return posNegSwitch == 1 ? 5 : 6;
+}
+
+// range of k/T covered by the envelope functions of the rejection method
+void Martini::radiativeSupport(int branch, double u, double &yMin,
+                               double &yMax) {
+  if (branch == 1 || branch == 4 || branch == 6) {
+    yMin = -12.;
+    yMax = -0.05;
+  } else if (branch == 0) {
+    yMin = 0.05;
+    yMax = u + 12.;
+  } else if (branch == 2) {
+    yMin = 0.;
+    yMax = 1.15 * u;
+  } else {
+    yMin = 0.05;
+    yMax = u / 2.;
+  }
+}
+
 bool Martini::isCoherent(Parton &pIn, int sibling, double T) {
   bool coherentNow = false;
   const weak_ptr<PartonShower> pShower = pIn.shower();
@@ -1366,563 +1476,200 @@ bool Martini::isCoherent(Parton &pIn, int sibling, double T) {
 
   return coherentNow;
 }
+// Fits of the elastic rates at the alpha_s nodes 0.15, 0.18, ..., 0.42,
+// rate / T = a0 + a1 / u^4 - a2 / u^3 - a3 / u^2 + a4 / u^1.5 - a5 / u,
+// for the total rate and for omega > 0 and omega < 0, each for qq and qg
+const double Martini::elasticFitCoefficients[3][2][NalphasFit][6] = {
+    {
+        // total, qq
+        {
+            {0.18172488396136807, 0.6004740049060965, 0.36559627257898347,
+             0.10607576568373664, 0.004322466954618182, 0.04731599462749122},
+            {0.224596478395945, 1.0874259848101948, 0.6436398538984057,
+             0.11585154613692052, -0.001719701730785056, 0.06734745496415469},
+            {0.2686436092048326, 1.7286136256785387, 0.9826325498183079,
+             0.13136670133029682, -0.004876376882437649, 0.09140316977554151},
+            {0.3137234778163784, 2.445764079999846, 1.3083241146035964,
+             0.18341717903923757, 0.006098371807040589, 0.12054238276023879},
+            {0.3597255453974444, 3.140669321831845, 1.535549334026633,
+             0.30505450230754705, 0.04285103618362223, 0.1558288379712527},
+            {0.40656130602563223, 3.713430971987352, 1.5818298058630476,
+             0.5269042544852683, 0.11594975218839362, 0.1982063104156748},
+            {0.45415805200862863, 4.0758813206143785, 1.3775134184861555,
+             0.873527536823307, 0.23371456949506658, 0.24840524848507203},
+            {0.5024541413891354, 4.159425815179756, 0.8719749565879445,
+             1.3606690530660879, 0.4010658149846402, 0.3067901992139913},
+            {0.5513999693402064, 3.893153859527746, 0.009578762778659829,
+             2.0095157488463244, 0.6260756501912864, 0.37424991045026396},
+            {0.600941593540798, 3.293344337592684, -1.1764805445298645,
+             2.792180001243466, 0.8949534049225013, 0.44878529934031575}
+        },
+        // total, qg
+        {
+            {0.9364689080337059, 2.626076478553979, 2.1171556605834274,
+             0.13123339226210134, 0.02875811664147147, 0.27736469898722244},
+            {1.1485486950080581, 4.993647646894147, 3.7295251994302876,
+             -0.0017620287506503757, 0.010598257485913224, 0.3949856219367327},
+            {1.3645568637616001, 8.174225869366722, 5.732101892684938,
+             -0.1416811579957863, 0.011703596451947428, 0.5354757997870718},
+            {1.5839378568555678, 11.785897000063443, 7.758388282689373,
+             -0.13163385415183002, 0.09016386041913003, 0.7042577279136836},
+            {1.8062676019060235, 15.344112642069764, 9.384190917330093,
+             0.19709400976261568, 0.30577623140224813, 0.9066501895009754},
+            {2.0312125903238236, 18.36844006721506, 10.209988454804193,
+             0.9957025988944573, 0.7109302867706849, 1.1472148515742653},
+            {2.258502734110078, 20.43444928479894, 9.896928897847518,
+             2.3867073785159003, 1.3473328178504662, 1.429497460496924},
+            {2.4879110920956653, 21.220550462966102, 8.20639681844989,
+             4.445222616370339, 2.2381176005506016, 1.7550164762706189},
+            {2.7192501243929903, 20.470583876561985, 4.954737209403953,
+             7.227667929705693, 3.401378906197122, 2.1251383942923474},
+            {2.9523522354248817, 18.027772799078463, 0.050298242947981846,
+             10.747352232336384, 4.8378133911595285, 2.5391647730624003}
+        }
+    },
+    {
+        // omega > 0, qq
+        {
+            {0.12199410313320332, 0.23732051765097376, -0.03285419708803458,
+             0.2255419254079952, 0.03991522899907729, 0.05022641428394594},
+            {0.15243607717720586, 0.5403120875137825, 0.06440920730334501,
+             0.2881594349535524, 0.04948438583750772, 0.07152523367501308},
+            {0.15243607717720586, 0.5403120875137825, 0.06440920730334501,
+             0.2881594349535524, 0.04948438583750772, 0.07152523367501308},
+            {0.21661000995329158, 1.4087570376612657, 0.2713885880193171,
+             0.48681971936565244, 0.09567346780679847, 0.12780677622585393},
+            {0.2501007467879627, 1.8034683081244214, 0.228092470920281,
+             0.6841577896561725, 0.15430793601338547, 0.1648297331159989},
+            {0.28440720063047276, 2.0448244620634055, -0.018574547528236382,
+             0.9863974758613413, 0.2503738253300167, 0.2090067594645225},
+            {0.31945943548344036, 2.0482495934952256, -0.5350999123662686,
+             1.4169725257394696, 0.3918202096574105, 0.26103455441873036},
+            {0.35519799231686516, 1.7485135425544152, -1.3692232011881413,
+             1.9906086576701993, 0.5832315715098879, 0.32124694953933486},
+            {0.39157507493019383, 1.0778995684787331, -2.5738838613236457,
+             2.727543221296746, 0.8323699786704292, 0.3905055907877247},
+            {0.4285382777192131, 0.05505396151716547, -4.113979132685303,
+             3.5992808060371506, 1.1252568207814462, 0.4667953957378259}
+        },
+        // omega > 0, qg
+        {
+            {0.6197775378922895, 1.5268694134079064, 0.6939337312845367,
+             0.5967602676773388, 0.17320784052297564, 0.28964614117694565},
+            {0.7680959463632293, 3.282164035377037, 1.6359849897319092,
+             0.6770046238563808, 0.22074166337990309, 0.4128184793199476},
+            {0.9206225398305536, 5.690562370150853, 2.8341906487774318,
+             0.7900156706763937, 0.2995126102416747, 0.5598645426609049},
+            {1.0767954081327265, 8.378841394880034, 3.9338968631891396,
+             1.0874771229885156, 0.46570985770548107, 0.7360069767362173},
+            {1.2361819653856791, 10.877148035367144, 4.526191560392149,
+             1.731930015138816, 0.7769917594310469, 0.9463662091275489},
+            {1.3984393292278847, 12.72181515837248, 4.227297031355039,
+             2.868526983329731, 1.2836917844304823, 1.1953148369630755},
+            {1.5632880021613935, 13.502896915302873, 2.7113406243010467,
+             4.615035662049938, 2.0259357821768784, 1.486253368704046},
+            {1.730492163581557, 12.913294655478987, -0.2477159937428581,
+             7.042004003229154, 3.0253452576771465, 1.8205651561017433},
+            {1.8998560359992867, 10.708892844334745, -4.823210983922782,
+             10.202109059054063, 4.298747764427364, 2.199497022778097},
+            {2.071204284004704, 6.741738604119316, -11.099716230158746,
+             14.106488110189458, 5.846203546614067, 2.62230136903594}
+        }
+    },
+    {
+        // omega < 0, qq
+        {
+            {0.059730780828164666, 0.3631534872548789, 0.39845046966687,
+             0.11946615972422633, 0.03559276204445307, 0.00291041965645416},
+            {0.07216040121873951, 0.5471138972952214, 0.5792306465939813,
+             0.1723078888161528, 0.05120408756812135, 0.0041777787108426695},
+            {0.0846236909779996, 0.7725791286875564, 0.7931123494736929,
+             0.23406373724706608, 0.06935459958589639, 0.005644055718614478},
+            {0.09711346786308672, 1.0370070423372528, 1.036935526583188,
+             0.3034025403259155, 0.08957509599955729, 0.007264393465593115},
+            {0.10962479860948156, 1.3372010137066646, 1.307456863105879,
+             0.37910328734850873, 0.111456899829735, 0.009000895144744121},
+            {0.1221541053951596, 1.6686065099273535, 1.600404353394210,
+             0.4594932213772782, 0.13442407314203592, 0.010800449048880756},
+            {0.13469861652518803, 2.0276317271182074, 1.912613330851788,
+             0.5434449889160747, 0.15810564016236883, 0.012629305933671075},
+            {0.14725614907227047, 2.4109122726272654, 2.241198157777867,
+             0.6299396046048817, 0.18216575652552597, 0.014456750325370632},
+            {0.15982489441001274, 2.815254291049982, 2.583462624103292,
+             0.7180274724508857, 0.20629432847931367, 0.01625568033747704},
+            {0.17240331582158486, 3.238290376079149, 2.9374985881586273,
+             0.8071008047950518, 0.23030341585944009, 0.018010096397556033}
+        },
+        // omega < 0, qg
+        {
+            {0.3166913701414167, 1.0992070651449564, 1.4232219292986843,
+             0.4655268754156213, 0.1444497238817506, 0.012281442189758532},
+            {0.3804527486448292, 1.7114836115114735, 2.093540209692791,
+             0.6787666526042345, 0.21014340589291994, 0.017832857383112792},
+            {0.44393432393104637, 2.483663499207573, 2.8979112438999044,
+             0.9316968286688833, 0.28780901378857465, 0.02438874287373154},
+            {0.5071424487228405, 3.4070556051784515, 3.824491419496227,
+             1.2191109771387096, 0.3755459972857442, 0.03174924882247299},
+            {0.5700856365203443, 4.466964606692036, 4.857999356928031,
+             1.5348360053714125, 0.471215528026891, 0.03971601962636114},
+            {0.6327732610959403, 5.646624908846933, 5.982691423451806,
+             1.8728243844356356, 0.572761497659723, 0.04809998538877525},
+            {0.6952147319486842, 6.931552369487635, 7.185588273540373,
+             2.228328283532209, 0.6786029643259804, 0.056755908207122875},
+            {0.7574189285141091, 8.307255807497631, 8.454112812202247,
+             2.596781386863294, 0.7872276571283385, 0.06554867983133447},
+            {0.8193940883937045, 9.761691032241623, 9.777948193339808,
+             2.9744411293541457, 0.8973688582323887, 0.07435862848596686},
+            {0.8811479514201789, 11.286034194965852, 11.15001447311135,
+             3.3591358778545803, 1.0083901554550654, 0.08313659597360733}
+        }
+    }
+};
+
 RateElastic Martini::getRateElasTotal(double pRest, double T) {
   // compute the total transition rate in GeV, integrated over k, omega
   // and q and angles for fixed E=p and temperature T
   // using parametrization of numerically computed integral
-  // then interpolate to get right value for used alpha_s
+  // interpolated to the used alpha_s
   // IMPORTANT: all computed values below are for a minimal omega of 0.05*T
   // so this is the cutoff to use in the calculation also!
   // also Nf=3 was used ... scales out though
 
-  RateElastic rate;
-
   double u = pRest / T; // making arguments in log to be dimensionless
 
-  double alpha0 = 0.15;
-  double deltaAlpha = 0.03;
-  double iAlpha = floor((alpha_s - alpha0) / deltaAlpha + 0.001);
-  double alphaFrac = (alpha_s - alpha0) / deltaAlpha - iAlpha;
-  double rateLower, rateUpper;
-  double c[2][6], d[2][6];
-
-  for (int i = 0; i < 2; i++)
-    for (int j = 0; j < 6; j++) {
-      c[i][j] = 0.;
-      d[i][j] = 0.;
-    }
-
-  if (alpha_s >= 0.15 && alpha_s < 0.18) {
-    c[0][0] = 0.18172488396136807;
-    c[1][0] = 0.224596478395945;
-    c[0][1] = 0.6004740049060965;
-    c[1][1] = 1.0874259848101948;
-    c[0][2] = 0.36559627257898347;
-    c[1][2] = 0.6436398538984057;
-    c[0][3] = 0.10607576568373664;
-    c[1][3] = 0.11585154613692052;
-    c[0][4] = 0.004322466954618182;
-    c[1][4] = -0.001719701730785056;
-    c[0][5] = 0.04731599462749122;
-    c[1][5] = 0.06734745496415469;
-  } else if (alpha_s >= 0.18 && alpha_s < 0.21) {
-    c[0][0] = 0.224596478395945;
-    c[1][0] = 0.2686436092048326;
-    c[0][1] = 1.0874259848101948;
-    c[1][1] = 1.7286136256785387;
-    c[0][2] = 0.6436398538984057;
-    c[1][2] = 0.9826325498183079;
-    c[0][3] = 0.11585154613692052;
-    c[1][3] = 0.13136670133029682;
-    c[0][4] = -0.001719701730785056;
-    c[1][4] = -0.004876376882437649;
-    c[0][5] = 0.06734745496415469;
-    c[1][5] = 0.09140316977554151;
-  } else if (alpha_s >= 0.21 && alpha_s < 0.24) {
-    c[0][0] = 0.2686436092048326;
-    c[1][0] = 0.3137234778163784;
-    c[0][1] = 1.7286136256785387;
-    c[1][1] = 2.445764079999846;
-    c[0][2] = 0.9826325498183079;
-    c[1][2] = 1.3083241146035964;
-    c[0][3] = 0.13136670133029682;
-    c[1][3] = 0.18341717903923757;
-    c[0][4] = -0.004876376882437649;
-    c[1][4] = 0.006098371807040589;
-    c[0][5] = 0.09140316977554151;
-    c[1][5] = 0.12054238276023879;
-  } else if (alpha_s >= 0.24 && alpha_s < 0.27) {
-    c[0][0] = 0.3137234778163784;
-    c[1][0] = 0.3597255453974444;
-    c[0][1] = 2.445764079999846;
-    c[1][1] = 3.140669321831845;
-    c[0][2] = 1.3083241146035964;
-    c[1][2] = 1.535549334026633;
-    c[0][3] = 0.18341717903923757;
-    c[1][3] = 0.30505450230754705;
-    c[0][4] = 0.006098371807040589;
-    c[1][4] = 0.04285103618362223;
-    c[0][5] = 0.12054238276023879;
-    c[1][5] = 0.1558288379712527;
-  } else if (alpha_s >= 0.27 && alpha_s < 0.3) {
-    c[0][0] = 0.3597255453974444;
-    c[1][0] = 0.40656130602563223;
-    c[0][1] = 3.140669321831845;
-    c[1][1] = 3.713430971987352;
-    c[0][2] = 1.535549334026633;
-    c[1][2] = 1.5818298058630476;
-    c[0][3] = 0.30505450230754705;
-    c[1][3] = 0.5269042544852683;
-    c[0][4] = 0.04285103618362223;
-    c[1][4] = 0.11594975218839362;
-    c[0][5] = 0.1558288379712527;
-    c[1][5] = 0.1982063104156748;
-  } else if (alpha_s >= 0.3 && alpha_s < 0.33) {
-    c[0][0] = 0.40656130602563223;
-    c[1][0] = 0.45415805200862863;
-    c[0][1] = 3.713430971987352;
-    c[1][1] = 4.0758813206143785;
-    c[0][2] = 1.5818298058630476;
-    c[1][2] = 1.3775134184861555;
-    c[0][3] = 0.5269042544852683;
-    c[1][3] = 0.873527536823307;
-    c[0][4] = 0.11594975218839362;
-    c[1][4] = 0.23371456949506658;
-    c[0][5] = 0.1982063104156748;
-    c[1][5] = 0.24840524848507203;
-  } else if (alpha_s >= 0.33 && alpha_s < 0.36) {
-    c[0][0] = 0.45415805200862863;
-    c[1][0] = 0.5024541413891354;
-    c[0][1] = 4.0758813206143785;
-    c[1][1] = 4.159425815179756;
-    c[0][2] = 1.3775134184861555;
-    c[1][2] = 0.8719749565879445;
-    c[0][3] = 0.873527536823307;
-    c[1][3] = 1.3606690530660879;
-    c[0][4] = 0.23371456949506658;
-    c[1][4] = 0.4010658149846402;
-    c[0][5] = 0.24840524848507203;
-    c[1][5] = 0.3067901992139913;
-  } else if (alpha_s >= 0.36 && alpha_s < 0.39) {
-    c[0][0] = 0.5024541413891354;
-    c[1][0] = 0.5513999693402064;
-    c[0][1] = 4.159425815179756;
-    c[1][1] = 3.893153859527746;
-    c[0][2] = 0.8719749565879445;
-    c[1][2] = 0.009578762778659829;
-    c[0][3] = 1.3606690530660879;
-    c[1][3] = 2.0095157488463244;
-    c[0][4] = 0.4010658149846402;
-    c[1][4] = 0.6260756501912864;
-    c[0][5] = 0.3067901992139913;
-    c[1][5] = 0.37424991045026396;
-  } else if (alpha_s >= 0.39 && alpha_s <= 0.42) {
-    c[0][0] = 0.5513999693402064;
-    c[1][0] = 0.600941593540798;
-    c[0][1] = 3.893153859527746;
-    c[1][1] = 3.293344337592684;
-    c[0][2] = 0.009578762778659829;
-    c[1][2] = -1.1764805445298645;
-    c[0][3] = 2.0095157488463244;
-    c[1][3] = 2.792180001243466;
-    c[0][4] = 0.6260756501912864;
-    c[1][4] = 0.8949534049225013;
-    c[0][5] = 0.37424991045026396;
-    c[1][5] = 0.44878529934031575;
-  }
-
-  rateLower = T * (c[0][0] + c[0][1] / pow(u, 4.) - c[0][2] / pow(u, 3.) -
-                   c[0][3] / pow(u, 2.) + c[0][4] / pow(u, 1.5) - c[0][5] / u);
-  rateUpper = T * (c[1][0] + c[1][1] / pow(u, 4.) - c[1][2] / pow(u, 3.) -
-                   c[1][3] / pow(u, 2.) + c[1][4] / pow(u, 1.5) - c[1][5] / u);
-
-  rate.qq = (1. - alphaFrac) * rateLower + alphaFrac * rateUpper;
-  rate.qq *= nf / 3.; // adjust number of flavors
-
-  rate.gq = rate.qq * 9. / 4.;
-
-  if (alpha_s >= 0.15 && alpha_s < 0.18) {
-    d[0][0] = 0.9364689080337059;
-    d[1][0] = 1.1485486950080581;
-    d[0][1] = 2.626076478553979;
-    d[1][1] = 4.993647646894147;
-    d[0][2] = 2.1171556605834274;
-    d[1][2] = 3.7295251994302876;
-    d[0][3] = 0.13123339226210134;
-    d[1][3] = -0.0017620287506503757;
-    d[0][4] = 0.02875811664147147;
-    d[1][4] = 0.010598257485913224;
-    d[0][5] = 0.27736469898722244;
-    d[1][5] = 0.3949856219367327;
-  } else if (alpha_s >= 0.18 && alpha_s < 0.21) {
-    d[0][0] = 1.1485486950080581;
-    d[1][0] = 1.3645568637616001;
-    d[0][1] = 4.993647646894147;
-    d[1][1] = 8.174225869366722;
-    d[0][2] = 3.7295251994302876;
-    d[1][2] = 5.732101892684938;
-    d[0][3] = -0.001762028750650376;
-    d[1][3] = -0.1416811579957863;
-    d[0][4] = 0.010598257485913224;
-    d[1][4] = 0.011703596451947428;
-    d[0][5] = 0.3949856219367327;
-    d[1][5] = 0.5354757997870718;
-  } else if (alpha_s >= 0.21 && alpha_s < 0.24) {
-    d[0][0] = 1.3645568637616001;
-    d[1][0] = 1.5839378568555678;
-    d[0][1] = 8.174225869366722;
-    d[1][1] = 11.785897000063443;
-    d[0][2] = 5.732101892684938;
-    d[1][2] = 7.758388282689373;
-    d[0][3] = -0.1416811579957863;
-    d[1][3] = -0.13163385415183002;
-    d[0][4] = 0.011703596451947428;
-    d[1][4] = 0.09016386041913003;
-    d[0][5] = 0.5354757997870718;
-    d[1][5] = 0.7042577279136836;
-  } else if (alpha_s >= 0.24 && alpha_s < 0.27) {
-    d[0][0] = 1.5839378568555678;
-    d[1][0] = 1.8062676019060235;
-    d[0][1] = 11.785897000063443;
-    d[1][1] = 15.344112642069764;
-    d[0][2] = 7.758388282689373;
-    d[1][2] = 9.384190917330093;
-    d[0][3] = -0.13163385415183002;
-    d[1][3] = 0.19709400976261568;
-    d[0][4] = 0.09016386041913003;
-    d[1][4] = 0.30577623140224813;
-    d[0][5] = 0.7042577279136836;
-    d[1][5] = 0.9066501895009754;
-  } else if (alpha_s >= 0.27 && alpha_s < 0.3) {
-    d[0][0] = 1.8062676019060235;
-    d[1][0] = 2.0312125903238236;
-    d[0][1] = 15.344112642069764;
-    d[1][1] = 18.36844006721506;
-    d[0][2] = 9.384190917330093;
-    d[1][2] = 10.209988454804193;
-    d[0][3] = 0.19709400976261568;
-    d[1][3] = 0.9957025988944573;
-    d[0][4] = 0.30577623140224813;
-    d[1][4] = 0.7109302867706849;
-    d[0][5] = 0.9066501895009754;
-    d[1][5] = 1.1472148515742653;
-  } else if (alpha_s >= 0.3 && alpha_s < 0.33) {
-    d[0][0] = 2.0312125903238236;
-    d[1][0] = 2.258502734110078;
-    d[0][1] = 18.36844006721506;
-    d[1][1] = 20.43444928479894;
-    d[0][2] = 10.209988454804193;
-    d[1][2] = 9.896928897847518;
-    d[0][3] = 0.9957025988944573;
-    d[1][3] = 2.3867073785159003;
-    d[0][4] = 0.7109302867706849;
-    d[1][4] = 1.3473328178504662;
-    d[0][5] = 1.1472148515742653;
-    d[1][5] = 1.429497460496924;
-  } else if (alpha_s >= 0.33 && alpha_s < 0.36) {
-    d[0][0] = 2.258502734110078;
-    d[1][0] = 2.4879110920956653;
-    d[0][1] = 20.43444928479894;
-    d[1][1] = 21.220550462966102;
-    d[0][2] = 9.896928897847518;
-    d[1][2] = 8.20639681844989;
-    d[0][3] = 2.3867073785159003;
-    d[1][3] = 4.445222616370339;
-    d[0][4] = 1.3473328178504662;
-    d[1][4] = 2.2381176005506016;
-    d[0][5] = 1.429497460496924;
-    d[1][5] = 1.7550164762706189;
-  } else if (alpha_s >= 0.36 && alpha_s < 0.39) {
-    d[0][0] = 2.4879110920956653;
-    d[1][0] = 2.7192501243929903;
-    d[0][1] = 21.220550462966102;
-    d[1][1] = 20.470583876561985;
-    d[0][2] = 8.20639681844989;
-    d[1][2] = 4.954737209403953;
-    d[0][3] = 4.445222616370339;
-    d[1][3] = 7.227667929705693;
-    d[0][4] = 2.2381176005506016;
-    d[1][4] = 3.401378906197122;
-    d[0][5] = 1.7550164762706189;
-    d[1][5] = 2.1251383942923474;
-  } else if (alpha_s >= 0.39 && alpha_s <= 0.42) {
-    d[0][0] = 2.7192501243929903;
-    d[1][0] = 2.9523522354248817;
-    d[0][1] = 20.470583876561985;
-    d[1][1] = 18.027772799078463;
-    d[0][2] = 4.954737209403953;
-    d[1][2] = 0.050298242947981846;
-    d[0][3] = 7.227667929705693;
-    d[1][3] = 10.747352232336384;
-    d[0][4] = 3.401378906197122;
-    d[1][4] = 4.8378133911595285;
-    d[0][5] = 2.1251383942923474;
-    d[1][5] = 2.5391647730624003;
-  }
-
-  rateLower = T * (d[0][0] + d[0][1] / pow(u, 4.) - d[0][2] / pow(u, 3.) -
-                   d[0][3] / pow(u, 2.) + d[0][4] / pow(u, 1.5) - d[0][5] / u);
-  rateUpper = T * (d[1][0] + d[1][1] / pow(u, 4.) - d[1][2] / pow(u, 3.) -
-                   d[1][3] / pow(u, 2.) + d[1][4] / pow(u, 1.5) - d[1][5] / u);
-
-  rate.qg = (1. - alphaFrac) * rateLower + alphaFrac * rateUpper;
-  rate.qg /= 3.; // historic reasons
-
-  rate.gg = rate.qg * 9. / 4.;
-
-  return rate;
+  return getRateElasFit(0, u, T);
 }
 
 RateElastic Martini::getRateElasPos(double u, double T) {
-  RateElastic rate;
+  return getRateElasFit(1, u, T);
+}
 
-  double alpha0 = 0.15;
-  double deltaAlpha = 0.03;
-  double iAlpha = floor((alpha_s - alpha0) / deltaAlpha + 0.001);
-  double alphaFrac = (alpha_s - alpha0) / deltaAlpha - iAlpha;
-  double rateLower, rateUpper;
-  double c[2][6], d[2][6];
+RateElastic Martini::getRateElasNeg(double u, double T) {
+  return getRateElasFit(2, u, T);
+}
 
-  for (int i = 0; i < 2; i++)
-    for (int j = 0; j < 6; j++) {
-      c[i][j] = 0.;
-      d[i][j] = 0.;
-    }
+// rates from the fits interpolated to alpha_s, which = 0: total,
+// 1: omega > 0, 2: omega < 0
+RateElastic Martini::getRateElasFit(int which, double u, double T) {
+  if (alpha_s != elasticFitAlpha)
+    setElasticFits();
 
-  if (alpha_s >= 0.15 && alpha_s < 0.18) {
-    c[0][0] = 0.12199410313320332;
-    c[1][0] = 0.15243607717720586;
-    c[0][1] = 0.23732051765097376;
-    c[1][1] = 0.5403120875137825;
-    c[0][2] = -0.03285419708803458;
-    c[1][2] = 0.06440920730334501;
-    c[0][3] = 0.2255419254079952;
-    c[1][3] = 0.2881594349535524;
-    c[0][4] = 0.03991522899907729;
-    c[1][4] = 0.04948438583750772;
-    c[0][5] = 0.05022641428394594;
-    c[1][5] = 0.07152523367501308;
-  } else if (alpha_s >= 0.18 && alpha_s < 0.21) {
-    c[0][0] = 0.15243607717720586;
-    c[1][0] = 0.15243607717720586;
-    c[0][1] = 0.5403120875137825;
-    c[1][1] = 0.5403120875137825;
-    c[0][2] = 0.06440920730334501;
-    c[1][2] = 0.06440920730334501;
-    c[0][3] = 0.2881594349535524;
-    c[1][3] = 0.2881594349535524;
-    c[0][4] = 0.04948438583750772;
-    c[1][4] = 0.04948438583750772;
-    c[0][5] = 0.07152523367501308;
-    c[1][5] = 0.07152523367501308;
-  } else if (alpha_s >= 0.21 && alpha_s < 0.24) {
-    c[0][0] = 0.15243607717720586;
-    c[1][0] = 0.21661000995329158;
-    c[0][1] = 0.5403120875137825;
-    c[1][1] = 1.4087570376612657;
-    c[0][2] = 0.06440920730334501;
-    c[1][2] = 0.2713885880193171;
-    c[0][3] = 0.2881594349535524;
-    c[1][3] = 0.48681971936565244;
-    c[0][4] = 0.04948438583750772;
-    c[1][4] = 0.09567346780679847;
-    c[0][5] = 0.07152523367501308;
-    c[1][5] = 0.12780677622585393;
-  } else if (alpha_s >= 0.24 && alpha_s < 0.27) {
-    c[0][0] = 0.21661000995329158;
-    c[1][0] = 0.2501007467879627;
-    c[0][1] = 1.4087570376612657;
-    c[1][1] = 1.8034683081244214;
-    c[0][2] = 0.2713885880193171;
-    c[1][2] = 0.228092470920281;
-    c[0][3] = 0.48681971936565244;
-    c[1][3] = 0.6841577896561725;
-    c[0][4] = 0.09567346780679847;
-    c[1][4] = 0.15430793601338547;
-    c[0][5] = 0.12780677622585393;
-    c[1][5] = 0.1648297331159989;
-  } else if (alpha_s >= 0.27 && alpha_s < 0.3) {
-    c[0][0] = 0.2501007467879627;
-    c[1][0] = 0.28440720063047276;
-    c[0][1] = 1.8034683081244214;
-    c[1][1] = 2.0448244620634055;
-    c[0][2] = 0.228092470920281;
-    c[1][2] = -0.018574547528236382;
-    c[0][3] = 0.6841577896561725;
-    c[1][3] = 0.9863974758613413;
-    c[0][4] = 0.15430793601338547;
-    c[1][4] = 0.2503738253300167;
-    c[0][5] = 0.1648297331159989;
-    c[1][5] = 0.2090067594645225;
-  } else if (alpha_s >= 0.3 && alpha_s < 0.33) {
-    c[0][0] = 0.28440720063047276;
-    c[1][0] = 0.31945943548344036;
-    c[0][1] = 2.0448244620634055;
-    c[1][1] = 2.0482495934952256;
-    c[0][2] = -0.018574547528236382;
-    c[1][2] = -0.5350999123662686;
-    c[0][3] = 0.9863974758613413;
-    c[1][3] = 1.4169725257394696;
-    c[0][4] = 0.2503738253300167;
-    c[1][4] = 0.3918202096574105;
-    c[0][5] = 0.2090067594645225;
-    c[1][5] = 0.26103455441873036;
-  } else if (alpha_s >= 0.33 && alpha_s < 0.36) {
-    c[0][0] = 0.31945943548344036;
-    c[1][0] = 0.35519799231686516;
-    c[0][1] = 2.0482495934952256;
-    c[1][1] = 1.7485135425544152;
-    c[0][2] = -0.5350999123662686;
-    c[1][2] = -1.3692232011881413;
-    c[0][3] = 1.4169725257394696;
-    c[1][3] = 1.9906086576701993;
-    c[0][4] = 0.3918202096574105;
-    c[1][4] = 0.5832315715098879;
-    c[0][5] = 0.26103455441873036;
-    c[1][5] = 0.32124694953933486;
-  } else if (alpha_s >= 0.36 && alpha_s < 0.39) {
-    c[0][0] = 0.35519799231686516;
-    c[1][0] = 0.39157507493019383;
-    c[0][1] = 1.7485135425544152;
-    c[1][1] = 1.0778995684787331;
-    c[0][2] = -1.3692232011881413;
-    c[1][2] = -2.5738838613236457;
-    c[0][3] = 1.9906086576701993;
-    c[1][3] = 2.727543221296746;
-    c[0][4] = 0.5832315715098879;
-    c[1][4] = 0.8323699786704292;
-    c[0][5] = 0.32124694953933486;
-    c[1][5] = 0.3905055907877247;
-  } else if (alpha_s >= 0.39 && alpha_s <= 0.42) {
-    c[0][0] = 0.39157507493019383;
-    c[1][0] = 0.4285382777192131;
-    c[0][1] = 1.0778995684787331;
-    c[1][1] = 0.05505396151716547;
-    c[0][2] = -2.5738838613236457;
-    c[1][2] = -4.113979132685303;
-    c[0][3] = 2.727543221296746;
-    c[1][3] = 3.5992808060371506;
-    c[0][4] = 0.8323699786704292;
-    c[1][4] = 1.1252568207814462;
-    c[0][5] = 0.3905055907877247;
-    c[1][5] = 0.4667953957378259;
-  }
+  double x = 1. / u;
+  double x2 = x * x;
+  double xSqrt = sqrt(x);
+  const double *c = elasticFit[which][0];
+  const double *d = elasticFit[which][1];
 
-  rateLower = T * (c[0][0] + c[0][1] / pow(u, 4.) - c[0][2] / pow(u, 3.) -
-                   c[0][3] / pow(u, 2.) + c[0][4] / pow(u, 1.5) - c[0][5] / u);
-  rateUpper = T * (c[1][0] + c[1][1] / pow(u, 4.) - c[1][2] / pow(u, 3.) -
-                   c[1][3] / pow(u, 2.) + c[1][4] / pow(u, 1.5) - c[1][5] / u);
+  RateElastic rate;
 
-  rate.qq = (1. - alphaFrac) * rateLower + alphaFrac * rateUpper;
+  rate.qq = T * (c[0] + c[1] * x2 * x2 - c[2] * x2 * x - c[3] * x2 +
+                 c[4] * x * xSqrt - c[5] * x);
   rate.qq *= nf / 3.; // adjust number of flavors
 
   rate.gq = rate.qq * 9. / 4.;
 
-  if (alpha_s >= 0.15 && alpha_s < 0.18) {
-    d[0][0] = 0.6197775378922895;
-    d[1][0] = 0.7680959463632293;
-    d[0][1] = 1.5268694134079064;
-    d[1][1] = 3.282164035377037;
-    d[0][2] = 0.6939337312845367;
-    d[1][2] = 1.6359849897319092;
-    d[0][3] = 0.5967602676773388;
-    d[1][3] = 0.6770046238563808;
-    d[0][4] = 0.17320784052297564;
-    d[1][4] = 0.22074166337990309;
-    d[0][5] = 0.28964614117694565;
-    d[1][5] = 0.4128184793199476;
-  } else if (alpha_s >= 0.18 && alpha_s < 0.21) {
-    d[0][0] = 0.7680959463632293;
-    d[1][0] = 0.9206225398305536;
-    d[0][1] = 3.282164035377037;
-    d[1][1] = 5.690562370150853;
-    d[0][2] = 1.6359849897319092;
-    d[1][2] = 2.8341906487774318;
-    d[0][3] = 0.6770046238563808;
-    d[1][3] = 0.7900156706763937;
-    d[0][4] = 0.22074166337990309;
-    d[1][4] = 0.2995126102416747;
-    d[0][5] = 0.4128184793199476;
-    d[1][5] = 0.5598645426609049;
-  } else if (alpha_s >= 0.21 && alpha_s < 0.24) {
-    d[0][0] = 0.9206225398305536;
-    d[1][0] = 1.0767954081327265;
-    d[0][1] = 5.690562370150853;
-    d[1][1] = 8.378841394880034;
-    d[0][2] = 2.8341906487774318;
-    d[1][2] = 3.9338968631891396;
-    d[0][3] = 0.7900156706763937;
-    d[1][3] = 1.0874771229885156;
-    d[0][4] = 0.2995126102416747;
-    d[1][4] = 0.46570985770548107;
-    d[0][5] = 0.5598645426609049;
-    d[1][5] = 0.7360069767362173;
-  } else if (alpha_s >= 0.24 && alpha_s < 0.27) {
-    d[0][0] = 1.0767954081327265;
-    d[1][0] = 1.2361819653856791;
-    d[0][1] = 8.378841394880034;
-    d[1][1] = 10.877148035367144;
-    d[0][2] = 3.9338968631891396;
-    d[1][2] = 4.526191560392149;
-    d[0][3] = 1.0874771229885156;
-    d[1][3] = 1.731930015138816;
-    d[0][4] = 0.46570985770548107;
-    d[1][4] = 0.7769917594310469;
-    d[0][5] = 0.7360069767362173;
-    d[1][5] = 0.9463662091275489;
-  } else if (alpha_s >= 0.27 && alpha_s < 0.3) {
-    d[0][0] = 1.2361819653856791;
-    d[1][0] = 1.3984393292278847;
-    d[0][1] = 10.877148035367144;
-    d[1][1] = 12.72181515837248;
-    d[0][2] = 4.526191560392149;
-    d[1][2] = 4.227297031355039;
-    d[0][3] = 1.731930015138816;
-    d[1][3] = 2.868526983329731;
-    d[0][4] = 0.7769917594310469;
-    d[1][4] = 1.2836917844304823;
-    d[0][5] = 0.9463662091275489;
-    d[1][5] = 1.1953148369630755;
-  } else if (alpha_s >= 0.3 && alpha_s < 0.33) {
-    d[0][0] = 1.3984393292278847;
-    d[1][0] = 1.5632880021613935;
-    d[0][1] = 12.72181515837248;
-    d[1][1] = 13.502896915302873;
-    d[0][2] = 4.227297031355039;
-    d[1][2] = 2.7113406243010467;
-    d[0][3] = 2.868526983329731;
-    d[1][3] = 4.615035662049938;
-    d[0][4] = 1.2836917844304823;
-    d[1][4] = 2.0259357821768784;
-    d[0][5] = 1.1953148369630755;
-    d[1][5] = 1.486253368704046;
-  } else if (alpha_s >= 0.33 && alpha_s < 0.36) {
-    d[0][0] = 1.5632880021613935;
-    d[1][0] = 1.730492163581557;
-    d[0][1] = 13.502896915302873;
-    d[1][1] = 12.913294655478987;
-    d[0][2] = 2.7113406243010467;
-    d[1][2] = -0.2477159937428581;
-    d[0][3] = 4.615035662049938;
-    d[1][3] = 7.042004003229154;
-    d[0][4] = 2.0259357821768784;
-    d[1][4] = 3.0253452576771465;
-    d[0][5] = 1.486253368704046;
-    d[1][5] = 1.8205651561017433;
-  } else if (alpha_s >= 0.36 && alpha_s < 0.39) {
-    d[0][0] = 1.730492163581557;
-    d[1][0] = 1.8998560359992867;
-    d[0][1] = 12.913294655478987;
-    d[1][1] = 10.708892844334745;
-    d[0][2] = -0.2477159937428581;
-    d[1][2] = -4.823210983922782;
-    d[0][3] = 7.042004003229154;
-    d[1][3] = 10.202109059054063;
-    d[0][4] = 3.0253452576771465;
-    d[1][4] = 4.298747764427364;
-    d[0][5] = 1.8205651561017433;
-    d[1][5] = 2.199497022778097;
-  } else if (alpha_s >= 0.39 && alpha_s <= 0.42) {
-    d[0][0] = 1.8998560359992867;
-    d[1][0] = 2.071204284004704;
-    d[0][1] = 10.708892844334745;
-    d[1][1] = 6.741738604119316;
-    d[0][2] = -4.823210983922782;
-    d[1][2] = -11.099716230158746;
-    d[0][3] = 10.202109059054063;
-    d[1][3] = 14.106488110189458;
-    d[0][4] = 4.298747764427364;
-    d[1][4] = 5.846203546614067;
-    d[0][5] = 2.199497022778097;
-    d[1][5] = 2.62230136903594;
-  }
-
-  rateLower = T * (d[0][0] + d[0][1] / pow(u, 4.) - d[0][2] / pow(u, 3.) -
-                   d[0][3] / pow(u, 2.) + d[0][4] / pow(u, 1.5) - d[0][5] / u);
-  rateUpper = T * (d[1][0] + d[1][1] / pow(u, 4.) - d[1][2] / pow(u, 3.) -
-                   d[1][3] / pow(u, 2.) + d[1][4] / pow(u, 1.5) - d[1][5] / u);
-
-  rate.qg = (1. - alphaFrac) * rateLower + alphaFrac * rateUpper;
+  rate.qg = T * (d[0] + d[1] * x2 * x2 - d[2] * x2 * x - d[3] * x2 +
+                 d[4] * x * xSqrt - d[5] * x);
   rate.qg /= 3.; // historic reasons
 
   rate.gg = rate.qg * 9. / 4.;
@@ -1930,293 +1677,53 @@ RateElastic Martini::getRateElasPos(double u, double T) {
   return rate;
 }
 
-RateElastic Martini::getRateElasNeg(double u, double T) {
-  RateElastic rate;
+// Interpolates the fit coefficients linearly to alpha_s, once for every new
+// value of alpha_s. Outside of 0.15 <= alpha_s <= 0.42 the rates vanish.
+void Martini::setElasticFits() {
+  const double alphaNodes[NalphasFit] = {0.15, 0.18, 0.21, 0.24, 0.27,
+                                         0.3,  0.33, 0.36, 0.39, 0.42};
+  elasticFitAlpha = alpha_s;
+
+  int node = -1;
+  for (int i = 0; i < NalphasFit - 1; i++) {
+    if (alpha_s >= alphaNodes[i] &&
+        (alpha_s < alphaNodes[i + 1] ||
+         (i == NalphasFit - 2 && alpha_s <= alphaNodes[i + 1]))) {
+      node = i;
+      break;
+    }
+  }
 
   double alpha0 = 0.15;
   double deltaAlpha = 0.03;
   double iAlpha = floor((alpha_s - alpha0) / deltaAlpha + 0.001);
   double alphaFrac = (alpha_s - alpha0) / deltaAlpha - iAlpha;
-  double rateLower, rateUpper;
-  double c[2][6], d[2][6];
-
-  for (int i = 0; i < 2; i++)
-    for (int j = 0; j < 6; j++) {
-      c[i][j] = 0.;
-      d[i][j] = 0.;
-    }
-
-  if (alpha_s >= 0.15 && alpha_s < 0.18) {
-    c[0][0] = 0.059730780828164666;
-    c[1][0] = 0.07216040121873951;
-    c[0][1] = 0.3631534872548789;
-    c[1][1] = 0.5471138972952214;
-    c[0][2] = 0.39845046966687;
-    c[1][2] = 0.5792306465939813;
-    c[0][3] = 0.11946615972422633;
-    c[1][3] = 0.1723078888161528;
-    c[0][4] = 0.03559276204445307;
-    c[1][4] = 0.05120408756812135;
-    c[0][5] = 0.00291041965645416;
-    c[1][5] = 0.0041777787108426695;
-  } else if (alpha_s >= 0.18 && alpha_s < 0.21) {
-    c[0][0] = 0.07216040121873951;
-    c[1][0] = 0.0846236909779996;
-    c[0][1] = 0.5471138972952214;
-    c[1][1] = 0.7725791286875564;
-    c[0][2] = 0.5792306465939813;
-    c[1][2] = 0.7931123494736929;
-    c[0][3] = 0.1723078888161528;
-    c[1][3] = 0.23406373724706608;
-    c[0][4] = 0.05120408756812135;
-    c[1][4] = 0.06935459958589639;
-    c[0][5] = 0.0041777787108426695;
-    c[1][5] = 0.005644055718614478;
-  } else if (alpha_s >= 0.21 && alpha_s < 0.24) {
-    c[0][0] = 0.0846236909779996;
-    c[1][0] = 0.09711346786308672;
-    c[0][1] = 0.7725791286875564;
-    c[1][1] = 1.0370070423372528;
-    c[0][2] = 0.7931123494736929;
-    c[1][2] = 1.036935526583188;
-    c[0][3] = 0.23406373724706608;
-    c[1][3] = 0.3034025403259155;
-    c[0][4] = 0.06935459958589639;
-    c[1][4] = 0.08957509599955729;
-    c[0][5] = 0.005644055718614478;
-    c[1][5] = 0.007264393465593115;
-  } else if (alpha_s >= 0.24 && alpha_s < 0.27) {
-    c[0][0] = 0.09711346786308672;
-    c[1][0] = 0.10962479860948156;
-    c[0][1] = 1.0370070423372528;
-    c[1][1] = 1.3372010137066646;
-    c[0][2] = 1.036935526583188;
-    c[1][2] = 1.307456863105879;
-    c[0][3] = 0.3034025403259155;
-    c[1][3] = 0.37910328734850873;
-    c[0][4] = 0.08957509599955729;
-    c[1][4] = 0.111456899829735;
-    c[0][5] = 0.007264393465593115;
-    c[1][5] = 0.009000895144744121;
-  } else if (alpha_s >= 0.27 && alpha_s < 0.3) {
-    c[0][0] = 0.10962479860948156;
-    c[1][0] = 0.1221541053951596;
-    c[0][1] = 1.3372010137066646;
-    c[1][1] = 1.6686065099273535;
-    c[0][2] = 1.307456863105879;
-    c[1][2] = 1.600404353394210;
-    c[0][3] = 0.37910328734850873;
-    c[1][3] = 0.4594932213772782;
-    c[0][4] = 0.111456899829735;
-    c[1][4] = 0.13442407314203592;
-    c[0][5] = 0.009000895144744121;
-    c[1][5] = 0.010800449048880756;
-  } else if (alpha_s >= 0.3 && alpha_s < 0.33) {
-    c[0][0] = 0.1221541053951596;
-    c[1][0] = 0.13469861652518803;
-    c[0][1] = 1.6686065099273535;
-    c[1][1] = 2.0276317271182074;
-    c[0][2] = 1.600404353394210;
-    c[1][2] = 1.912613330851788;
-    c[0][3] = 0.4594932213772782;
-    c[1][3] = 0.5434449889160747;
-    c[0][4] = 0.13442407314203592;
-    c[1][4] = 0.15810564016236883;
-    c[0][5] = 0.010800449048880756;
-    c[1][5] = 0.012629305933671075;
-  } else if (alpha_s >= 0.33 && alpha_s < 0.36) {
-    c[0][0] = 0.13469861652518803;
-    c[1][0] = 0.14725614907227047;
-    c[0][1] = 2.0276317271182074;
-    c[1][1] = 2.4109122726272654;
-    c[0][2] = 1.912613330851788;
-    c[1][2] = 2.241198157777867;
-    c[0][3] = 0.5434449889160747;
-    c[1][3] = 0.6299396046048817;
-    c[0][4] = 0.15810564016236883;
-    c[1][4] = 0.18216575652552597;
-    c[0][5] = 0.012629305933671075;
-    c[1][5] = 0.014456750325370632;
-  } else if (alpha_s >= 0.36 && alpha_s < 0.39) {
-    c[0][0] = 0.14725614907227047;
-    c[1][0] = 0.15982489441001274;
-    c[0][1] = 2.4109122726272654;
-    c[1][1] = 2.815254291049982;
-    c[0][2] = 2.241198157777867;
-    c[1][2] = 2.583462624103292;
-    c[0][3] = 0.6299396046048817;
-    c[1][3] = 0.7180274724508857;
-    c[0][4] = 0.18216575652552597;
-    c[1][4] = 0.20629432847931367;
-    c[0][5] = 0.014456750325370632;
-    c[1][5] = 0.01625568033747704;
-  } else if (alpha_s >= 0.39 && alpha_s <= 0.42) {
-    c[0][0] = 0.15982489441001274;
-    c[1][0] = 0.17240331582158486;
-    c[0][1] = 2.815254291049982;
-    c[1][1] = 3.238290376079149;
-    c[0][2] = 2.583462624103292;
-    c[1][2] = 2.9374985881586273;
-    c[0][3] = 0.7180274724508857;
-    c[1][3] = 0.8071008047950518;
-    c[0][4] = 0.20629432847931367;
-    c[1][4] = 0.23030341585944009;
-    c[0][5] = 0.01625568033747704;
-    c[1][5] = 0.018010096397556033;
-  }
-
-  rateLower = T * (c[0][0] + c[0][1] / pow(u, 4.) - c[0][2] / pow(u, 3.) -
-                   c[0][3] / pow(u, 2.) + c[0][4] / pow(u, 1.5) - c[0][5] / u);
-  rateUpper = T * (c[1][0] + c[1][1] / pow(u, 4.) - c[1][2] / pow(u, 3.) -
-                   c[1][3] / pow(u, 2.) + c[1][4] / pow(u, 1.5) - c[1][5] / u);
-
-  rate.qq = (1. - alphaFrac) * rateLower + alphaFrac * rateUpper;
-  rate.qq *= nf / 3.; // adjust number of flavors
-
-  rate.gq = rate.qq * 9. / 4.;
 
-  if (alpha_s >= 0.15 && alpha_s < 0.18) {
-    d[0][0] = 0.3166913701414167;
-    d[1][0] = 0.3804527486448292;
-    d[0][1] = 1.0992070651449564;
-    d[1][1] = 1.7114836115114735;
-    d[0][2] = 1.4232219292986843;
-    d[1][2] = 2.093540209692791;
-    d[0][3] = 0.4655268754156213;
-    d[1][3] = 0.6787666526042345;
-    d[0][4] = 0.1444497238817506;
-    d[1][4] = 0.21014340589291994;
-    d[0][5] = 0.012281442189758532;
-    d[1][5] = 0.017832857383112792;
-  } else if (alpha_s >= 0.18 && alpha_s < 0.21) {
-    d[0][0] = 0.3804527486448292;
-    d[1][0] = 0.44393432393104637;
-    d[0][1] = 1.7114836115114735;
-    d[1][1] = 2.483663499207573;
-    d[0][2] = 2.093540209692791;
-    d[1][2] = 2.8979112438999044;
-    d[0][3] = 0.6787666526042345;
-    d[1][3] = 0.9316968286688833;
-    d[0][4] = 0.21014340589291994;
-    d[1][4] = 0.28780901378857465;
-    d[0][5] = 0.017832857383112792;
-    d[1][5] = 0.02438874287373154;
-  } else if (alpha_s >= 0.21 && alpha_s < 0.24) {
-    d[0][0] = 0.44393432393104637;
-    d[1][0] = 0.5071424487228405;
-    d[0][1] = 2.483663499207573;
-    d[1][1] = 3.4070556051784515;
-    d[0][2] = 2.8979112438999044;
-    d[1][2] = 3.824491419496227;
-    d[0][3] = 0.9316968286688833;
-    d[1][3] = 1.2191109771387096;
-    d[0][4] = 0.28780901378857465;
-    d[1][4] = 0.3755459972857442;
-    d[0][5] = 0.02438874287373154;
-    d[1][5] = 0.03174924882247299;
-  } else if (alpha_s >= 0.24 && alpha_s < 0.27) {
-    d[0][0] = 0.5071424487228405;
-    d[1][0] = 0.5700856365203443;
-    d[0][1] = 3.4070556051784515;
-    d[1][1] = 4.466964606692036;
-    d[0][2] = 3.824491419496227;
-    d[1][2] = 4.857999356928031;
-    d[0][3] = 1.2191109771387096;
-    d[1][3] = 1.5348360053714125;
-    d[0][4] = 0.3755459972857442;
-    d[1][4] = 0.471215528026891;
-    d[0][5] = 0.03174924882247299;
-    d[1][5] = 0.03971601962636114;
-  } else if (alpha_s >= 0.27 && alpha_s < 0.3) {
-    d[0][0] = 0.5700856365203443;
-    d[1][0] = 0.6327732610959403;
-    d[0][1] = 4.466964606692036;
-    d[1][1] = 5.646624908846933;
-    d[0][2] = 4.857999356928031;
-    d[1][2] = 5.982691423451806;
-    d[0][3] = 1.5348360053714125;
-    d[1][3] = 1.8728243844356356;
-    d[0][4] = 0.471215528026891;
-    d[1][4] = 0.572761497659723;
-    d[0][5] = 0.03971601962636114;
-    d[1][5] = 0.04809998538877525;
-  } else if (alpha_s >= 0.3 && alpha_s < 0.33) {
-    d[0][0] = 0.6327732610959403;
-    d[1][0] = 0.6952147319486842;
-    d[0][1] = 5.646624908846933;
-    d[1][1] = 6.931552369487635;
-    d[0][2] = 5.982691423451806;
-    d[1][2] = 7.185588273540373;
-    d[0][3] = 1.8728243844356356;
-    d[1][3] = 2.228328283532209;
-    d[0][4] = 0.572761497659723;
-    d[1][4] = 0.6786029643259804;
-    d[0][5] = 0.04809998538877525;
-    d[1][5] = 0.056755908207122875;
-  } else if (alpha_s >= 0.33 && alpha_s < 0.36) {
-    d[0][0] = 0.6952147319486842;
-    d[1][0] = 0.7574189285141091;
-    d[0][1] = 6.931552369487635;
-    d[1][1] = 8.307255807497631;
-    d[0][2] = 7.185588273540373;
-    d[1][2] = 8.454112812202247;
-    d[0][3] = 2.228328283532209;
-    d[1][3] = 2.596781386863294;
-    d[0][4] = 0.6786029643259804;
-    d[1][4] = 0.7872276571283385;
-    d[0][5] = 0.056755908207122875;
-    d[1][5] = 0.06554867983133447;
-  } else if (alpha_s >= 0.36 && alpha_s < 0.39) {
-    d[0][0] = 0.7574189285141091;
-    d[1][0] = 0.8193940883937045;
-    d[0][1] = 8.307255807497631;
-    d[1][1] = 9.761691032241623;
-    d[0][2] = 8.454112812202247;
-    d[1][2] = 9.777948193339808;
-    d[0][3] = 2.596781386863294;
-    d[1][3] = 2.9744411293541457;
-    d[0][4] = 0.7872276571283385;
-    d[1][4] = 0.8973688582323887;
-    d[0][5] = 0.06554867983133447;
-    d[1][5] = 0.07435862848596686;
-  } else if (alpha_s >= 0.39 && alpha_s <= 0.42) {
-    d[0][0] = 0.8193940883937045;
-    d[1][0] = 0.8811479514201789;
-    d[0][1] = 9.761691032241623;
-    d[1][1] = 11.286034194965852;
-    d[0][2] = 9.777948193339808;
-    d[1][2] = 11.15001447311135;
-    d[0][3] = 2.9744411293541457;
-    d[1][3] = 3.3591358778545803;
-    d[0][4] = 0.8973688582323887;
-    d[1][4] = 1.0083901554550654;
-    d[0][5] = 0.07435862848596686;
-    d[1][5] = 0.08313659597360733;
-  }
-
-  rateLower = T * (d[0][0] + d[0][1] / pow(u, 4.) - d[0][2] / pow(u, 3.) -
-                   d[0][3] / pow(u, 2.) + d[0][4] / pow(u, 1.5) - d[0][5] / u);
-  rateUpper = T * (d[1][0] + d[1][1] / pow(u, 4.) - d[1][2] / pow(u, 3.) -
-                   d[1][3] / pow(u, 2.) + d[1][4] / pow(u, 1.5) - d[1][5] / u);
-
-  rate.qg = (1. - alphaFrac) * rateLower + alphaFrac * rateUpper;
-  rate.qg /= 3.; // historic reasons
-
-  rate.gg = rate.qg * 9. / 4.;
-
-  return rate;
+  for (int which = 0; which < 3; which++)
+    for (int kind = 0; kind < 2; kind++)
+      for (int j = 0; j < 6; j++) {
+        if (node < 0) {
+          elasticFit[which][kind][j] = 0.;
+          continue;
+        }
+        elasticFit[which][kind][j] =
+            (1. - alphaFrac) * elasticFitCoefficients[which][kind][node][j] +
+            alphaFrac * elasticFitCoefficients[which][kind][node + 1][j];
+      }
 }
 
 RateConversion Martini::getRateConv(double pRest, double T) {
   RateConversion rate;
 
+  double logTerm =
+      0.5 * log(pRest * T / ((1. / 6.) * g * g * T * T)) - 0.36149;
+
   rate.qg = 4. / 3. * 2. * M_PI * alpha_s * alpha_s * T * T / (3. * pRest) *
-            (0.5 * log(pRest * T / ((1. / 6.) * pow(g * T, 2.))) - 0.36149);
+            logTerm;
   rate.gq = nf * 3. / 8. * 4. / 3. * 2. * M_PI * alpha_s * alpha_s * T * T /
-            (3. * pRest) *
-            (0.5 * log(pRest * T / ((1. / 6.) * pow(g * T, 2.))) - 0.36149);
+            (3. * pRest) * logTerm;
   rate.qgamma = 2. * M_PI * alpha_s * alpha_em * T * T / (3. * pRest) *
-                (0.5 * log(pRest * T / ((1. / 6.) * pow(g * T, 2.))) - 0.36149);
+                logTerm;
 
   return rate;
 }
@@ -2726,6 +2233,12 @@ double Martini::getThermal(double k_min, double T, int kind) {
 }
 
 // Reads in the binary stored file of dGamma values
+void Martini::loadRadiativeRate() {
+  readRadiativeRate(&dat, &Gam);
+  if (tabulate_radiation)
+    buildRadiativeSampler();
+}
+
 void Martini::readRadiativeRate(Gamma_info *dat, dGammas *Gam) {
   FILE *rfile;
   string filename;
@@ -2779,6 +2292,60 @@ void Martini::readRadiativeRate(Gamma_info *dat, dGammas *Gam) {
   dat->k_max = 2 * dat->dp * (dat->n_k - 1) + dat->k_min;
 }
 
+// Tabulates dGamma/dk in the k index b of radgamma at every p node for each
+// sampling branch, together with its running integral.
+void Martini::buildRadiativeSampler() {
+  JSINFO << "Tabulating radiated momentum distributions ...";
+
+  const int process[NRadBranches] = {1, 1, 2, 3, 3, 4, 4};
+  auto tables = make_shared<vector<RadiativeCDF>>(NRadBranches * (NP - 1));
+
+  for (int branch = 0; branch < NRadBranches; branch++) {
+    for (int n_p = 0; n_p < NP - 1; n_p++) {
+      double u = 4.01 * exp(n_p / 24.7743737154026);
+      double yMin, yMax;
+      radiativeSupport(branch, u, yMin, yMax);
+
+      // cell edges sit on the grid of b, where dk/db and the bilinear
+      // interpolation of the table have their kinks; stay clear of the last
+      // k column, use_table reads one beyond it
+      double bMin = kIndex(u, yMin);
+      double bMax = kIndex(u, yMax);
+      int iMin = (int)floor(bMin * NRadSubSteps);
+      int iMax = (int)ceil(bMax * NRadSubSteps);
+      iMax = std::min(iMax, (int)floor((NK - 1.001) * NRadSubSteps));
+      int nCells = std::max(1, iMax - iMin);
+      double db = 1. / NRadSubSteps;
+
+      RadiativeCDF &table = (*tables)[branch * (NP - 1) + n_p];
+      table.b_min = iMin * db;
+      table.pdf.resize(nCells + 1);
+      table.cdf.resize(nCells + 1);
+
+      auto density = [&](double b) {
+        if (b < bMin - 1e-6 || b > bMax + 1e-6)
+          return 0.;
+        double dkdb;
+        double k = kFromIndex(u, b, dkdb);
+        return std::max(0., function(u, k, process[branch]) * dkdb);
+      };
+
+      for (int i = 0; i <= nCells; i++)
+        table.pdf[i] = density(table.b_min + i * db);
+
+      // Simpson's rule for the cell contents, the rates are steep near k = 0
+      table.cdf[0] = 0.;
+      for (int i = 0; i < nCells; i++) {
+        double mid = density(table.b_min + (i + 0.5) * db);
+        table.cdf[i + 1] =
+            table.cdf[i] + (table.pdf[i] + 4. * mid + table.pdf[i + 1]) * db / 6.;
+      }
+    }
+  }
+
+  radiativeCDF = tables;
+}
+
 void Martini::readElasticRateOmega() {
   ifstream fin;
   string filename[2];
@@ -2909,27 +2476,9 @@ double Martini::getRate_qqgamma(double p, double k) {
   return use_table(p, k, Gam.qqgamma, 3);
 }
 
-double Martini::use_table(double p, double k, double dGamma[NP][NK],
-                          int which_kind)
-/* Uses the lookup table and simple interpolation to get the value
-   of dGamma/dkdx at some value of p,k.
-   This works by inverting the relations between (p,k) and (n_p,n_k)
-   used in building the table, to find out what continuous values
-   of n_p, n_k should be considered; then linearly interpolates.     */
-{
-  double a, b, result; // fraction of way from corner of box
-  int n_p, n_k;        // location of corner of box
-
-  // out of range
-  if ((p < 4.01) || (p > 46000.) || (k < -12.) || (k > p + 12.))
-    return 0.;
-
-  if ((which_kind % 3) && (k > p / 2))
-    k = p - k; // Take advantage of symmetry in these cases
-
-  a = 24.7743737154026 * log(p * 0.2493765586034912718l);
-  n_p = (int)a;
-  a -= n_p;
+// continuous k index of radgamma at momentum p, and its inverse
+double Martini::kIndex(double p, double k) {
+  double b;
   if (k < 2.) {
     if (k < -1) {
       if (k < -2)
@@ -2960,6 +2509,71 @@ double Martini::use_table(double p, double k, double dGamma[NP][NK],
     }
   }
 
+  return b;
+}
+
+double Martini::kFromIndex(double p, double b, double &dkdb) {
+  if (b < 110.) {
+    if (b < 60.) {
+      if (b < 50.) {
+        dkdb = 0.2;
+        return (b - 60.) / 5.;
+      }
+      dkdb = 0.1;
+      return (b - 70.) / 10.;
+    }
+    if (b < 100.) {
+      dkdb = 0.05;
+      return (b - 80.) / 20.;
+    }
+    dkdb = 0.1;
+    return (b - 90.) / 10.;
+  } else if (b < 270.) {
+    double e = exp((190. - b) / 10.);
+    dkdb = (p - 4.) * 1.000670700260932956 * e / (10. * (1. + e) * (1. + e));
+    return 2. + (p - 4.) * (1.000670700260932956 / (1. + e) -
+                            0.0003353501304664781);
+  } else {
+    if (b < 320.) {
+      if (b < 280.) {
+        dkdb = 0.1;
+        return p + (b - 290.) / 10.;
+      }
+      dkdb = 0.05;
+      return p + (b - 300.) / 20.;
+    }
+    if (b < 330.) {
+      dkdb = 0.1;
+      return p + (b - 310.) / 10.;
+    }
+    dkdb = 0.2;
+    return p + (b - 320.) / 5.;
+  }
+}
+
+double Martini::use_table(double p, double k, double dGamma[NP][NK],
+                          int which_kind)
+/* Uses the lookup table and simple interpolation to get the value
+   of dGamma/dkdx at some value of p,k.
+   This works by inverting the relations between (p,k) and (n_p,n_k)
+   used in building the table, to find out what continuous values
+   of n_p, n_k should be considered; then linearly interpolates.     */
+{
+  double a, b, result; // fraction of way from corner of box
+  int n_p, n_k;        // location of corner of box
+
+  // out of range
+  if ((p < 4.01) || (p > 46000.) || (k < -12.) || (k > p + 12.))
+    return 0.;
+
+  if ((which_kind % 3) && (k > p / 2))
+    k = p - k; // Take advantage of symmetry in these cases
+
+  a = 24.7743737154026 * log(p * 0.2493765586034912718l);
+  n_p = (int)a;
+  a -= n_p;
+  b = kIndex(p, k);
+
   n_k = (int)b;
   b -= n_k;
   result = (1. - a) * ((1. - b) * dGamma[n_p][n_k] + b * dGamma[n_p][n_k + 1]) +
@@ -92,6 +92,12 @@ private:
   static constexpr double alphaMin = 0.15;
   static constexpr double alphaStep = 0.03;
 
+  // Elastic rate fits at the alpha_s nodes, and interpolated to elasticFitAlpha
+  static const int NalphasFit = 10;
+  static const double elasticFitCoefficients[3][2][NalphasFit][6];
+  double elasticFit[3][2][6];
+  double elasticFitAlpha;
+
   typedef struct {
     double ddf;
     double dda;
@@ -137,7 +143,22 @@ private:
   vector<double> *dGamma_qq_q;
   vector<double> *dGamma_qg_q;
 
-  static int pLabelNew;
+  // Inverse-CDF tables of the radiated momentum k/T, one per p node of
+  // radgamma and per sampling branch (process and sign of k). They are
+  // stored in the k index of radgamma, which resolves k ~ 0 and k ~ p.
+  // Copies made by Clone() share them.
+  static const int NRadBranches = 7;
+  static const int NRadSubSteps = 4;
+  struct RadiativeCDF {
+    double b_min; // cells are 1/NRadSubSteps wide in b
+    vector<double> pdf;
+    vector<double> cdf;
+  };
+  shared_ptr<const vector<RadiativeCDF>> radiativeCDF;
+
+  // Labels of new partons, a block of LabelsPerShower for every shower
+  static const int LabelsPerShower = 100000;
+  int pLabelNew;
 
   // Allows the registration of the module so that it is available to be used by the Jetscape framework.
   static RegisterJetScapeModule<Martini> reg;
@@ -150,6 +171,8 @@ public:
 
   //main//
   void Init();
+  bool SupportsParallelShowers() const { return true; }
+  void SetShowerIndex(int index);
   void DoEnergyLoss(double deltaT, double Time, double Q2, vector<Parton> &pIn,
                     vector<Parton> &pOut);
   int DetermineProcess(double p, double T, double deltaTRest, int id);
@@ -161,6 +184,8 @@ public:
   RateRadiative getRateRadNeg(double u, double T);
 
   double getNewMomentumRad(double p, double T, int process);
+  double sampleRadiativeRejection(double u, int process, int posNegSwitch);
+  double sampleRadiativeTable(double u, int process, int posNegSwitch);
   double area(double y, double u, int posNegSwitch, int process);
   double function(double u, double y, int process);
 
@@ -170,6 +195,8 @@ public:
   RateElastic getRateElasTotal(double p, double T);
   RateElastic getRateElasPos(double u, double T);
   RateElastic getRateElasNeg(double u, double T);
+  RateElastic getRateElasFit(int which, double u, double T);
+  void setElasticFits();
 
   RateConversion getRateConv(double p, double T);
 
@@ -189,7 +216,13 @@ public:
   double getThermal(double k_min, double T, int kind);
 
   //Rate table//
+  void loadRadiativeRate();
   void readRadiativeRate(Gamma_info *dat, dGammas *Gam);
+  void buildRadiativeSampler();
+  int radiativeBranch(int process, int posNegSwitch);
+  void radiativeSupport(int branch, double u, double &yMin, double &yMax);
+  static double kIndex(double p, double k);
+  static double kFromIndex(double p, double b, double &dkdb);
   void readElasticRateOmega();
   void readElasticRateQ();
 
@@ -204,12 +237,13 @@ public:
   double use_elastic_table_omega(double omega, int which_kind);
   double use_elastic_table_q(double u, double omega, int which_kind);
 
-  static void IncrementpLable() { pLabelNew++; }
+  void IncrementpLable() { pLabelNew++; }
 
 protected:
   uniform_real_distribution<double> ZeroOneDistribution;
 
   string PathToTables;
+  int tabulate_radiation; // sample k from inverse-CDF tables
 };
 
 double LambertW(double z);
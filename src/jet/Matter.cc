@@ -21,6 +21,12 @@
 #include <string>
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
 
 #include "FluidDynamics.h"
 #include <GTL/dfs.h>
@@ -90,7 +96,9 @@ Matter::Matter() {
   Q0 = 0.;
   T0 = 0.;
   iEvent = 0;
-  NUM1 = 0;
+  use_sudakov_tables = false;
+  sudakov_table_accuracy = 1e-3;
+  sudakov_table_t_max = 1e7;
 }
 
 Matter::~Matter() { VERBOSE(8); }
@@ -146,6 +154,19 @@ void Matter::Init() {
   brick_length = GetXMLElementDouble({"Eloss", "Matter", "brick_length"});
   vir_factor = GetXMLElementDouble({"Eloss", "Matter", "vir_factor"});
 
+  use_sudakov_tables =
+      GetXMLElementInt({"Eloss", "Matter", "sudakovTables"}, false);
+  if (use_sudakov_tables) {
+    sudakov_table_accuracy =
+        GetXMLElementDouble({"Eloss", "Matter", "sudakovTableAccuracy"});
+    sudakov_table_t_max =
+        GetXMLElementDouble({"Eloss", "Matter", "sudakovTableMaxT"});
+    tinyxml2::XMLElement *cacheElement =
+        GetXMLElement({"Eloss", "Matter", "sudakovTableCache"}, false);
+    if (cacheElement && cacheElement->GetText())
+      sudakov_table_cache = cacheElement->GetText();
+  }
+
   if (vir_factor < 0.0) {
     cout << "Reminder: negative vir_factor is set, initial energy will be used "
             "as initial t_max"
@@ -177,13 +198,18 @@ void Matter::Init() {
     flag_init = true;
   }
 
+  if (use_sudakov_tables) {
+    if (in_vac) {
+      InitSudakovTables();
+    } else {
+      JSWARN << "Matter: Sudakov tables are only used in vacuum (in_vac = 1), "
+                "integrating the Sudakov form factors directly";
+      use_sudakov_tables = false;
+    }
+  }
+
   // Initialize random number distribution
   ZeroOneDistribution = uniform_real_distribution<double>{0.0, 1.0};
-
-  //...initialize the random number generator
-  srand((unsigned)time(NULL));
-  NUM1 = -1 * rand();
-  //    NUM1=-33;
   iEvent = 0;
 }
 
@@ -237,7 +263,7 @@ void Matter::DoEnergyLoss(double deltaT, double time, double Q2,
   double ehat = 0;
   double ehat_over_T2 = 10.0;
 
-  std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+  FluidCellInfo check_fluid_info;
 
   VERBOSE(8) << MAGENTA << " the time in fm is " << time
              << " The time in GeV-1 is " << Time;
@@ -452,9 +478,9 @@ void Matter::DoEnergyLoss(double deltaT, double time, double Q2,
     if (!in_vac && now_R0 >= boostedTStart) {
       if (now_R0 * now_R0 < now_Rz * now_Rz)
         cout << "Warning 1: " << now_R0 << "  " << now_Rz << endl;
-      GetHydroCellSignal(now_R0, now_Rx, now_Ry, now_Rz, check_fluid_info_ptr);
-      //VERBOSE(8)<<MAGENTA<<"Temperature from medium = "<<check_fluid_info_ptr->temperature;
-      now_temp = check_fluid_info_ptr->temperature;
+      GetMediumCell(now_R0, now_Rx, now_Ry, now_Rz, check_fluid_info);
+      //VERBOSE(8)<<MAGENTA<<"Temperature from medium = "<<check_fluid_info.temperature;
+      now_temp = check_fluid_info.temperature;
       //JSINFO << BOLDYELLOW << "MATTER time = " << now_R0 << " x = " << now_Rx << " y = " << now_Ry << " z = " << now_Rz << " temp = " << now_temp;
       //JSINFO << BOLDYELLOW << "MATTER initVx, initVy, initVz =" << initVx << ", " << initVy << ", " << initVz;
       //JSINFO << BOLDYELLOW << "MATTER velocityMod=" << velocityMod;
@@ -756,16 +782,15 @@ void Matter::DoEnergyLoss(double deltaT, double time, double Q2,
             Dump_pIn_info(i, pIn);
             //exit(0);
           }
-          GetHydroCellSignal(el_time, el_rx, el_ry, el_rz,
-                             check_fluid_info_ptr);
+          GetMediumCell(el_time, el_rx, el_ry, el_rz, check_fluid_info);
           VERBOSE(8) << MAGENTA << "Temperature from medium = "
-                     << check_fluid_info_ptr->temperature;
+                     << check_fluid_info.temperature;
 
-          tempLoc = check_fluid_info_ptr->temperature;
-          sdLoc = check_fluid_info_ptr->entropy_density;
-          vxLoc = check_fluid_info_ptr->vx;
-          vyLoc = check_fluid_info_ptr->vy;
-          vzLoc = check_fluid_info_ptr->vz;
+          tempLoc = check_fluid_info.temperature;
+          sdLoc = check_fluid_info.entropy_density;
+          vxLoc = check_fluid_info.vx;
+          vyLoc = check_fluid_info.vy;
+          vzLoc = check_fluid_info.vz;
 
           vc0[1] = vxLoc;
           vc0[2] = vyLoc;
@@ -2485,6 +2510,205 @@ double Matter::generate_L(double form_time) {
   return (x);
 }
 
+// Prefactor of the exponent, only used to judge the table accuracy
+static double SudakovPrefactor(int kernel) {
+  switch (kernel) {
+  case Matter::SUD_GG:
+    return Ca / 2.0 / pi;
+  case Matter::SUD_QQ:
+  case Matter::SUD_QQ_M:
+    return Tf / 2.0 / pi;
+  case Matter::SUD_QG:
+  case Matter::SUD_QG_M:
+    return Cf / 2.0 / pi;
+  default:
+    return 1.0 / 2.0 / pi;
+  }
+}
+
+double Matter::SudakovLowerLimit(int kernel, double M, double t0) {
+  if (kernel == SUD_QQ_M)
+    return 2.0 * (t0 + M * M);
+  if (kernel == SUD_QG_M)
+    return t0 * (1.0 + std::sqrt(1.0 + 2.0 * M * M / t0));
+  return 2.0 * t0;
+}
+
+double Matter::SudakovIntegral(int kernel, double M, double t0, double h1,
+                               double h2, double loc, double E) {
+  switch (kernel) {
+  case SUD_GG:
+    return sud_val_GG(t0, h1, h2, loc, E);
+  case SUD_QQ:
+    return sud_val_QQ(t0, h1, h2, loc, E);
+  case SUD_QG:
+    return sud_val_QG(t0, h1, h2, loc, E);
+  case SUD_QP:
+    return sud_val_QP(t0, h1, h2, loc, E);
+  case SUD_QQ_M:
+    return sud_val_QQ_w_M_vac_only(M, t0, h1, h2, loc, E);
+  case SUD_QG_M:
+    return sud_val_QG_w_M(M, t0, h1, h2, loc, E);
+  }
+  throw std::runtime_error("Matter: unknown Sudakov kernel");
+}
+
+// Exponent of the Sudakov form factor from its lower limit up to t,
+// interpolated from the tables when possible
+double Matter::SudakovExponent(int kernel, double M, double t0, double t,
+                               double loc, double E) {
+  if (use_sudakov_tables) {
+    for (auto &table : sudakov_tables) {
+      if (table.kernel != kernel || table.M != M || table.t0 != t0)
+        continue;
+      double u = (std::log(t) - table.log_t_min) / table.dlog_t;
+      if (u >= 0.0 && u < table.value.size() - 1) {
+        int k = int(u);
+        double f = u - k;
+        return (1.0 - f) * table.value[k] + f * table.value[k + 1];
+      }
+      break;
+    }
+  }
+  return SudakovIntegral(kernel, M, t0, SudakovLowerLimit(kernel, M, t0), t,
+                         loc, E);
+}
+
+// Fills the table on a grid uniform in log(t), doubling the density until
+// the interpolated Sudakov agrees with the direct integration to within
+// sudakov_table_accuracy (relative) at all midpoints
+void Matter::BuildSudakovTable(SudakovTable &table) {
+  double t_min = SudakovLowerLimit(table.kernel, table.M, table.t0);
+  double prefactor = SudakovPrefactor(table.kernel);
+  // in vacuum the integrands depend neither on the position nor the energy
+  double loc = 0.0, E = 1.0;
+
+  for (int per_decade = 16;; per_decade *= 2) {
+    int n = int(std::ceil(std::log10(sudakov_table_t_max / t_min) *
+                          per_decade)) + 1;
+    table.log_t_min = std::log(t_min);
+    table.dlog_t = std::log(sudakov_table_t_max / t_min) / (n - 1);
+    table.value.assign(n, 0.0);
+    for (int k = 1; k < n; k++) {
+      table.value[k] =
+          table.value[k - 1] +
+          SudakovIntegral(table.kernel, table.M, table.t0,
+                          std::exp(table.log_t_min + (k - 1) * table.dlog_t),
+                          std::exp(table.log_t_min + k * table.dlog_t), loc,
+                          E);
+    }
+
+    double max_error = 0.0;
+    for (int k = 0; k + 1 < n && max_error <= sudakov_table_accuracy; k++) {
+      double t_mid = std::exp(table.log_t_min + (k + 0.5) * table.dlog_t);
+      double direct = SudakovIntegral(table.kernel, table.M, table.t0, t_min,
+                                      t_mid, loc, E);
+      double tabulated = 0.5 * (table.value[k] + table.value[k + 1]);
+      max_error = std::max(max_error, prefactor * std::abs(tabulated - direct));
+    }
+    if (max_error <= sudakov_table_accuracy)
+      break;
+    if (per_decade >= 1024) {
+      JSWARN << "Matter: Sudakov table " << table.kernel << " (M = " << table.M
+             << ") reaches only a relative accuracy of " << max_error;
+      break;
+    }
+  }
+}
+
+void Matter::InitSudakovTables() {
+  double t0 = QS * QS / 2.0;
+  double M_charm = PythiaFunction.particleData.m0(cid);
+  double M_bottom = PythiaFunction.particleData.m0(bid);
+
+  sudakov_tables.clear();
+  int kernels[] = {SUD_GG, SUD_QQ, SUD_QG, SUD_QP};
+  for (int kernel : kernels) {
+    sudakov_tables.push_back({kernel, 0.0, t0, 0.0, 0.0, {}});
+  }
+  for (double M : {M_charm, M_bottom}) {
+    sudakov_tables.push_back({SUD_QQ_M, M, t0, 0.0, 0.0, {}});
+    sudakov_tables.push_back({SUD_QG_M, M, t0, 0.0, 0.0, {}});
+  }
+
+  // Everything the tables depend on; a cached file is only used if its
+  // key matches exactly
+  std::ostringstream key;
+  key << std::setprecision(17) << "MatterSudakovTables v1 t0=" << t0
+      << " tMax=" << sudakov_table_t_max
+      << " accuracy=" << sudakov_table_accuracy << " Mc=" << M_charm
+      << " Mb=" << M_bottom << " LambdaQCD=" << Lambda_QCD << " nf=" << nf
+      << " approx=" << approx << " error=" << error;
+
+  std::string file_name;
+  size_t first = sudakov_table_cache.find_first_not_of(" \t\n");
+  if (first != std::string::npos) {
+    size_t last = sudakov_table_cache.find_last_not_of(" \t\n");
+    std::ostringstream name;
+    name << sudakov_table_cache.substr(first, last - first + 1)
+         << "/MatterSudakov_" << std::hex
+         << std::hash<std::string>()(key.str()) << ".dat";
+    file_name = name.str();
+    if (ReadSudakovTables(file_name, key.str())) {
+      JSINFO << "Matter: read vacuum Sudakov tables from " << file_name;
+      return;
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto &table : sudakov_tables) {
+    BuildSudakovTable(table);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  JSINFO << "Matter: built vacuum Sudakov tables in " << elapsed.count()
+         << " s";
+
+  if (!file_name.empty())
+    WriteSudakovTables(file_name, key.str());
+}
+
+bool Matter::ReadSudakovTables(std::string file_name, std::string key) {
+  std::ifstream in(file_name.c_str());
+  std::string line;
+  if (!in.is_open() || !std::getline(in, line) || line != key)
+    return false;
+
+  for (auto &table : sudakov_tables) {
+    int kernel, n;
+    double M, t0;
+    in >> kernel >> M >> t0 >> table.log_t_min >> table.dlog_t >> n;
+    if (!in || kernel != table.kernel || n < 2)
+      return false;
+    table.value.resize(n);
+    for (int k = 0; k < n; k++)
+      in >> table.value[k];
+  }
+  return bool(in);
+}
+
+// Written to a temporary file first, so that several processes starting
+// at the same time never see a partial table
+void Matter::WriteSudakovTables(std::string file_name, std::string key) {
+  std::string tmp_name = file_name + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmp_name.c_str());
+  out << key << "\n" << std::setprecision(17);
+  for (auto &table : sudakov_tables) {
+    out << table.kernel << " " << table.M << " " << table.t0 << " "
+        << table.log_t_min << " " << table.dlog_t << " "
+        << table.value.size() << "\n";
+    for (double v : table.value)
+      out << v << "\n";
+  }
+  out.close();
+  if (!out || std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+    JSWARN << "Matter: could not write Sudakov table cache " << file_name;
+    std::remove(tmp_name.c_str());
+    return;
+  }
+  JSINFO << "Matter: wrote vacuum Sudakov tables to " << file_name;
+}
+
 double Matter::sudakov_Pgg(double g0, double g1, double loc_c, double E) {
   double sud, g;
   int blurb;
@@ -2505,7 +2729,8 @@ double Matter::sudakov_Pgg(double g0, double g1, double loc_c, double E) {
 
   if (g1 > g) {
 
-    sud = exp(-1.0 * (Ca / 2.0 / pi) * sud_val_GG(g0, g, g1, loc_c, E));
+    sud = exp(-1.0 * (Ca / 2.0 / pi) *
+              SudakovExponent(SUD_GG, 0.0, g0, g1, loc_c, E));
   }
   return (sud);
 }
@@ -2716,7 +2941,8 @@ double Matter::sudakov_Pqq(double q0, double q1, double loc_c, double E) {
 
   //	g = g0 ;
 
-  sud = exp(-1.0 * (Tf / 2.0 / pi) * sud_val_QQ(q0, q, q1, loc_c, E));
+  sud = exp(-1.0 * (Tf / 2.0 / pi) *
+            SudakovExponent(SUD_QQ, 0.0, q0, q1, loc_c, E));
 
   return (sud);
 }
@@ -2735,7 +2961,7 @@ double Matter::sudakov_Pqq_w_M_vac_only(double M, double q0, double q1,
   } else {
     q = 2.0 * (q0 + M * M);
     sud = exp(-1.0 * (Tf / 2.0 / pi) *
-              sud_val_QQ_w_M_vac_only(M, q0, q, q1, loc_c, E));
+              SudakovExponent(SUD_QQ_M, M, q0, q1, loc_c, E));
     return (sud);
   }
 }
@@ -3022,7 +3248,7 @@ double Matter::sudakov_Pqp(double g0, double g1, double loc_c, double E) {
   }
   g = 2.0 * g0;
 
-  double logsud = sud_val_QP(g0, g, g1, loc_c, E);
+  double logsud = SudakovExponent(SUD_QP, 0.0, g0, g1, loc_c, E);
 
   sud = exp((-1.0 / 2.0 / pi) * logsud);
 
@@ -3235,7 +3461,8 @@ double Matter::sudakov_Pqg(double g0, double g1, double loc_c, double E) {
   }
   g = 2.0 * g0;
 
-  sud = exp(-1.0 * (Cf / 2.0 / pi) * sud_val_QG(g0, g, g1, loc_c, E));
+  sud = exp(-1.0 * (Cf / 2.0 / pi) *
+            SudakovExponent(SUD_QG, 0.0, g0, g1, loc_c, E));
 
   return (sud);
 }
@@ -3259,7 +3486,8 @@ double Matter::sudakov_Pqg_w_M(double M, double g0, double g1, double loc_c,
   }
   g = g0 * (1.0 + std::sqrt(1.0 + 2.0 * M * M / g0));
 
-  sud = exp(-1.0 * (Cf / 2.0 / pi) * sud_val_QG_w_M(M, g0, g, g1, loc_c, E));
+  sud = exp(-1.0 * (Cf / 2.0 / pi) *
+            SudakovExponent(SUD_QG_M, M, g0, g1, loc_c, E));
 
   return (sud);
 }
@@ -3782,7 +4010,7 @@ double Matter::fillQhatTab(double y) {
 
   double tStep = 0.1;
 
-  std::unique_ptr<FluidCellInfo> check_fluid_info_ptr;
+  FluidCellInfo check_fluid_info;
 
   for (int i = 0; i < dimQhatTab; i++) {
     tLoc = tStep * i;
@@ -3828,15 +4056,15 @@ double Matter::fillQhatTab(double y) {
                                                 //exit(0);
     }
 
-    GetHydroCellSignal(tLoc, xLoc, yLoc, zLoc, check_fluid_info_ptr);
+    GetMediumCell(tLoc, xLoc, yLoc, zLoc, check_fluid_info);
     VERBOSE(8) << MAGENTA << "Temperature from medium = "
-               << check_fluid_info_ptr->temperature;
+               << check_fluid_info.temperature;
 
-    tempLoc = check_fluid_info_ptr->temperature;
-    sdLoc = check_fluid_info_ptr->entropy_density;
-    vxLoc = check_fluid_info_ptr->vx;
-    vyLoc = check_fluid_info_ptr->vy;
-    vzLoc = check_fluid_info_ptr->vz;
+    tempLoc = check_fluid_info.temperature;
+    sdLoc = check_fluid_info.entropy_density;
+    vxLoc = check_fluid_info.vx;
+    vyLoc = check_fluid_info.vy;
+    vzLoc = check_fluid_info.vz;
 
     hydro_ctl = 0;
 
@@ -4204,7 +4432,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     double R3 = 6.0 * 6 * 4 / 9; // gq->gq or gqbar->gqbar flavor*DOF_q*factor
     double R0 = R1 + R3;
 
-    double a = ran0(&NUM1);
+    double a = ZeroOneDistribution(*GetMt19937Generator());
 
     if (a <= R1 / R0) { // gg->gg
       CT = 1;
@@ -4221,7 +4449,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
       anti_color3 = max_color;
     } else { // gq->gq
       CT = 3;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ZeroOneDistribution(*GetMt19937Generator()) * 6 + 1);
       if (b == 7)
         b = 6;
       KATT3 = vb[b];
@@ -4250,7 +4478,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     double R2 = 16.0;            // Qg->Qg DOF_ag
     double R00 = R1 + R2;
 
-    double a = ran0(&NUM1);
+    double a = ZeroOneDistribution(*GetMt19937Generator());
 
     if (a <= R2 / R00) { // Qg->Qg
       CT = 12;
@@ -4277,7 +4505,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
       }
     } else { // Qq->Qq
       CT = 11;
-      b = floor(ran0(&NUM1) * 6 + 1);
+      b = floor(ZeroOneDistribution(*GetMt19937Generator()) * 6 + 1);
       if (b == 7)
         b = 6;
       KATT3 = vb[b];
@@ -4327,7 +4555,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     double R8 = 0.0;             // qqbar->gg don't consider in MATTER
     double R00 = R3 + R4 + R5 + R7;
 
-    double a = ran0(&NUM1);
+    double a = ZeroOneDistribution(*GetMt19937Generator());
     if (a <= R3 / R00) { // qg->qg
       CT = 13;
       KATT3 = 21;
@@ -4355,7 +4583,7 @@ void Matter::flavor(int &CT, int &KATT0, int &KATT2, int &KATT3,
     } else if (a <= (R3 + R4) / R00) { // qq'->qq'
       CT = 4;
       do {
-        b = floor(ran0(&NUM1) * 6 + 1);
+        b = floor(ZeroOneDistribution(*GetMt19937Generator()) * 6 + 1);
         if (b == 7)
           b = 6;
         KATT3 = vb[b];
@@ -4530,9 +4758,9 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
          flag2 = 1;
          break;
       }
-      xw = 15.0 * ran0(&NUM1);
-      razim = 2.0 * pi * ran0(&NUM1);
-      rcos = 1.0 - 2.0 * ran0(&NUM1);
+      xw = 15.0 * ZeroOneDistribution(*GetMt19937Generator());
+      razim = 2.0 * pi * ZeroOneDistribution(*GetMt19937Generator());
+      rcos = 1.0 - 2.0 * ZeroOneDistribution(*GetMt19937Generator());
       rsin = sqrt(1.0 - rcos * rcos);
       //
       p2[0] = xw * temp;
@@ -4554,7 +4782,7 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
 
       //    use (s^2+u^2)/(t+qhat0ud)^2 as scattering cross section in the
       //
-      rant = ran0(&NUM1);
+      rant = ZeroOneDistribution(*GetMt19937Generator());
       tt = rant * ss;
 
       //		ic+=1;
@@ -4698,7 +4926,7 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
             (mmax + 4.0);
     }
 
-    rank = ran0(&NUM1);
+    rank = ZeroOneDistribution(*GetMt19937Generator());
   } while (rank > (msq * ff));
 
   if(flag1 == 1 || flag2 == 1){ // scatterings cannot be properly sampled
@@ -4740,7 +4968,7 @@ void Matter::colljet22(int CT, double temp, double qhat0ud, double v0[4],
   //    sample transverse momentum transfer with respect to jet momentum
   //    in cm frame
   //
-  double ranp = 2.0 * pi * ran0(&NUM1);
+  double ranp = 2.0 * pi * ZeroOneDistribution(*GetMt19937Generator());
   //
   //    transverse momentum transfer
   //
@@ -4902,7 +5130,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       flag1 = 1;
       break;
     }
-    xw = max_e2 * ran0(&NUM1);
+    xw = max_e2 * ZeroOneDistribution(*GetMt19937Generator());
     index_e2 = (int)((xw - min_e2) / bin_e2);
     if (index_e2 >= N_e2)
       index_e2 = N_e2 - 1;
@@ -4916,7 +5144,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       cout << "Wrong HQ channel ID" << endl;
       exit(EXIT_FAILURE);
     }
-  } while (ran0(&NUM1) > ff);
+  } while (ZeroOneDistribution(*GetMt19937Generator()) > ff);
 
   e2 = xw * temp;
   e1 = p0[0];
@@ -4931,9 +5159,9 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       break;
     }
 
-    theta2 = pi * ran0(&NUM1);
-    theta4 = pi * ran0(&NUM1);
-    phi24 = 2.0 * pi * ran0(&NUM1);
+    theta2 = pi * ZeroOneDistribution(*GetMt19937Generator());
+    theta4 = pi * ZeroOneDistribution(*GetMt19937Generator());
+    phi24 = 2.0 * pi * ZeroOneDistribution(*GetMt19937Generator());
 
     cosTheta24 =
         sin(theta2) * sin(theta4) * cos(phi24) + cos(theta2) * cos(theta4);
@@ -4948,7 +5176,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
 
     // re-sample if the kinematic cuts are not satisfied
     if (ss <= 2.0 * qhat0ud || tt >= -qhat0ud || uu >= -qhat0ud) {
-      rank = ran0(&NUM1);
+      rank = ZeroOneDistribution(*GetMt19937Generator());
       sigFactor = 0.0;
       msq = 0.0;
       continue;
@@ -4968,7 +5196,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
       msq = Mgc2gc(ss, tt, HQmass) / maxValue;
     }
 
-    rank = ran0(&NUM1);
+    rank = ZeroOneDistribution(*GetMt19937Generator());
 
   } while (rank > (msq * sigFactor));
 
@@ -4989,7 +5217,7 @@ void Matter::collHQ22(int CT, double temp, double qhat0ud, double v0[4],
     p2[0] = e4;
 
     // rotate randomly in xy plane (jet is in z), because p3 is assigned in xz plane with bias
-    double th_rotate = 2.0 * pi * ran0(&NUM1);
+    double th_rotate = 2.0 * pi * ZeroOneDistribution(*GetMt19937Generator());
     double p3x_rotate = p3[1] * cos(th_rotate) - p3[2] * sin(th_rotate);
     double p3y_rotate = p3[1] * sin(th_rotate) + p3[2] * cos(th_rotate);
     double p2x_rotate = p2[1] * cos(th_rotate) - p2[2] * sin(th_rotate);
@@ -5145,65 +5373,6 @@ void Matter::rotate(double px, double py, double pz, double pr[4], int icc) {
   //  pr[0]=sqrt(pr[1]*pr[1]+pr[2]*pr[2]+pr[3]*pr[3]);
 }
 
-float Matter::ran0(long *idum)
-
-{
-  const int IM1 = 2147483563;
-  const int IM2 = 2147483399;
-  const double AM = (1.0 / IM1);
-  const int IMM1 = (IM1 - 1);
-  const int IA1 = 40014;
-  const int IA2 = 40692;
-  const int IQ1 = 53668;
-  const int IQ2 = 52774;
-  const int IR1 = 12211;
-  const int IR2 = 3791;
-  const int NTAB = 32;
-  const int NDIV = (1 + IMM1 / NTAB);
-  const double EPS = 1.2e-7;
-  const double RNMX = (1.0 - EPS);
-
-  int j;
-  long k;
-  static long idum2 = 123456789;
-  static long iy = 0;
-  static long iv[NTAB];
-  float temp;
-
-  if (*idum <= 0) {
-    if (-(*idum) < 1)
-      *idum = 1;
-    else
-      *idum = -(*idum);
-    for (j = NTAB + 7; j >= 0; j--) {
-      k = (*idum) / IQ1;
-      *idum = IA1 * (*idum - k * IQ1) - k * IR1;
-      if (*idum < 0)
-        *idum += IM1;
-      if (j < NTAB)
-        iv[j] = *idum;
-    }
-    iy = iv[0];
-  }
-  k = (*idum) / IQ1;
-  *idum = IA1 * (*idum - k * IQ1) - k * IR1;
-  if (*idum < 0)
-    *idum += IM1;
-  k = idum2 / IQ2;
-  idum2 = IA2 * (idum2 - k * IQ2) - k * IR2;
-  if (idum2 < 0)
-    idum2 += IM2;
-  j = iy / NDIV;
-  iy = iv[j] - idum2;
-  iv[j] = *idum;
-  if (iy < 1)
-    iy += IMM1;
-  if ((temp = AM * iy) > RNMX)
-    return RNMX;
-  else
-    return temp;
-}
-
 //////////////////////////////////////////////////////////////////////////////////////
 
 double Matter::solve_alphas(double var_qhat, double var_ener, double var_temp) {
@@ -29,6 +29,7 @@ public:
   virtual ~Matter();
 
   void Init();
+  bool SupportsParallelShowers() const { return true; }
   //void Exec();
   //void DoEnergyLoss(double deltaT, double Q2, const vector<Parton>& pIn, vector<Parton>& pOut);
   void DoEnergyLoss(double deltaT, double time, double Q2, vector<Parton> &pIn,
@@ -76,6 +77,31 @@ public:
   double P_z_qq_int_w_M_vac_only(double M, double cg, double cg1, double loc_e,
                                  double cg3, double l_fac, double E2);
 
+  // Vacuum Sudakov tables. In vacuum the exponents depend only on t0 and t
+  // (and the mass), so with sudakovTables on they are tabulated at Init()
+  // and interpolated instead of being integrated for every emission.
+  enum SudakovKernel { SUD_GG, SUD_QQ, SUD_QG, SUD_QP, SUD_QQ_M, SUD_QG_M };
+  struct SudakovTable {
+    int kernel;
+    double M, t0;
+    double log_t_min, dlog_t;
+    std::vector<double> value; // integral from the lower limit up to t
+  };
+  double SudakovLowerLimit(int kernel, double M, double t0);
+  double SudakovIntegral(int kernel, double M, double t0, double h1, double h2,
+                         double loc, double E);
+  double SudakovExponent(int kernel, double M, double t0, double t,
+                         double loc, double E);
+  void InitSudakovTables();
+  void BuildSudakovTable(SudakovTable &table);
+  bool ReadSudakovTables(std::string file_name, std::string key);
+  void WriteSudakovTables(std::string file_name, std::string key);
+
+  bool use_sudakov_tables;
+  double sudakov_table_accuracy, sudakov_table_t_max;
+  std::string sudakov_table_cache;
+  std::vector<SudakovTable> sudakov_tables;
+
   //  void shower_vac( int line, int pid, double nu_in, double t0_in, double t_in, double kx, double ky, double loc, bool is_lead);
   double generate_vac_t(int p_id, double nu, double t0, double t, double loc_a,
                         int isp);
@@ -119,7 +145,6 @@ public:
   double tStart;// = 0.6;
   int iEvent;
   bool debug_flag = 0;
-  long NUM1;
 
   // Variables for HQ 2->2
   static const int N_p1 = 500;
@@ -168,7 +193,6 @@ public:
   void trans(double v[4], double p[4]);
   void transback(double v[4], double p[4]);
   void rotate(double px, double py, double pz, double pr[4], int icc);
-  float ran0(long *idum);
   double solve_alphas(double var_qhat, double var_ener, double var_temp);
   double fnc0_alphas(double var_alphas, double var_qhat, double var_ener,
                      double var_temp);
@@ -37,6 +37,7 @@ CausalLiquefier::CausalLiquefier(){
     Init();// Get values of parameters from XML
     c_diff = sqrt(d_diff/time_relax);
     gamma_relax = 0.5/time_relax;
+    set_droplet_grid(dtau, tau_delay+0.5*dtau, 0.5);
     if( c_diff > 1.0 ){
         JSWARN << "Bad Signal Velocity in CausalLiquefier";
     }
@@ -61,6 +62,7 @@ CausalLiquefier::CausalLiquefier(double dtau_in, double dx_in, double dy_in, dou
     
     c_diff = sqrt(d_diff/time_relax);
     gamma_relax = 0.5/time_relax;
+    set_droplet_grid(dtau, tau_delay+0.5*dtau, 0.5);
 
     JSINFO
     << "<CausalLiquefier> Fluid Time Step and Cell Size: dtau="
@@ -153,7 +155,15 @@ void CausalLiquefier::smearing_kernel(
     
 }
 
-    
+
+// The source is deposited in the one time step containing
+// tau_drop + tau_delay, see smearing_kernel
+void CausalLiquefier::kernel_delay_range(Jetscape::real &delay_min,
+                                         Jetscape::real &delay_max) const {
+    delay_min = tau_delay - 0.5*dtau;
+    delay_max = tau_delay + 0.5*dtau;
+}
+
 //Charge density rho in causal diffusion
 double CausalLiquefier::kernel_rho(double t, double r) const {
     return dumping(t)*(rho_smooth(t, r)+rho_delta(t, r));
@@ -57,6 +57,9 @@ class CausalLiquefier: public Jetscape::LiquefierBase {
                          Jetscape::real y, Jetscape::real eta,
                          const Droplet drop_i,
                          std::array<Jetscape::real, 4> &jmu) const;
+
+    void kernel_delay_range(Jetscape::real &delay_min,
+                            Jetscape::real &delay_max) const;
     
     double dumping(double t) const;
 
@@ -62,7 +62,7 @@ void FreestreamMilneWrapper::EvolvePreequilibrium() {
   VERBOSE(8);
   JSINFO << "Initialize energy density profile in freestream-milne ...";
   // grab initial energy density from vector from initial state module
-  std::vector<double> entropy_density =
+  const std::vector<double> &entropy_density =
       ini->GetEntropyDensityDistribution(); //note that this is the energy density when read by freestream-milne, not actually the entropy density!
   std::vector<float> entropy_density_float(entropy_density.begin(),
                                            entropy_density.end());
@@ -40,7 +40,7 @@ void Glasma::EvolvePreequilibrium() {
     const double norm = 0.235;
     std::ifstream IPGFile(IPGlasmaFileName.c_str());
     if (!IPGFile.good()) {
-        Jetscape::JSWARN << "Can not open " << IPGlasmaFileName;
+        JSWARN << "Can not open " << IPGlasmaFileName;
         exit(1);
     }
     std::string tempString;
@@ -32,7 +32,8 @@ NullPreDynamics::NullPreDynamics() {
 void NullPreDynamics::EvolvePreequilibrium() {
   VERBOSE(2) << "Initialize energy density profile in NullPreDynamics ...";
   // grab initial energy density from vector from initial state module
-  std::vector<double> energy_density = ini->GetEntropyDensityDistribution();
+  const std::vector<double> &energy_density =
+      ini->GetEntropyDensityDistribution();
   preequilibrium_status_ = INIT;
   if (preequilibrium_status_ == INIT) {
     VERBOSE(2) << "running NullPreDynamics ...";
@@ -24,6 +24,7 @@ template <class T> JetScapeReader<T>::JetScapeReader():
   , sigmaErr{-1}
   , eventWeight{-1}
   , EventPlaneAngle{0.0}
+  , binaryFormat{false}
 {
   VERBOSE(8);
 }
@@ -41,6 +42,8 @@ template <class T> void JetScapeReader<T>::Clear() {
   sigmaErr = -1;
   eventWeight = -1;
   EventPlaneAngle = 0.0;
+  header = JetScapeEventHeader();
+  nodeById.clear();
 }
 
 template <class T> void JetScapeReader<T>::AddNode(string s) {
@@ -103,6 +106,11 @@ template <class T> void JetScapeReader<T>::AddHadron(string s) {
 }
 
 template <class T> void JetScapeReader<T>::Next() {
+  if (binaryFormat) {
+    NextBinary();
+    return;
+  }
+
   if (currentEvent > 0)
     Clear();
 
@@ -128,6 +136,7 @@ template <class T> void JetScapeReader<T>::Next() {
         std::stringstream data(line);
         std::string dummy;
         data >> dummy >> dummy >> sigmaGen;
+        header.SetSigmaGen(sigmaGen);
         JSDEBUG << " sigma gen=" << sigmaGen;
       }
       // Cross section error
@@ -135,6 +144,7 @@ template <class T> void JetScapeReader<T>::Next() {
         std::stringstream data(line);
         std::string dummy;
         data >> dummy >> dummy >> sigmaErr;
+        header.SetSigmaErr(sigmaErr);
         JSDEBUG << " sigma err=" << sigmaErr;
       }
       // Event weight
@@ -142,6 +152,7 @@ template <class T> void JetScapeReader<T>::Next() {
         std::stringstream data(line);
         std::string dummy;
         data >> dummy >> dummy >> eventWeight;
+        header.SetEventWeight(eventWeight);
         JSDEBUG << " Event weight=" << eventWeight;
       }
       // EP angle
@@ -149,6 +160,7 @@ template <class T> void JetScapeReader<T>::Next() {
         std::stringstream data(line);
         std::string dummy;
         data >> dummy >> dummy >> EventPlaneAngle;
+        header.SetEventPlaneAngle(EventPlaneAngle);
         JSDEBUG << " EventPlaneAngle=" << EventPlaneAngle;
       }
       continue;
@@ -201,6 +213,97 @@ template <class T> void JetScapeReader<T>::Next() {
     currentEvent++;
 }
 
+template <class T> bool JetScapeReader<T>::ReadRecord(uint8_t &type) {
+  uint32_t length = 0;
+  if (!inFile.read(reinterpret_cast<char *>(&type), sizeof(type)))
+    return false;
+  if (!inFile.read(reinterpret_cast<char *>(&length), sizeof(length)))
+    throw std::runtime_error("JetScapeReader: truncated binary record");
+  recordBuffer.resize(length);
+  if (length > 0 && !inFile.read(&recordBuffer[0], length))
+    throw std::runtime_error("JetScapeReader: truncated binary record");
+  return true;
+}
+
+template <class T> void JetScapeReader<T>::NextBinary() {
+  Clear();
+
+  JSINFO << "Current Event = " << currentEvent;
+
+  uint8_t type;
+  while (ReadRecord(type)) {
+    BinaryFormat::Unpacker data(recordBuffer);
+
+    if (type == BinaryFormat::EventHeaderRecord) {
+      currentEvent = data.Get<int32_t>() + 1;
+      header.SetSigmaGen(data.Get<double>());
+      header.SetSigmaErr(data.Get<double>());
+      header.SetPtHat(data.Get<double>());
+      header.SetEventWeight(data.Get<double>());
+      header.SetNpart(data.Get<double>());
+      header.SetNcoll(data.Get<double>());
+      header.SetTotalEntropy(data.Get<double>());
+      header.SetEventPlaneAngle(data.Get<double>());
+
+      sigmaGen = header.GetSigmaGen();
+      sigmaErr = header.GetSigmaErr();
+      eventWeight = header.GetEventWeight();
+      // Same convention as the ASCII reader, which never sees unset angles
+      if (header.GetEventPlaneAngle() > -999)
+        EventPlaneAngle = header.GetEventPlaneAngle();
+    } else if (type == BinaryFormat::PartonShowerRecord) {
+      pShowers.push_back(make_shared<PartonShower>());
+      pShower = pShowers.back();
+      nodeById.clear();
+    } else if (type == BinaryFormat::VertexRecord) {
+      int id = data.Get<int32_t>();
+      double x = data.Get<double>();
+      double y = data.Get<double>();
+      double z = data.Get<double>();
+      double t = data.Get<double>();
+      nodeById[id] = pShower->new_vertex(make_shared<Vertex>(x, y, z, t));
+    } else if (type == BinaryFormat::PartonRecord) {
+      int source = data.Get<int32_t>();
+      int target = data.Get<int32_t>();
+      int label = data.Get<int32_t>();
+      int pid = data.Get<int32_t>();
+      int stat = data.Get<int32_t>();
+      double p[4], x[4];
+      for (int i = 0; i < 4; i++)
+        p[i] = data.Get<double>();
+      for (int i = 0; i < 4; i++)
+        x[i] = data.Get<double>();
+      if (!nodeById.count(source) || !nodeById.count(target)) {
+        JSWARN << "Parton refers to an unknown vertex, can not add it!";
+        continue;
+      }
+      pShower->new_parton(nodeById[source], nodeById[target],
+                          make_shared<Parton>(label, pid, stat,
+                                              FourVector(p[0], p[1], p[2], p[3]),
+                                              FourVector(x[0], x[1], x[2], x[3])));
+    } else if (type == BinaryFormat::HadronRecord) {
+      int label = data.Get<int32_t>();
+      int pid = data.Get<int32_t>();
+      int stat = data.Get<int32_t>();
+      double p[4], x[4];
+      for (int i = 0; i < 4; i++)
+        p[i] = data.Get<double>();
+      for (int i = 0; i < 4; i++)
+        x[i] = data.Get<double>();
+      double mass = data.Get<double>();
+      hadrons.push_back(make_shared<Hadron>(
+          label, pid, stat, FourVector(p[0], p[1], p[2], p[3]),
+          FourVector(x[0], x[1], x[2], x[3]), mass));
+    } else if (type == BinaryFormat::EventEndRecord) {
+      // Sets eof if this was the last event, so Finished() works as for ASCII
+      inFile.peek();
+      return;
+    } else {
+      VERBOSE(2) << "Skipping unknown binary record type " << (int)type;
+    }
+  }
+}
+
 template <class T>
 vector<fjcore::PseudoJet> JetScapeReader<T>::GetHadronsForFastJet() {
   vector<fjcore::PseudoJet> forFJ;
@@ -225,6 +328,32 @@ template <class T> void JetScapeReader<T>::Init() {
     JSINFO << "File opened";
 
   currentEvent = 0;
+
+  // ASCII files start with an event number, binary ones with a magic
+  // byte that can not start a text file. Only peeking keeps fifos working.
+  if (inFile.peek() == (unsigned char)BinaryFormat::Magic[0]) {
+    char magic[sizeof(BinaryFormat::Magic)];
+    uint32_t version = 0, endianMarker = 0;
+    inFile.read(magic, sizeof(magic));
+    inFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+    inFile.read(reinterpret_cast<char *>(&endianMarker), sizeof(endianMarker));
+    if (!inFile.good() ||
+        std::memcmp(magic, BinaryFormat::Magic, sizeof(magic)) != 0) {
+      JSWARN << "Corrupt binary input file!";
+      exit(-1);
+    }
+    if (endianMarker != BinaryFormat::EndianMarker) {
+      JSWARN << "Binary input file was written with a different byte order!";
+      exit(-1);
+    }
+    if (version > BinaryFormat::Version) {
+      JSWARN << "Binary input file version " << version
+             << " is newer than this reader (" << BinaryFormat::Version << ")";
+      exit(-1);
+    }
+    binaryFormat = true;
+    JSINFO << "Binary format, version " << version;
+  }
 }
 
 template class JetScapeReader<ifstream>;
@@ -24,7 +24,10 @@
 #include "JetScapeLogger.h"
 #include "StringTokenizer.h"
 #include "PartonShower.h"
+#include "JetScapeEventHeader.h"
+#include "JetScapeBinaryFormat.h"
 #include <fstream>
+#include <map>
 #ifdef USE_GZIP
 #include "gzstream.h"
 #endif
@@ -36,6 +39,11 @@ using std::ifstream;
 
 namespace Jetscape {
 
+/**
+   Reads files written by JetScapeWriterStream (ASCII) or
+   JetScapeWriterBinaryStream. The format is detected from the first byte,
+   so both work through a fifo.
+ */
 template <class T> class JetScapeReader {
 
 public:
@@ -64,6 +72,10 @@ public:
   double GetSigmaErr() const { return sigmaErr; }
   double GetEventWeight() const { return eventWeight; }
   double GetEventPlaneAngle() const { return EventPlaneAngle; }
+  /// Full event header. The ASCII format only provides sigmaGen, sigmaErr,
+  /// weight and the event plane angle, the binary format all entries.
+  JetScapeEventHeader &GetHeader() { return header; }
+  bool IsBinary() const { return binaryFormat; }
 
 private:
   StringTokenizer strT;
@@ -73,6 +85,8 @@ private:
   void AddEdge(string s);
   //void MakeGraph();
   void AddHadron(string s);
+  void NextBinary();
+  bool ReadRecord(uint8_t &type);
   string file_name_in;
   T inFile;
 
@@ -89,6 +103,11 @@ private:
   double sigmaErr;
   double eventWeight;
   double EventPlaneAngle;
+  JetScapeEventHeader header;
+
+  bool binaryFormat;
+  string recordBuffer;
+  std::map<int, node> nodeById;
 };
 
 typedef JetScapeReader<ifstream> JetScapeReaderAscii;